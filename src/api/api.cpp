@@ -76,8 +76,9 @@ target get_target(const std::string& name) { return make_target(name); }
 migraphx::compile_options to_compile_options(const migraphx_compile_options& options)
 {
     migraphx::compile_options result{};
-    result.offload_copy = options.offload_copy;
-    result.fast_math    = options.fast_math;
+    result.offload_copy   = options.offload_copy;
+    result.fast_math      = options.fast_math;
+    result.output_buffers = options.output_buffers;
     return result;
 }
 
@@ -52,6 +52,13 @@ typedef struct
     /// Optimize math functions to use faster approximate versions. There may
     /// be slight accuracy degredation when enabled.
     bool fast_math;
+    /// For targets that write the outputs to internal memory(such as the
+    /// cpu), this will turn the outputs into parameters named
+    /// main:#output_N, so they are written directly into buffers passed in
+    /// by the caller. This field was added at the end of the struct, which
+    /// changes its size, so code built against an older migraphx.h must be
+    /// rebuilt before it can pass these options.
+    bool output_buffers;
 } migraphx_compile_options;
 
 /// Options for saving and loading files
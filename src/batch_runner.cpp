@@ -0,0 +1,111 @@
+#include <migraphx/batch_runner.hpp>
+#include <migraphx/errors.hpp>
+#include <migraphx/stringutils.hpp>
+#include <algorithm>
+#include <array>
+#include <future>
+#include <iterator>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+static std::size_t get_batch_size(const std::unordered_map<std::string, shape>& shapes)
+{
+    std::size_t batch = 0;
+    for(auto&& p : shapes)
+    {
+        const auto& s = p.second;
+        if(s.lens().empty() or not s.standard())
+            MIGRAPHX_THROW("RUN_BATCHES: Batched parameter " + p.first +
+                           " is not a standard batch");
+        if(batch == 0)
+            batch = s.lens().front();
+        else if(batch != s.lens().front())
+            MIGRAPHX_THROW("RUN_BATCHES: Batched parameters have different batch sizes");
+    }
+    if(batch == 0)
+        MIGRAPHX_THROW("RUN_BATCHES: No batched parameters");
+    return batch;
+}
+
+// Zero the rows of the buffer after the first n
+static void pad_rows(const argument& a, std::size_t n)
+{
+    const auto& s  = a.get_shape();
+    auto row_bytes = s.bytes() / s.lens().front();
+    std::fill(a.data() + n * row_bytes, a.data() + s.bytes(), 0);
+}
+
+// A view of the first n rows of the output
+static argument take_rows(const argument& a, std::size_t batch, std::size_t n)
+{
+    const auto& s = a.get_shape();
+    if(s.lens().empty() or s.lens().front() != batch)
+        MIGRAPHX_THROW("RUN_BATCHES: Output " + to_string(s) + " is not batched");
+    if(n == batch)
+        return a;
+    auto lens    = s.lens();
+    lens.front() = n;
+    return {shape{s.type(), lens, s.strides()}, a.data()};
+}
+
+std::size_t run_batches(const program& p,
+                        const batch_reader& read,
+                        const batch_writer& write,
+                        const parameter_map& fixed)
+{
+    auto shapes = p.get_parameter_shapes();
+    for(auto&& f : fixed)
+        shapes.erase(f.first);
+    auto batch = get_batch_size(shapes);
+
+    // Two sets of buffers, so the next batch can be read while the current one runs
+    std::array<parameter_map, 2> buffers;
+    for(auto&& b : buffers)
+    {
+        for(auto&& s : shapes)
+            b[s.first] = argument{s.second};
+    }
+    auto fill = [&](parameter_map& b) {
+        auto n = read(b);
+        if(n > batch)
+            MIGRAPHX_THROW("RUN_BATCHES: Read " + std::to_string(n) +
+                           " rows into a batch of " + std::to_string(batch));
+        if(n < batch)
+        {
+            for(auto&& a : b)
+                pad_rows(a.second, n);
+        }
+        return n;
+    };
+
+    std::size_t total = 0;
+    std::size_t i     = 0;
+    auto next         = std::async(std::launch::async, fill, std::ref(buffers[0]));
+    for(;;)
+    {
+        auto n = next.get();
+        if(n == 0)
+            break;
+        auto& current = buffers[i % 2];
+        if(n == batch)
+            next = std::async(std::launch::async, fill, std::ref(buffers[(i + 1) % 2]));
+        auto params = fixed;
+        params.insert(current.begin(), current.end());
+        auto results = p.eval(params);
+        std::vector<argument> outputs;
+        std::transform(results.begin(),
+                       results.end(),
+                       std::back_inserter(outputs),
+                       [&](const auto& r) { return take_rows(r, batch, n); });
+        write(outputs);
+        total += n;
+        if(n < batch)
+            break;
+        i++;
+    }
+    return total;
+}
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
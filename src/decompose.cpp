@@ -21,8 +21,7 @@ struct alpha_beta
 
 alpha_beta get_alpha_beta(const operation& op)
 {
-    auto v = op.to_value();
-    return {v.at("alpha").to<float>(), v.at("beta").to<float>()};
+    return {op.get_field("alpha").to<float>(), op.get_field("beta").to<float>()};
 }
 
 struct find_dot_add
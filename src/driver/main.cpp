@@ -2,6 +2,7 @@
 #include "command.hpp"
 #include "verify.hpp"
 #include "perf.hpp"
+#include "op_bench.hpp"
 #include "models.hpp"
 
 #include <migraphx/tf.hpp>
@@ -9,6 +10,10 @@
 #include <migraphx/stringutils.hpp>
 #include <migraphx/load_save.hpp>
 #include <migraphx/json.hpp>
+#include <migraphx/file_buffer.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/time.hpp>
 #include <migraphx/version.h>
 
 #include <migraphx/dead_code_elimination.hpp>
@@ -18,6 +23,7 @@
 #include <migraphx/pass_manager.hpp>
 #include <migraphx/propagate_constant.hpp>
 #include <migraphx/quantization.hpp>
+#include <migraphx/ranges.hpp>
 #include <migraphx/register_op.hpp>
 #include <migraphx/rewrite_batchnorm.hpp>
 #include <migraphx/simplify_algebra.hpp>
@@ -41,6 +47,7 @@ struct loader
     bool optimize               = false;
     bool skip_unknown_operators = false;
     bool brief                  = false;
+    int64_t max_loop_iterations = 10;
     std::string output_type;
     std::string output;
     std::vector<std::string> param_dims;
@@ -60,6 +67,9 @@ struct loader
            {"--skip-unknown-operators"},
            ap.help("Skip unknown operators when parsing and continue to parse."),
            ap.set_value(true));
+        ap(max_loop_iterations,
+           {"--max-loop-iterations"},
+           ap.help("Max iterations of an onnx Loop whose trip count is not a constant"));
         ap(is_nhwc, {"--nchw"}, ap.help("Treat tensorflow format as nchw"), ap.set_value(false));
         ap(trim, {"--trim", "-t"}, ap.help("Trim instructions from the end"));
         ap(param_dims,
@@ -151,6 +161,7 @@ struct loader
                 options.skip_unknown_operators = skip_unknown_operators;
                 options.print_program_on_error = true;
                 options.map_input_dims         = map_input_dims;
+                options.max_loop_iterations    = max_loop_iterations;
                 p                              = parse_onnx(file, options);
             }
             else if(file_type == "tf")
@@ -295,6 +306,7 @@ struct compiler
     bool offload_copy = false;
     bool fast_math    = true;
     int quantize      = 0;
+    std::string pass_stats_file;
 
     std::vector<std::string> fill0;
     std::vector<std::string> fill1;
@@ -313,6 +325,9 @@ struct compiler
            ap.set_value(false));
         ap(quantize, {"--fp16"}, ap.help("Quantize for fp16"), ap.set_value(q_fp16));
         ap(quantize, {"--int8"}, ap.help("Quantize for int8"), ap.set_value(q_int8));
+        ap(pass_stats_file,
+           {"--pass-stats"},
+           ap.help("Write the time and the changes of each compile pass as json to a file"));
     }
 
     auto params(const program& p) { return parameters.generate(p, ct.get_target(), offload_copy); }
@@ -332,10 +347,18 @@ struct compiler
         {
             quantize_int8(p, t, {params(p)});
         }
+        pass_statistics stats;
         compile_options options;
         options.offload_copy = offload_copy;
         options.fast_math    = fast_math;
+        if(not pass_stats_file.empty())
+            options.pass_stats = &stats;
         p.compile(t, options);
+        if(not pass_stats_file.empty())
+        {
+            std::ofstream os(pass_stats_file);
+            os << to_json_string(stats.to_value()) << std::endl;
+        }
         l.save(p);
         return p;
     }
@@ -465,21 +488,340 @@ struct run_cmd : command<run_cmd>
 struct perf : command<perf>
 {
     compiler c;
-    unsigned n = 100;
+    unsigned n           = 100;
+    unsigned warmup      = 1;
+    unsigned concurrency = 1;
+    bool report          = true;
+    std::string results_file;
+    std::string baseline_file;
+    double tolerance = 5;
     void parse(argument_parser& ap)
     {
         c.parse(ap);
         ap(n, {"--iterations", "-n"}, ap.help("Number of iterations to run for perf report"));
+        ap(warmup, {"--warmup"}, ap.help("Number of runs before timing"));
+        ap(concurrency,
+           {"--concurrency"},
+           ap.help("Number of callers running their own copy of the program at the same time"));
+        ap(report,
+           {"--no-report"},
+           ap.help("Skip the report of the time of each instruction"),
+           ap.set_value(false));
+        ap(results_file, {"--results"}, ap.help("Write the results as json to a file"));
+        ap(baseline_file,
+           {"--baseline"},
+           ap.help("Compare the results with the json results of an earlier run"));
+        ap(tolerance,
+           {"--baseline-tolerance"},
+           ap.help("Percent the latency or throughput can get worse than the baseline"));
     }
 
     void run()
     {
+        using milliseconds = std::chrono::duration<double, std::milli>;
         std::cout << "Compiling ... " << std::endl;
-        auto p = c.compile();
-        std::cout << "Allocating params ... " << std::endl;
-        auto m = c.params(p);
-        std::cout << "Running performance report ... " << std::endl;
-        p.perf_report(std::cout, n, m);
+        program p;
+        auto compile_ms = time<milliseconds>([&] { p = c.compile(); });
+        std::cout << "Running " << concurrency << " callers ... " << std::endl;
+        perf_options options;
+        options.iterations  = n;
+        options.warmup      = warmup;
+        options.concurrency = concurrency;
+        auto results = run_perf(p, [&](const program& x) { return c.params(x); }, options);
+        results["model"]       = c.l.model.empty() ? c.l.file : c.l.model;
+        results["target"]      = c.ct.target_name;
+        results["compile_ms"]  = compile_ms;
+        results["peak_rss_mb"] = get_peak_rss_mb();
+
+        const auto& latency = results.at("latency_ms");
+        std::cout << "Compile time: " << compile_ms << "ms" << std::endl;
+        for(const auto& name : {"mean", "p50", "p90", "p99", "p99.9"})
+        {
+            if(latency.contains(name))
+                std::cout << "Latency " << name << ": " << latency.at(name).to<double>() << "ms"
+                          << std::endl;
+        }
+        std::cout << "Throughput: " << results.at("throughput").to<double>() << "/s" << std::endl;
+        std::cout << "Peak RSS: " << results.at("peak_rss_mb").to<double>() << "MB" << std::endl;
+
+        if(report)
+        {
+            std::cout << "Running performance report ... " << std::endl;
+            auto m = c.params(p);
+            p.perf_report(std::cout, n, m);
+        }
+        if(not results_file.empty())
+        {
+            std::ofstream os(results_file);
+            os << to_json_string(results) << std::endl;
+        }
+        if(not baseline_file.empty())
+        {
+            auto buffer      = read_buffer(baseline_file);
+            auto baseline    = from_json_string(buffer.data(), buffer.size());
+            auto regressions = compare_perf(results, baseline, tolerance);
+            for(const auto& r : regressions)
+                std::cout << "Regression: " << r << std::endl;
+            if(not regressions.empty())
+                MIGRAPHX_THROW("Performance is worse than the baseline " + baseline_file);
+            std::cout << "Performance is within " << tolerance << "% of the baseline" << std::endl;
+        }
+    }
+};
+
+struct im2col : command<im2col>
+{
+    compiler_target ct;
+    std::vector<std::size_t> input_lens;
+    std::vector<std::size_t> weights_lens;
+    std::vector<std::size_t> padding;
+    std::vector<std::size_t> stride;
+    unsigned n = 100;
+    void parse(argument_parser& ap)
+    {
+        ct.parse(ap);
+        ap(input_lens,
+           {"--input"},
+           ap.help("Dims of the input image, 1 64 56 56 when not given"),
+           ap.append(),
+           ap.nargs(2));
+        ap(weights_lens,
+           {"--weights"},
+           ap.help("Dims of the convolution weights, 64 64 3 3 when not given"),
+           ap.append(),
+           ap.nargs(2));
+        ap(padding,
+           {"--padding"},
+           ap.help("Padding per kernel dim, 0 when not given"),
+           ap.append(),
+           ap.nargs(2));
+        ap(stride,
+           {"--stride"},
+           ap.help("Stride per kernel dim, 1 when not given"),
+           ap.append(),
+           ap.nargs(2));
+        ap(n, {"--iterations", "-n"}, ap.help("Number of iterations to time"));
+    }
+
+    double time_program(program p) const
+    {
+        auto t = ct.get_target();
+        p.compile(t);
+        auto m = create_param_map(p, t);
+        // Warm up
+        p.eval(m);
+        auto total = time<std::chrono::duration<double, std::milli>>([&] {
+            for(unsigned i = 0; i < n; i++)
+                p.eval(m);
+            p.get_context().finish();
+        });
+        return total / n;
+    }
+
+    void run()
+    {
+        if(input_lens.empty())
+            input_lens = {1, 64, 56, 56};
+        if(weights_lens.empty())
+            weights_lens = {64, 64, 3, 3};
+        auto kdims = input_lens.size() - 2;
+        if(padding.empty())
+            padding.resize(kdims, 0);
+        if(stride.empty())
+            stride.resize(kdims, 1);
+        std::vector<std::size_t> dilation(kdims, 1);
+        value attrs = {{"padding", padding}, {"stride", stride}, {"dilation", dilation}};
+        shape xs{shape::float_type, input_lens};
+        shape ws{shape::float_type, weights_lens};
+        auto kernel_size = std::accumulate(
+            ws.lens().begin() + 1, ws.lens().end(), std::size_t{1}, std::multiplies<>{});
+
+        program conv;
+        {
+            auto* mm = conv.get_main_module();
+            auto x   = mm->add_parameter("x", xs);
+            auto w   = mm->add_literal(generate_literal(ws));
+            mm->add_instruction(make_op("convolution", attrs), x, w);
+        }
+        program cols;
+        {
+            auto* mm = cols.get_main_module();
+            auto x   = mm->add_parameter("x", xs);
+            auto w   = mm->add_literal(generate_literal(ws));
+            mm->add_instruction(make_op("im2col", attrs), x, w);
+        }
+        program gemm;
+        {
+            auto* mm = gemm.get_main_module();
+            auto x   = mm->add_parameter("x", xs);
+            auto w   = mm->add_literal(generate_literal(ws));
+            auto c   = mm->add_instruction(make_op("im2col", attrs), x, w);
+            auto rw  = mm->add_instruction(
+                make_op("reshape", {{"dims", {ws.lens().front(), kernel_size}}}), w);
+            auto tw = mm->add_instruction(make_op("transpose", {{"dims", {1, 0}}}), rw);
+            mm->add_instruction(make_op("dot"), c, tw);
+        }
+
+        std::cout << "convolution: " << time_program(conv) << "ms" << std::endl;
+        std::cout << "im2col: " << time_program(cols) << "ms" << std::endl;
+        std::cout << "im2col + gemm: " << time_program(gemm) << "ms" << std::endl;
+    }
+};
+
+struct op_bench : command<op_bench>
+{
+    std::vector<std::string> ops;
+    std::vector<std::string> targets;
+    std::vector<std::string> types;
+    std::vector<std::size_t> lens;
+    std::string output;
+    unsigned n = 100;
+    void parse(argument_parser& ap)
+    {
+        ap(ops, {"--op"}, ap.help("Operator to run, all of them when not given"), ap.append());
+        ap(targets,
+           {"--target"},
+           ap.help("Target to run on, ref and cpu when not given"),
+           ap.append());
+        ap(types, {"--type"}, ap.help("Type of the inputs, float when not given"), ap.append());
+        ap(lens,
+           {"--shape"},
+           ap.help("Dims of the inputs, both 1024 1024 and 1 64 56 56 when not given"),
+           ap.append(),
+           ap.nargs(2));
+        ap(output, {"--output", "-o"}, ap.help("Write the results as json to a file"));
+        ap(n, {"--iterations", "-n"}, ap.help("Number of iterations to time"));
+    }
+
+    void run() const
+    {
+        op_bench_options options;
+        options.ops        = ops;
+        options.targets    = targets;
+        options.iterations = n;
+        if(targets.empty())
+        {
+            for(const auto& name : {"ref", "cpu"})
+            {
+                if(contains(get_targets(), name))
+                    options.targets.push_back(name);
+            }
+        }
+        for(const auto& type : types.empty() ? std::vector<std::string>{"float"} : types)
+            options.types.push_back(shape::parse_type(type));
+        if(lens.empty())
+            options.shapes = {{1024, 1024}, {1, 64, 56, 56}};
+        else
+            options.shapes = {lens};
+        auto results = run_op_benchmarks(options, &std::cout);
+        if(not output.empty())
+        {
+            std::ofstream os(output);
+            os << to_json_string(results) << std::endl;
+        }
+    }
+};
+
+struct values : command<values>
+{
+    loader l;
+    compiler_target ct;
+    bool compile = false;
+    unsigned n   = 100;
+    void parse(argument_parser& ap)
+    {
+        l.parse(ap);
+        ct.parse(ap);
+        ap(compile,
+           {"--compile"},
+           ap.help("Compile the program first so target operators are included"),
+           ap.set_value(true));
+        ap(n, {"--iterations", "-n"}, ap.help("Number of iterations to time"));
+    }
+
+    // Uses every registered operator unless a program is given
+    std::vector<operation> get_operations()
+    {
+        std::vector<operation> ops;
+        if(l.file.empty() and l.model.empty())
+        {
+            for(const auto& name : get_operators())
+                ops.push_back(load_op(name));
+        }
+        else
+        {
+            auto p = l.load();
+            if(compile)
+                p.compile(ct.get_target());
+            for(const auto* mod : p.get_modules())
+            {
+                for(const auto& ins : *mod)
+                    ops.push_back(ins.get_operator());
+            }
+        }
+        // Only keep the operators that can be rebuilt from their value
+        ops.erase(std::remove_if(ops.begin(),
+                                 ops.end(),
+                                 [](const operation& op) {
+                                     try
+                                     {
+                                         make_op(op.name(), op.to_value());
+                                         return false;
+                                     }
+                                     catch(const std::exception&)
+                                     {
+                                         return true;
+                                     }
+                                 }),
+                  ops.end());
+        return ops;
+    }
+
+    void run()
+    {
+        using milliseconds = std::chrono::duration<double, std::milli>;
+        auto ops           = get_operations();
+        std::vector<value> vals(ops.size());
+        std::size_t found = 0;
+
+        auto to_value_time = time<milliseconds>([&] {
+            for(unsigned i = 0; i < n; i++)
+            {
+                std::transform(ops.begin(), ops.end(), vals.begin(), [](const operation& op) {
+                    return op.to_value();
+                });
+            }
+        });
+        auto make_op_time = time<milliseconds>([&] {
+            for(unsigned i = 0; i < n; i++)
+            {
+                for(std::size_t j = 0; j < ops.size(); j++)
+                    found += make_op(ops[j].name(), vals[j]).name().size();
+            }
+        });
+        auto lookup_time = time<milliseconds>([&] {
+            for(unsigned i = 0; i < n; i++)
+            {
+                for(const auto& v : vals)
+                {
+                    for(const auto& field : v)
+                        found += v.contains(field.get_key()) ? 1 : 0;
+                }
+            }
+        });
+        auto copy_time = time<milliseconds>([&] {
+            for(unsigned i = 0; i < n; i++)
+            {
+                auto copies = vals;
+                found += copies.size();
+            }
+        });
+
+        std::cout << "Operators: " << ops.size() << " (" << found << ")" << std::endl;
+        std::cout << "to_value: " << to_value_time / n << "ms" << std::endl;
+        std::cout << "make_op: " << make_op_time / n << "ms" << std::endl;
+        std::cout << "lookup: " << lookup_time / n << "ms" << std::endl;
+        std::cout << "copy: " << copy_time / n << "ms" << std::endl;
     }
 };
 
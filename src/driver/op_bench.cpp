@@ -0,0 +1,183 @@
+#include "op_bench.hpp"
+
+#include <migraphx/program.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/register_op.hpp>
+#include <migraphx/register_target.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/ranges.hpp>
+#include <migraphx/stringutils.hpp>
+#include <migraphx/time.hpp>
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+
+namespace migraphx {
+namespace driver {
+inline namespace MIGRAPHX_INLINE_NS {
+
+// The inputs an operator with its default attributes accepts. Convolutions get 3x3 weights with
+// as many output channels as input channels, and anything else up to three inputs of the same
+// shape.
+static std::vector<shape> get_inputs(const operation& op, const shape& s)
+{
+    std::vector<std::vector<shape>> candidates;
+    // These only check the rank in their kernels
+    if(contains({"lrn", "pooling"}, op.name()) and s.lens().size() != 4)
+        return {};
+    if(ends_with(op.name(), "convolution"))
+    {
+        if(s.lens().size() < 3)
+            return {};
+        std::vector<std::size_t> w(s.lens().size(), 3);
+        w[0] = s.lens()[1];
+        w[1] = s.lens()[1];
+        candidates.push_back({s, shape{s.type(), w}});
+    }
+    else
+    {
+        for(std::size_t n = 1; n <= 3; n++)
+            candidates.emplace_back(n, s);
+    }
+    for(const auto& inputs : candidates)
+    {
+        try
+        {
+            op.compute_shape(inputs);
+            return inputs;
+        }
+        catch(const std::exception&)
+        {
+        }
+    }
+    return {};
+}
+
+static std::size_t
+estimate_flops(const std::string& name, const std::vector<shape>& inputs, const shape& output)
+{
+    if(contains({"dot", "quant_dot"}, name))
+        return 2 * output.elements() * inputs.front().lens().back();
+    if(contains({"convolution", "quant_convolution"}, name))
+    {
+        const auto& w = inputs.at(1);
+        return 2 * output.elements() * (w.elements() / w.lens().front());
+    }
+    // Anything else does about one operation for each element it reads or writes
+    std::size_t result = output.elements();
+    for(const auto& s : inputs)
+        result = std::max(result, s.elements());
+    return result;
+}
+
+static double time_op(const operation& op,
+                      const std::vector<shape>& inputs,
+                      const target& t,
+                      unsigned iterations)
+{
+    program p;
+    auto* mm = p.get_main_module();
+    std::vector<instruction_ref> args;
+    for(std::size_t i = 0; i < inputs.size(); i++)
+        args.push_back(mm->add_parameter("x" + std::to_string(i), inputs[i]));
+    mm->add_instruction(op, args);
+    p.compile(t);
+
+    parameter_map m;
+    for(auto&& x : p.get_parameter_shapes())
+        m[x.first] = t.copy_to(generate_argument(x.second, m.size()));
+    // Warm up
+    p.eval(m);
+    p.get_context().finish();
+    auto total = time<std::chrono::duration<double, std::milli>>([&] {
+        for(unsigned i = 0; i < iterations; i++)
+            p.eval(m);
+        p.get_context().finish();
+    });
+    return total / iterations;
+}
+
+// Operators that need submodules, attributes without a usable default, or inputs holding indices
+// and lengths that random data would make invalid
+static bool needs_special_inputs(const std::string& name)
+{
+    return starts_with(name, "rnn") or
+           contains({"gather", "gru", "if", "loop", "lstm", "pad"}, name);
+}
+
+value run_op_benchmarks(const op_bench_options& options, std::ostream* os)
+{
+    auto names = options.ops.empty() ? get_operators() : options.ops;
+    std::sort(names.begin(), names.end());
+    value results = value::array{};
+    value skipped = value::array{};
+    for(const auto& name : names)
+    {
+        // Target specific operators need the allocations of their target
+        if(name.front() == '@' or contains(name, ':') or needs_special_inputs(name))
+            continue;
+        auto op = make_op(name);
+        for(const auto& target_name : options.targets)
+        {
+            auto t = make_target(target_name);
+            for(auto type : options.types)
+            {
+                for(const auto& lens : options.shapes)
+                {
+                    value entry = {{"op", name},
+                                   {"target", target_name},
+                                   {"type", shape::name(type)},
+                                   {"shape", lens}};
+                    auto inputs = get_inputs(op, shape{type, lens});
+                    if(inputs.empty())
+                    {
+                        entry["error"] = "Inputs not supported";
+                        skipped.push_back(entry);
+                        continue;
+                    }
+                    auto output = op.compute_shape(inputs);
+                    if(op.output_alias(inputs) >= 0)
+                    {
+                        entry["error"] = "View";
+                        skipped.push_back(entry);
+                        continue;
+                    }
+                    double ms = 0;
+                    try
+                    {
+                        ms = time_op(op, inputs, t, options.iterations);
+                    }
+                    catch(const std::exception& e)
+                    {
+                        entry["error"] = std::string{e.what()};
+                        skipped.push_back(entry);
+                        continue;
+                    }
+                    std::size_t bytes = output.bytes();
+                    for(const auto& s : inputs)
+                        bytes += s.bytes();
+                    auto flops            = estimate_flops(name, inputs, output);
+                    entry["inputs"]       = inputs.size();
+                    entry["output"]       = output.lens();
+                    entry["ms"]           = ms;
+                    entry["runs_per_sec"] = ms > 0 ? 1000.0 / ms : 0.0;
+                    entry["gbps"]         = ms > 0 ? bytes / (ms * 1.0e6) : 0.0;
+                    entry["gflops"]       = ms > 0 ? flops / (ms * 1.0e6) : 0.0;
+                    results.push_back(entry);
+                    if(os != nullptr)
+                    {
+                        *os << std::fixed << std::setprecision(4) << name << " " << target_name
+                            << " " << shape::name(type) << " {" << to_string_range(lens)
+                            << "}: " << ms << "ms, " << entry["gbps"].to<double>() << " GB/s, "
+                            << entry["gflops"].to<double>() << " GFLOP/s" << std::endl;
+                    }
+                }
+            }
+        }
+    }
+    return {{"iterations", options.iterations}, {"results", results}, {"skipped", skipped}};
+}
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace driver
+} // namespace migraphx
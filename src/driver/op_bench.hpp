@@ -0,0 +1,39 @@
+#ifndef MIGRAPHX_GUARD_RTGLIB_DRIVER_OP_BENCH_HPP
+#define MIGRAPHX_GUARD_RTGLIB_DRIVER_OP_BENCH_HPP
+
+#include <migraphx/shape.hpp>
+#include <migraphx/value.hpp>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace migraphx {
+namespace driver {
+inline namespace MIGRAPHX_INLINE_NS {
+
+struct op_bench_options
+{
+    // The operators to run, or every registered operator when empty
+    std::vector<std::string> ops;
+    std::vector<std::string> targets;
+    std::vector<shape::type_t> types;
+    std::vector<std::vector<std::size_t>> shapes;
+    unsigned iterations = 100;
+};
+
+/**
+ * @brief Times each operator compiled for each target, type and shape of the grid
+ *
+ * The inputs of an operator are made from the shape of the grid, with as many inputs as its
+ * default attributes accept, so combinations the operator can't take, and views, are skipped.
+ * Returns the time, runs per second, GB/s and estimated GFLOP/s of each combination under
+ * "results", and why the rest were skipped under "skipped". Each result is also printed to os
+ * when given.
+ */
+value run_op_benchmarks(const op_bench_options& options, std::ostream* os = nullptr);
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace driver
+} // namespace migraphx
+
+#endif
@@ -2,6 +2,12 @@
 
 #include <migraphx/generate.hpp>
 #include <migraphx/register_target.hpp>
+#include <migraphx/par_for.hpp>
+#include <migraphx/time.hpp>
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <sys/resource.h>
 #ifdef HAVE_GPU
 #include <migraphx/gpu/hip.hpp>
 #endif
@@ -87,6 +93,115 @@ target get_target(bool gpu)
 
 void compile_program(program& p, bool gpu) { p.compile(get_target(gpu)); }
 
+double get_peak_rss_mb()
+{
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    // ru_maxrss is in KB on linux
+    return usage.ru_maxrss / 1024.0;
+}
+
+// Nearest rank percentile of sorted values
+static double percentile(const std::vector<double>& v, double p)
+{
+    auto rank = static_cast<std::size_t>(std::ceil(p / 100.0 * v.size()));
+    return v[std::min(std::max<std::size_t>(rank, 1), v.size()) - 1];
+}
+
+value run_perf(const program& p,
+               const std::function<parameter_map(const program&)>& make_params,
+               const perf_options& options)
+{
+    using milliseconds = std::chrono::duration<double, std::milli>;
+    auto callers       = std::max(options.concurrency, 1u);
+    std::vector<program> programs(callers, p);
+    // Copies share the memory allocated when the program was finalized, such as the scratch of
+    // the cpu, so each of the other callers finalizes its copy again to allocate its own
+    std::for_each(programs.begin() + 1, programs.end(), [](program& x) { x.finalize(); });
+    std::vector<parameter_map> params;
+    std::transform(
+        programs.begin(), programs.end(), std::back_inserter(params), make_params);
+    for(std::size_t i = 0; i < callers; i++)
+    {
+        for(unsigned j = 0; j < options.warmup; j++)
+            programs[i].eval(params[i]);
+        programs[i].get_context().finish();
+    }
+
+    std::vector<std::vector<double>> latencies(callers);
+    auto total = time<milliseconds>([&] {
+        std::vector<joinable_thread> threads;
+        for(std::size_t i = 0; i < callers; i++)
+        {
+            threads.emplace_back([&, i] {
+                for(unsigned j = 0; j < options.iterations; j++)
+                {
+                    latencies[i].push_back(time<milliseconds>([&] {
+                        programs[i].eval(params[i]);
+                        programs[i].get_context().finish();
+                    }));
+                }
+            });
+        }
+    });
+
+    std::vector<double> all;
+    for(const auto& l : latencies)
+        all.insert(all.end(), l.begin(), l.end());
+    std::sort(all.begin(), all.end());
+    value latency = value::object{};
+    if(not all.empty())
+    {
+        latency["mean"]  = std::accumulate(all.begin(), all.end(), 0.0) / all.size();
+        latency["min"]   = all.front();
+        latency["max"]   = all.back();
+        latency["p50"]   = percentile(all, 50);
+        latency["p90"]   = percentile(all, 90);
+        latency["p99"]   = percentile(all, 99);
+        latency["p99.9"] = percentile(all, 99.9);
+    }
+    return {{"iterations", options.iterations},
+            {"warmup", options.warmup},
+            {"concurrency", callers},
+            {"latency_ms", latency},
+            {"throughput", total > 0 ? all.size() * 1000.0 / total : 0.0}};
+}
+
+std::vector<std::string>
+compare_perf(const value& results, const value& baseline, double tolerance)
+{
+    std::vector<std::string> regressions;
+    auto check = [&](const std::string& name, double x, double base, bool higher_is_worse) {
+        auto change = base == 0 ? 0 : (x - base) * 100.0 / base;
+        auto worse  = higher_is_worse ? change : -change;
+        if(worse > tolerance)
+        {
+            regressions.push_back(name + ": " + std::to_string(x) + " vs " +
+                                  std::to_string(base) + " (" + std::to_string(change) + "%)");
+        }
+    };
+    if(results.contains("latency_ms") and baseline.contains("latency_ms"))
+    {
+        const auto& latency      = results.at("latency_ms");
+        const auto& base_latency = baseline.at("latency_ms");
+        // p99.9 needs many more runs than usual to be stable, so it isn't compared
+        for(const auto& name : {"p50", "p90", "p99"})
+        {
+            if(latency.contains(name) and base_latency.contains(name))
+                check(std::string{"latency "} + name,
+                      latency.at(name).to<double>(),
+                      base_latency.at(name).to<double>(),
+                      true);
+        }
+    }
+    if(results.contains("throughput") and baseline.contains("throughput"))
+        check("throughput",
+              results.at("throughput").to<double>(),
+              baseline.at("throughput").to<double>(),
+              false);
+    return regressions;
+}
+
 } // namespace MIGRAPHX_INLINE_NS
 } // namespace driver
 } // namespace migraphx
@@ -2,6 +2,10 @@
 #define MIGRAPHX_GUARD_RTGLIB_PERF_HPP
 
 #include <migraphx/program.hpp>
+#include <migraphx/value.hpp>
+#include <functional>
+#include <string>
+#include <vector>
 
 namespace migraphx {
 namespace driver {
@@ -16,6 +20,33 @@ parameter_map create_param_map(const program& p, bool gpu = true);
 target get_target(bool gpu);
 void compile_program(program& p, bool gpu = true);
 
+struct perf_options
+{
+    unsigned iterations  = 100;
+    unsigned warmup      = 1;
+    unsigned concurrency = 1;
+};
+
+/// Peak resident memory of the process so far, in MB
+double get_peak_rss_mb();
+
+/**
+ * @brief Times the runs of a compiled program
+ *
+ * Each of the concurrent callers runs its own copy of the program, with its own memory and the
+ * parameters from make_params, for the warmup runs and then the timed ones. Returns the latency
+ * of the runs of all the callers, its mean and percentiles, and the throughput of the callers
+ * together.
+ */
+value run_perf(const program& p,
+               const std::function<parameter_map(const program&)>& make_params,
+               const perf_options& options);
+
+/// Describes each latency percentile that grew, or throughput that dropped, by more than
+/// tolerance percent from the baseline
+std::vector<std::string>
+compare_perf(const value& results, const value& baseline, double tolerance);
+
 } // namespace MIGRAPHX_INLINE_NS
 } // namespace driver
 } // namespace migraphx
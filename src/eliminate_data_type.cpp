@@ -15,9 +15,14 @@ void eliminate_data_type::apply(module& m) const
             continue;
         if(ins->name() == "convert")
             continue;
+        // Control flow passes its inputs to its submodules, which expect the original types
+        if(not ins->module_inputs().empty())
+            continue;
         auto inputs = ins->inputs();
         std::transform(inputs.begin(), inputs.end(), inputs.begin(), [&](auto i) {
-            if(types.count(i->get_shape().type()) == 0)
+            // A tuple can't be converted, only the elements taken out of it
+            auto type = i->get_shape().type();
+            if(types.count(type) == 0 or type == shape::tuple_type)
                 return i;
             return m.insert_instruction(ins, make_op("convert", {{"target_type", target_type}}), i);
         });
@@ -0,0 +1,76 @@
+#include <migraphx/hoist_loop_invariants.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/iterator_for.hpp>
+#include <migraphx/stringutils.hpp>
+#include <migraphx/ranges.hpp>
+#include <unordered_map>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+static bool is_hoistable(instruction_ref ins)
+{
+    if(starts_with(ins->name(), "@") or not ins->module_inputs().empty())
+        return false;
+    return is_context_free(ins->get_operator());
+}
+
+static void hoist_body(module& m, instruction_ref loop_ins, module& body)
+{
+    // Maps each hoisted body instruction, and each body literal used by one,
+    // to its copy in the enclosing module
+    std::unordered_map<instruction_ref, instruction_ref> hoisted;
+    std::vector<instruction_ref> moved;
+    for(auto ins : iterator_for(body))
+    {
+        if(not is_hoistable(ins))
+            continue;
+        const auto& inputs = ins->inputs();
+        bool invariant     = std::all_of(inputs.begin(), inputs.end(), [&](auto i) {
+            return not body.has_instruction(i) or contains(hoisted, i) or
+                   i->name() == "@literal";
+        });
+        if(not invariant)
+            continue;
+
+        std::vector<instruction_ref> new_inputs(inputs.size());
+        std::transform(inputs.begin(), inputs.end(), new_inputs.begin(), [&](auto i) {
+            if(not body.has_instruction(i))
+                return i;
+            if(not contains(hoisted, i))
+                hoisted[i] = m.add_literal(i->get_literal());
+            return hoisted.at(i);
+        });
+        hoisted[ins] = m.insert_instruction(loop_ins, ins->get_operator(), new_inputs);
+        moved.push_back(ins);
+    }
+
+    for(auto ins : moved)
+    {
+        auto outputs = ins->outputs();
+        for(auto out : outputs)
+        {
+            if(contains(hoisted, out))
+                continue;
+            instruction::replace_argument(out, ins, hoisted.at(ins));
+        }
+    }
+    // Users come after the instructions they use, so removing in reverse
+    // leaves nothing referring to a removed instruction
+    for(auto ins : reverse(moved))
+        body.remove_instruction(ins);
+}
+
+void hoist_loop_invariants::apply(module& m) const
+{
+    for(auto ins : iterator_for(m))
+    {
+        if(ins->name() != "loop")
+            continue;
+        hoist_body(m, ins, *ins->module_inputs().front());
+    }
+}
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
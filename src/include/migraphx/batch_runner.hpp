@@ -0,0 +1,39 @@
+#ifndef MIGRAPHX_GUARD_RTGLIB_BATCH_RUNNER_HPP
+#define MIGRAPHX_GUARD_RTGLIB_BATCH_RUNNER_HPP
+
+#include <migraphx/program.hpp>
+#include <migraphx/argument.hpp>
+#include <migraphx/config.hpp>
+#include <functional>
+#include <vector>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+/// Fills the rows of the buffers of the batched parameters, whose first dimension is the batch
+/// size the program was compiled with, and returns how many rows were filled. Filling fewer rows
+/// than the batch size ends the input.
+using batch_reader = std::function<std::size_t(parameter_map& batch)>;
+
+/// Receives the outputs of one batch, in the order they were read, with only the rows that were
+/// read. The outputs are only valid until the writer returns.
+using batch_writer = std::function<void(const std::vector<argument>& outputs)>;
+
+/**
+ * @brief Runs the program over an input of any length, one compiled batch at a time
+ *
+ * The batched parameters are the parameters of the program that are not in `fixed`, and they
+ * must all have the same first dimension. The rows left over in the last batch are zero filled
+ * and dropped from its outputs, whose first dimension has to be the batch. The next batch is
+ * read on another thread into a second set of buffers while the current one runs. Returns the
+ * number of rows that were run.
+ */
+std::size_t run_batches(const program& p,
+                        const batch_reader& read,
+                        const batch_writer& write,
+                        const parameter_map& fixed = {});
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif
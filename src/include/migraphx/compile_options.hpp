@@ -7,11 +7,18 @@
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
 
+struct pass_statistics;
+
 struct compile_options
 {
     bool offload_copy = false;
     bool fast_math    = true;
+    /// Write the outputs into buffers passed in as the `main:#output_N`
+    /// parameters, for targets that otherwise write them to internal memory
+    bool output_buffers = false;
     tracer trace{};
+    /// When set, the time and the changes of each compile pass are added to it
+    pass_statistics* pass_stats = nullptr;
 };
 
 } // namespace MIGRAPHX_INLINE_NS
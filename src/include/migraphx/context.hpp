@@ -22,6 +22,15 @@ struct context
 {
     /// Wait for any tasks in the context to complete
     void finish() const;
+    /// Whether the compilation can finalize the operators on several threads, and run a pass on
+    /// the modules that don't depend on each other at the same time. Defaults to false.
+    bool parallel_compile() const;
+    /// Called on the thread that evaluates a program before any instruction runs. Defaults to
+    /// doing nothing.
+    void begin_eval() const;
+    /// Called on the same thread after the evaluation ends, even when it throws. Defaults to
+    /// doing nothing.
+    void end_eval() const;
 };
 
 #else
@@ -37,6 +46,22 @@ void from_value_context(T&, const value&)
 {
 }
 
+template <class T>
+bool parallel_compile_context(const T&)
+{
+    return false;
+}
+
+template <class T>
+void begin_eval_context(const T&)
+{
+}
+
+template <class T>
+void end_eval_context(const T&)
+{
+}
+
 /*
  * Type-erased interface for:
  *
@@ -44,6 +69,9 @@ void from_value_context(T&, const value&)
  * {
  *      value to_value() const;
  *      void from_value(const value& v) ;
+ *      bool parallel_compile() const;
+ *      void begin_eval() const;
+ *      void end_eval() const;
  *      void finish() const;
  * };
  *
@@ -124,6 +152,24 @@ struct context
         (*this).private_detail_te_get_handle().from_value(v);
     }
 
+    bool parallel_compile() const
+    {
+        assert((*this).private_detail_te_handle_mem_var);
+        return (*this).private_detail_te_get_handle().parallel_compile();
+    }
+
+    void begin_eval() const
+    {
+        assert((*this).private_detail_te_handle_mem_var);
+        (*this).private_detail_te_get_handle().begin_eval();
+    }
+
+    void end_eval() const
+    {
+        assert((*this).private_detail_te_handle_mem_var);
+        (*this).private_detail_te_get_handle().end_eval();
+    }
+
     void finish() const
     {
         assert((*this).private_detail_te_handle_mem_var);
@@ -145,6 +191,9 @@ struct context
 
         virtual value to_value() const          = 0;
         virtual void from_value(const value& v) = 0;
+        virtual bool parallel_compile() const   = 0;
+        virtual void begin_eval() const         = 0;
+        virtual void end_eval() const           = 0;
         virtual void finish() const             = 0;
     };
 
@@ -176,6 +225,45 @@ struct context
         from_value_context(private_detail_te_self, v);
     }
 
+    template <class T>
+    static auto private_detail_te_default_parallel_compile(char, T&& private_detail_te_self)
+        -> decltype(private_detail_te_self.parallel_compile())
+    {
+        return private_detail_te_self.parallel_compile();
+    }
+
+    template <class T>
+    static bool private_detail_te_default_parallel_compile(float, T&& private_detail_te_self)
+    {
+        return parallel_compile_context(private_detail_te_self);
+    }
+
+    template <class T>
+    static auto private_detail_te_default_begin_eval(char, T&& private_detail_te_self)
+        -> decltype(private_detail_te_self.begin_eval())
+    {
+        private_detail_te_self.begin_eval();
+    }
+
+    template <class T>
+    static void private_detail_te_default_begin_eval(float, T&& private_detail_te_self)
+    {
+        begin_eval_context(private_detail_te_self);
+    }
+
+    template <class T>
+    static auto private_detail_te_default_end_eval(char, T&& private_detail_te_self)
+        -> decltype(private_detail_te_self.end_eval())
+    {
+        private_detail_te_self.end_eval();
+    }
+
+    template <class T>
+    static void private_detail_te_default_end_eval(float, T&& private_detail_te_self)
+    {
+        end_eval_context(private_detail_te_self);
+    }
+
     template <typename PrivateDetailTypeErasedT>
     struct private_detail_te_handle_type : private_detail_te_handle_base_type
     {
@@ -216,6 +304,24 @@ struct context
             private_detail_te_default_from_value(char(0), private_detail_te_value, v);
         }
 
+        bool parallel_compile() const override
+        {
+
+            return private_detail_te_default_parallel_compile(char(0), private_detail_te_value);
+        }
+
+        void begin_eval() const override
+        {
+
+            private_detail_te_default_begin_eval(char(0), private_detail_te_value);
+        }
+
+        void end_eval() const override
+        {
+
+            private_detail_te_default_end_eval(char(0), private_detail_te_value);
+        }
+
         void finish() const override { private_detail_te_value.finish(); }
 
         PrivateDetailTypeErasedT private_detail_te_value;
@@ -0,0 +1,26 @@
+#ifndef MIGRAPHX_GUARD_RTGLIB_HOIST_LOOP_INVARIANTS_HPP
+#define MIGRAPHX_GUARD_RTGLIB_HOIST_LOOP_INVARIANTS_HPP
+
+#include <string>
+#include <migraphx/instruction_ref.hpp>
+#include <migraphx/config.hpp>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+struct module;
+
+/**
+ * Move the instructions of a loop body that compute the same value on every
+ * iteration in front of the loop.
+ */
+struct hoist_loop_invariants
+{
+    std::string name() const { return "hoist_loop_invariants"; }
+    void apply(module& m) const;
+};
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif
@@ -3,7 +3,9 @@
 
 #include <migraphx/config.hpp>
 #include <migraphx/value.hpp>
+#include <iosfwd>
 #include <string>
+#include <vector>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
@@ -11,6 +13,30 @@ inline namespace MIGRAPHX_INLINE_NS {
 std::string to_json_string(const value& val);
 value from_json_string(const std::string& str);
 value from_json_string(const char* str, std::size_t size);
+value from_json_stream(std::istream& is);
+
+/// Writes json directly to a stream one element at a time, so a large
+/// document never has to be built as a value first
+struct json_writer
+{
+    explicit json_writer(std::ostream& pos) : os(&pos) {}
+
+    void write_map(std::size_t n);
+    void write_array(std::size_t n);
+    void write_key(const std::string& key);
+    void write(const value& v);
+    void write_binary(const char* data, std::size_t size);
+
+    void end_map();
+    void end_array();
+
+    private:
+    void separator();
+    std::ostream* os;
+    // Whether an element has already been written to each open container
+    std::vector<bool> written = {};
+    bool after_key            = false;
+};
 
 } // namespace MIGRAPHX_INLINE_NS
 } // namespace migraphx
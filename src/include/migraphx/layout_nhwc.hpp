@@ -0,0 +1,29 @@
+#ifndef MIGRAPHX_GUARD_RTGLIB_LAYOUT_NHWC_HPP
+#define MIGRAPHX_GUARD_RTGLIB_LAYOUT_NHWC_HPP
+
+#include <string>
+#include <migraphx/instruction_ref.hpp>
+#include <migraphx/config.hpp>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+struct module;
+
+/**
+ * Lay out the inputs and outputs of convolutions as channels last (NHWC), so
+ * that chains of convolutions and the pointwise and pooling operators between
+ * them keep that layout. Layout changes are only left where the chain meets an
+ * operator that needs a standard shape, or an output of the module. This must
+ * run after auto_contiguous.
+ */
+struct layout_nhwc
+{
+    std::string name() const { return "layout_nhwc"; }
+    void apply(module& m) const;
+};
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif
@@ -7,6 +7,7 @@
 #include <migraphx/tensor_view.hpp>
 #include <migraphx/raw_data.hpp>
 #include <migraphx/make_shared_array.hpp>
+#include <migraphx/literal_store.hpp>
 #include <migraphx/config.hpp>
 
 #include <memory>
@@ -58,6 +59,9 @@ struct literal : raw_data<literal>
         std::copy(x, x + s.bytes(), buffer.get());
     }
 
+    /// Uses an existing buffer of at least s.bytes() as the data without copying it
+    literal(const shape& s, std::shared_ptr<char> data) : buffer(std::move(data)), m_shape(s) {}
+
     /// Whether data is available
     bool empty() const { return this->buffer == nullptr; }
 
@@ -75,6 +79,18 @@ struct literal : raw_data<literal>
         return {m_shape, [b]() { return b.get(); }};
     }
 
+    /// Convert the data to an argument that refers to the literal's buffer instead of copying it.
+    /// The buffer can be shared with other literals so the argument must not be written to.
+    argument get_shared_argument() const { return {m_shape, buffer}; }
+
+    /// Returns a literal with the same data that shares its buffer with any identical literal
+    literal intern() const
+    {
+        literal result = *this;
+        result.buffer  = intern_literal_data(buffer, m_shape.bytes());
+        return result;
+    }
+
     private:
     std::shared_ptr<char> buffer;
     shape m_shape;
@@ -0,0 +1,26 @@
+#ifndef MIGRAPHX_GUARD_MIGRAPHLIB_LITERAL_STORE_HPP
+#define MIGRAPHX_GUARD_MIGRAPHLIB_LITERAL_STORE_HPP
+
+#include <migraphx/config.hpp>
+#include <cstddef>
+#include <memory>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+/**
+ * @brief Returns a buffer with the same contents as `buffer`
+ * @details The literal data is looked up by content in a process-wide store. If an identical
+ * buffer is still alive it is returned instead, so constant data shared by copies of a
+ * program (or by programs compiled from the same model) is only kept in memory once. The
+ * buffers handed out by the store must never be written to.
+ */
+std::shared_ptr<char> intern_literal_data(const std::shared_ptr<char>& buffer, std::size_t bytes);
+
+/// Number of bytes currently held in the literal store
+std::size_t literal_store_bytes();
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif
@@ -2,6 +2,7 @@
 #define MIGRAPHX_GUARD_RTGLIB_LOAD_SAVE_HPP
 
 #include <migraphx/program.hpp>
+#include <iosfwd>
 #include <string>
 #include <vector>
 
@@ -14,6 +15,8 @@ struct file_options
 };
 
 program load(const std::string& filename, const file_options& options = file_options{});
+/// Reads the program incrementally so literal data is never buffered more than once
+program load(std::istream& is, const file_options& options = file_options{});
 program load_buffer(const std::vector<char>& buffer, const file_options& options = file_options{});
 program
 load_buffer(const char* buffer, std::size_t size, const file_options& options = file_options{});
@@ -21,6 +24,8 @@ load_buffer(const char* buffer, std::size_t size, const file_options& options =
 void save(const program& p,
           const std::string& filename,
           const file_options& options = file_options{});
+/// Writes the program incrementally with literal data copied straight from the literals
+void save(const program& p, std::ostream& os, const file_options& options = file_options{});
 std::vector<char> save_buffer(const program& p, const file_options& options = file_options{});
 
 } // namespace MIGRAPHX_INLINE_NS
@@ -0,0 +1,58 @@
+#ifndef MIGRAPHX_GUARD_MATCH_ATTENTION_HPP
+#define MIGRAPHX_GUARD_MATCH_ATTENTION_HPP
+
+#include <migraphx/config.hpp>
+#include <migraphx/matcher.hpp>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace match {
+
+namespace detail {
+template <class F>
+struct attention_matcher
+{
+    F f;
+    auto scores() const { return f("dot")(used_once(), nargs(2)).bind("scores"); }
+
+    auto scaled_scores() const
+    {
+        return any_of(scores(),
+                      f("mul")(used_once(), any_arg(0, 1)(scores())),
+                      f("div")(used_once(), arg(0)(scores())));
+    }
+
+    auto masked_scores() const
+    {
+        return any_of(scaled_scores(), f("add")(used_once(), any_arg(0, 1)(scaled_scores())));
+    }
+
+    auto matcher() const
+    {
+        return f("dot")(nargs(2),
+                        arg(0)(f("softmax")(used_once(), arg(0)(masked_scores())).bind("softmax")),
+                        arg(1)(any().bind("v")));
+    }
+};
+} // namespace detail
+
+/// Matches softmax(q * kt [* scale] [+ mask]) * v, where the scale can also be
+/// a division, binding v, the scores and the softmax. Which of the optional
+/// scale and mask are present is not bound, and has to be read from the inputs
+/// of the softmax. The scale is not checked to be a constant, since repeating
+/// that check in every alternative makes the matcher very slow to compile
+template <class F>
+auto attention(F f)
+{
+    return detail::attention_matcher<F>{f}.matcher();
+}
+
+inline auto attention()
+{
+    return attention([](auto x) { return name(x); });
+}
+
+} // namespace match
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+#endif // MIGRAPHX_GUARD_MATCH_ATTENTION_HPP
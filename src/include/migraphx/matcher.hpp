@@ -265,6 +265,10 @@ matcher_result match_instruction(module& mod, instruction_ref ins, M&& m)
 
 MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_TRACE_MATCHES)
 
+/// Number of matches applied by find_matches on the calling thread, which the pass manager uses
+/// to count the matches of each pass
+std::size_t& get_match_count();
+
 /// Find matches for an instruction in the module
 template <class... Ms>
 void find_matches(module& mod, instruction_ref ins, Ms&&... ms)
@@ -287,6 +291,7 @@ void find_matches(module& mod, instruction_ref ins, Ms&&... ms)
                 mod.debug_print(ins);
             }
             m.apply(mod, r);
+            get_match_count()++;
             match = true;
         },
         ms...);
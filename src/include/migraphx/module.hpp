@@ -126,7 +126,10 @@ struct module
     instruction_ref validate() const;
     instruction_ref find_dangling_reference() const;
 
+    /// Finalizes the instructions of this module and of its submodules
     void finalize(context& ctx);
+    /// Finalizes the instructions of each module once, on several threads when parallel is set
+    static void finalize(const std::vector<module*>& mods, context& ctx, bool parallel = false);
 
     void debug_print() const;
     void debug_print(instruction_ref ins) const;
@@ -3,6 +3,10 @@
 
 #include <migraphx/config.hpp>
 #include <migraphx/value.hpp>
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <string>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
@@ -11,6 +15,59 @@ std::vector<char> to_msgpack(const value& v);
 value from_msgpack(const std::vector<char>& buffer);
 value from_msgpack(const char* buffer, std::size_t size);
 
+/// Writes msgpack directly to a stream one element at a time, so a large
+/// document never has to be built as a value first
+struct msgpack_writer
+{
+    explicit msgpack_writer(std::ostream& pos) : os(&pos) {}
+
+    void write_map(std::size_t n);
+    void write_array(std::size_t n);
+    void write_key(const std::string& key);
+    void write(const value& v);
+    void write_binary(const char* data, std::size_t size);
+
+    void end_map() {}
+    void end_array() {}
+
+    private:
+    std::ostream* os;
+};
+
+/// Reads msgpack from a stream one element at a time
+struct msgpack_reader
+{
+    explicit msgpack_reader(std::istream& pis) : is(&pis) {}
+
+    /// Returns the number of key/value pairs in the map
+    std::size_t read_map();
+    /// Returns the number of elements in the array
+    std::size_t read_array();
+    std::string read_string();
+    /// Returns the size of the binary data, which is then read with read_bytes
+    std::size_t read_binary();
+    void read_bytes(char* data, std::size_t size);
+    /// Skips the next element if it is nil and returns whether it was
+    bool read_nil();
+    /// Reads the next complete element
+    value read();
+    /// Reads the next complete element, letting read_field read the value of any key in its maps
+    /// from the stream instead. read_field returns false to have the value read as usual.
+    value read(const std::function<bool(const std::string& key, value& v)>& read_field);
+
+    private:
+    std::uint8_t read_byte();
+    std::uint64_t read_uint(std::size_t n);
+    std::size_t map_size(std::uint8_t tag);
+    std::size_t array_size(std::uint8_t tag);
+    std::size_t string_size(std::uint8_t tag);
+    std::size_t binary_size(std::uint8_t tag);
+    value read(std::uint8_t tag,
+               const std::function<bool(const std::string& key, value& v)>* read_field = nullptr);
+
+    std::istream* is;
+};
+
 } // namespace MIGRAPHX_INLINE_NS
 } // namespace migraphx
 
@@ -18,6 +18,8 @@ struct onnx_options
     bool skip_unknown_operators = false;
     /// Print program if an error occurs
     bool print_program_on_error = false;
+    /// Max iterations of a Loop whose trip count is not a constant, running more of them throws
+    int64_t max_loop_iterations = 10;
 };
 
 /// Create a program from an onnx file
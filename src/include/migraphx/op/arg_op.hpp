@@ -0,0 +1,130 @@
+#ifndef MIGRAPHX_GUARD_OPERATORS_ARG_OP_HPP
+#define MIGRAPHX_GUARD_OPERATORS_ARG_OP_HPP
+
+#include <migraphx/op/name.hpp>
+#include <migraphx/check_shapes.hpp>
+#include <migraphx/argument.hpp>
+#include <migraphx/par_reduce.hpp>
+#include <migraphx/config.hpp>
+#include <migraphx/value.hpp>
+#include <migraphx/op/normalize_attribute.hpp>
+#include <functional>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace op {
+
+/**
+ * @brief Finds the index of the first element along an axis that no other element is preferred
+ * to, where Derived::compare()(x, y) is true when x is preferred to y
+ *
+ * When output_value is set, the output is a tuple of the indices and of the values at those
+ * indices, so that the value does not have to be found with a second reduction.
+ */
+template <class Derived>
+struct arg_op : op_name<Derived>
+{
+    int64_t axis      = 0;
+    bool output_value = false;
+
+    template <class Self, class F>
+    static auto reflect(Self& self, F f)
+    {
+        return pack(f(self.axis, "axis"), f(self.output_value, "output_value"));
+    }
+
+    value attributes() const
+    {
+        value normalize;
+        normalize["axis"] = value::array{normalize_attribute::include_min};
+        return {{"normalize_axes", normalize}};
+    }
+
+    shape normalize_compute_shape(std::vector<shape> inputs) const
+    {
+        check_shapes{inputs, *this}.has(1).standard();
+        auto lens = inputs[0].lens();
+
+        lens[axis] = 1;
+
+        shape indices{shape::int64_type, lens};
+        if(not output_value)
+            return indices;
+        return shape({indices, shape{inputs[0].type(), lens}});
+    }
+
+    // Reduces the axis with par_reduce, which runs the work with execute on up to nthreads
+    template <class Execute>
+    argument reduce(const shape& output_shape,
+                    const argument& input_arg,
+                    std::size_t nthreads,
+                    Execute execute) const
+    {
+        auto compare     = static_cast<const Derived&>(*this).compare();
+        const auto& lens = input_arg.get_shape().lens();
+        reduce_layout layout;
+        layout.outer = std::accumulate(
+            lens.begin(), lens.begin() + axis, std::size_t{1}, std::multiplies<>{});
+        layout.reduce = lens[axis];
+        layout.inner  = std::accumulate(
+            lens.begin() + axis + 1, lens.end(), std::size_t{1}, std::multiplies<>{});
+
+        argument indices{output_value ? output_shape.sub_shapes()[0] : output_shape};
+        argument values;
+        if(output_value)
+            values = argument{output_shape.sub_shapes()[1]};
+        auto* out_indices = indices.cast<int64_t>();
+        input_arg.visit([&](auto input) {
+            using type        = typename decltype(input)::value_type;
+            using value_index = std::pair<type, int64_t>;
+            const type* data  = input.data();
+            type* out_values  = output_value ? values.cast<type>() : nullptr;
+            // An index of -1 marks a partial result that has not seen any element yet. Equal
+            // values keep the smaller index, so the result does not depend on how the axis is
+            // split across threads.
+            par_reduce(
+                layout,
+                nthreads,
+                execute,
+                value_index{type{}, -1},
+                [&](std::size_t i, std::size_t k) {
+                    return value_index{data[i], static_cast<int64_t>(k)};
+                },
+                [&](const value_index& x, const value_index& y) {
+                    if(x.second < 0)
+                        return y;
+                    if(y.second < 0)
+                        return x;
+                    if(compare(y.first, x.first))
+                        return y;
+                    if(compare(x.first, y.first))
+                        return x;
+                    return x.second < y.second ? x : y;
+                },
+                [&](std::size_t i, const value_index& x) {
+                    out_indices[i] = x.second;
+                    if(out_values != nullptr)
+                        out_values[i] = x.first;
+                });
+        });
+
+        if(not output_value)
+            return indices;
+        return argument{std::vector<argument>{indices, values}};
+    }
+
+    argument compute(const shape& output_shape, std::vector<argument> args) const
+    {
+        return reduce(
+            output_shape, args.front(), 1, [](std::size_t n, std::size_t, auto f) { f(0, n); });
+    }
+};
+
+} // namespace op
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif
@@ -0,0 +1,99 @@
+#ifndef MIGRAPHX_GUARD_OPERATORS_CACHE_APPEND_HPP
+#define MIGRAPHX_GUARD_OPERATORS_CACHE_APPEND_HPP
+
+#include <migraphx/check_shapes.hpp>
+#include <migraphx/argument.hpp>
+#include <migraphx/config.hpp>
+#include <migraphx/value.hpp>
+#include <migraphx/op/normalize_attribute.hpp>
+#include <algorithm>
+#include <vector>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace op {
+
+/**
+ * @brief Writes an update into a cache along an axis, starting at a position
+ *
+ * The inputs are the cache, the update and the position along the axis. The update is written
+ * into the buffer of the cache, which is returned, so that a cache kept as a program state (see
+ * program::add_state) grows by the length of the update on each eval without being copied. Only
+ * the instructions that use the output see the update, so the output must be used.
+ */
+struct cache_append
+{
+    int64_t axis = 0;
+
+    template <class Self, class F>
+    static auto reflect(Self& self, F f)
+    {
+        return pack(f(self.axis, "axis"));
+    }
+
+    value attributes() const
+    {
+        value normalize;
+        normalize["axis"] = value::array{normalize_attribute::include_min};
+        return {{"normalize_axes", normalize}};
+    }
+
+    std::string name() const { return "cache_append"; }
+
+    shape normalize_compute_shape(std::vector<shape> inputs) const
+    {
+        check_shapes{inputs, *this}.has(3);
+        check_shapes{{inputs[0]}, *this}.standard();
+        const auto& cache  = inputs[0];
+        const auto& update = inputs[1];
+        if(update.type() != cache.type())
+        {
+            MIGRAPHX_THROW("CACHE_APPEND: update and cache should have the same type");
+        }
+        if(update.lens().size() != cache.lens().size())
+        {
+            MIGRAPHX_THROW("CACHE_APPEND: update and cache should have the same rank");
+        }
+        for(std::size_t i = 0; i < cache.lens().size(); i++)
+        {
+            if(i == axis ? update.lens()[i] > cache.lens()[i]
+                         : update.lens()[i] != cache.lens()[i])
+            {
+                MIGRAPHX_THROW("CACHE_APPEND: update does not fit into the cache");
+            }
+        }
+        if(inputs[2].elements() != 1)
+        {
+            MIGRAPHX_THROW("CACHE_APPEND: position should have one element");
+        }
+        return cache;
+    }
+
+    argument compute(const shape& output_shape, std::vector<argument> args) const
+    {
+        auto position = args[2].at<int64_t>();
+        auto n        = args[1].get_shape().lens()[axis];
+        if(position < 0 or static_cast<std::size_t>(position) + n > output_shape.lens()[axis])
+        {
+            MIGRAPHX_THROW("CACHE_APPEND: position " + std::to_string(position) +
+                           " is out of range");
+        }
+        std::vector<std::size_t> offset(output_shape.lens().size(), 0);
+        offset[axis] = position;
+        visit_all(args[0], args[1])([&](auto cache, auto update) {
+            shape slice_shape{
+                output_shape.type(), update.get_shape().lens(), output_shape.strides()};
+            auto slice = make_view(slice_shape, cache.data() + output_shape.index(offset));
+            std::copy(update.begin(), update.end(), slice.begin());
+        });
+        return args[0];
+    }
+
+    std::ptrdiff_t output_alias(const std::vector<shape>&) const { return 0; }
+};
+
+} // namespace op
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif
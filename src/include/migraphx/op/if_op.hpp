@@ -9,7 +9,7 @@
 #include <migraphx/module.hpp>
 #include <cmath>
 #include <utility>
-#include <set>
+#include <algorithm>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
@@ -46,22 +46,27 @@ struct if_op
     {
         auto cond      = args.front().at<bool>();
         module_ref mod = cond ? mods[0] : mods[1];
-        std::unordered_map<std::string, argument> params;
 
-        std::set<std::string> pnames;
-        for(const auto& smod : mods)
+        // The inputs after the condition are bound to the union of the
+        // parameter names of both submodules in sorted order, but only the
+        // names used by the chosen branch need to be passed on
+        auto then_names = mods[0]->get_parameter_names();
+        auto else_names = mods[1]->get_parameter_names();
+        std::vector<std::string> pnames;
+        pnames.reserve(then_names.size() + else_names.size());
+        pnames.insert(pnames.end(), then_names.begin(), then_names.end());
+        pnames.insert(pnames.end(), else_names.begin(), else_names.end());
+        std::sort(pnames.begin(), pnames.end());
+        pnames.erase(std::unique(pnames.begin(), pnames.end()), pnames.end());
+        assert(pnames.size() < args.size());
+
+        std::unordered_map<std::string, argument> params;
+        for(const auto& name : cond ? then_names : else_names)
         {
-            auto names = smod->get_parameter_names();
-            pnames.insert(names.begin(), names.end());
+            auto it = std::lower_bound(pnames.begin(), pnames.end(), name);
+            params.emplace(name, args[1 + std::distance(pnames.begin(), it)]);
         }
 
-        assert(pnames.size() < args.size());
-        std::transform(pnames.begin(),
-                       pnames.end(),
-                       args.begin() + 1,
-                       std::inserter(params, params.end()),
-                       [](auto&& name, auto&& arg) { return std::make_pair(name, arg); });
-
         auto results = run(mod, params);
         return argument{results};
     }
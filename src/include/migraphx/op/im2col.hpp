@@ -6,6 +6,7 @@
 #include <migraphx/op/common.hpp>
 #include <migraphx/config.hpp>
 #include <cmath>
+#include <numeric>
 #include <utility>
 
 namespace migraphx {
@@ -33,36 +34,47 @@ struct im2col
 
     value attributes() const { return {{"normalize_padding", "padding"}}; }
 
+    std::size_t kdims() const { return stride.size(); }
+
+    // Spatial dimensions of the output image, one entry for each kernel dimension
+    std::vector<std::size_t> output_spatial_lens(const shape& input, const shape& weights) const
+    {
+        std::vector<std::size_t> result(kdims());
+        for(std::size_t i = 0; i < result.size(); i++)
+        {
+            auto kernel      = weights.lens()[i + 2];
+            auto padding_sum = 2 * padding[i];
+            if(padding.size() == 2 * kdims())
+                padding_sum = padding[i] + padding[i + kdims()];
+            auto window = std::ptrdiff_t(1 + dilation[i] * (kernel - 1));
+            auto padded = std::ptrdiff_t(input.lens()[i + 2] + padding_sum);
+            result[i]   = std::size_t(
+                std::max<std::ptrdiff_t>(1, (padded - window) / std::ptrdiff_t(stride[i]) + 1));
+        }
+        return result;
+    }
+
     shape normalize_compute_shape(std::vector<shape> inputs) const
     {
-        auto input          = inputs[0];
-        auto weights        = inputs[1];
+        check_shapes{inputs, *this}.has(2).same_ndims().min_ndims(3);
+        const auto& input   = inputs[0];
+        const auto& weights = inputs[1];
+        if(input.lens().size() - 2 != kdims() or dilation.size() != kdims() or
+           (padding.size() != kdims() and padding.size() != 2 * kdims()))
+            MIGRAPHX_THROW("IM2COL: inconsistent attribute sizes");
+
         auto batch_size     = input.lens()[0];
         auto input_channels = weights.lens()[1];
-        auto kernel_height  = weights.lens()[2];
-        auto kernel_width   = weights.lens()[3];
-        check_shapes{inputs, *this}.has(2);
-        if(batch_size != 1)
-            MIGRAPHX_THROW("im2col only support batch_size 1");
-
-        auto padding_h = 2 * padding[0];
-        auto padding_w = 2 * padding[1];
-        if(padding.size() == 2 * stride.size())
-        {
-            padding_h = padding[0] + padding[2];
-            padding_w = padding[1] + padding[3];
-        }
-        auto output_height = std::size_t(std::max<std::ptrdiff_t>(
-            1,
-            (input.lens()[2] - (1 + dilation[0] * (kernel_height - 1)) + padding_h) / stride[0] +
-                1));
-        auto output_width  = std::size_t(std::max<std::ptrdiff_t>(
-            1,
-            (input.lens()[3] - (1 + dilation[1] * (kernel_width - 1)) + padding_w) / stride[1] +
-                1));
+        auto spatial_lens   = output_spatial_lens(input, weights);
+        auto output_pixels  = std::accumulate(
+            spatial_lens.begin(), spatial_lens.end(), std::size_t{1}, std::multiplies<>{});
+        auto kernel_size = std::accumulate(weights.lens().begin() + 2,
+                                           weights.lens().end(),
+                                           std::size_t{1},
+                                           std::multiplies<>{});
 
-        auto channels_col = kernel_height * kernel_width * input_channels;
-        return {input.type(), {output_height * output_width, channels_col}};
+        auto channels_col = kernel_size * input_channels;
+        return {input.type(), {batch_size * output_pixels, channels_col}};
     }
 };
 
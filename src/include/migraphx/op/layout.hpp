@@ -0,0 +1,60 @@
+#ifndef MIGRAPHX_GUARD_OPERATORS_LAYOUT_HPP
+#define MIGRAPHX_GUARD_OPERATORS_LAYOUT_HPP
+
+#include <migraphx/check_shapes.hpp>
+#include <migraphx/argument.hpp>
+#include <migraphx/config.hpp>
+#include <migraphx/shape.hpp>
+#include <migraphx/shape_for_each.hpp>
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace op {
+
+/// Copies the input into a packed tensor with the same lens, whose dimensions are laid out in
+/// memory in the order given by the permutation, from the outermost to the innermost. For
+/// example, {0, 2, 3, 1} lays out an NCHW tensor as NHWC. With the identity permutation this is
+/// the same as contiguous. It is not pointwise, as its output is not laid out like its input.
+struct layout
+{
+    std::vector<int64_t> permutation;
+
+    template <class Self, class F>
+    static auto reflect(Self& self, F f)
+    {
+        return pack(f(self.permutation, "permutation"));
+    }
+
+    std::string name() const { return "layout"; }
+
+    shape compute_shape(std::vector<shape> inputs) const
+    {
+        check_shapes{inputs, *this}.has(1).only_dims(permutation.size());
+        std::vector<int64_t> axes(permutation.size());
+        std::iota(axes.begin(), axes.end(), 0);
+        if(not std::is_permutation(axes.begin(), axes.end(), permutation.begin()))
+            MIGRAPHX_THROW("LAYOUT: Invalid permutation");
+        const auto& s = inputs.front();
+        return shape::from_permutation(s.type(), s.lens(), permutation);
+    }
+
+    argument compute(const shape& output_shape, std::vector<argument> args) const
+    {
+        argument result{output_shape};
+        visit_all(result, args[0])([&](auto output, auto input) {
+            shape_for_each(output.get_shape(), [&](const auto& idx) {
+                output(idx.begin(), idx.end()) = input(idx.begin(), idx.end());
+            });
+        });
+        return result;
+    }
+};
+
+} // namespace op
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif
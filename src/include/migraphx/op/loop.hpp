@@ -0,0 +1,194 @@
+#ifndef MIGRAPHX_GUARD_OPERATORS_LOOP_HPP
+#define MIGRAPHX_GUARD_OPERATORS_LOOP_HPP
+
+#include <migraphx/check_shapes.hpp>
+#include <migraphx/argument.hpp>
+#include <migraphx/functional.hpp>
+#include <migraphx/config.hpp>
+#include <migraphx/module.hpp>
+#include <migraphx/errors.hpp>
+#include <migraphx/ranges.hpp>
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace op {
+
+/**
+ * @brief Runs its submodule repeatedly
+ *
+ * The inputs are the trip count, the initial condition and the initial values of the loop
+ * carried dependencies. The submodule takes the iteration number, the condition and the loop
+ * carried dependencies as the parameters named by iteration_param, condition_param and
+ * dependency_param, and returns the new condition, the new loop carried dependencies and any
+ * number of scan outputs. The scan outputs of every iteration are stacked along a new leading
+ * dimension of size max_iterations, with the iterations that did not run left as zeros. The
+ * iteration number is an int64 scalar and the condition has the shape of the condition input.
+ * A loop that would run more than max_iterations times throws rather than stopping early.
+ */
+struct loop
+{
+    int64_t max_iterations = 10;
+
+    template <class Self, class F>
+    static auto reflect(Self& self, F f)
+    {
+        return pack(f(self.max_iterations, "max_iterations"));
+    }
+
+    std::string name() const { return "loop"; }
+
+    // The parameters of the submodule are bound by name, as the ones it does
+    // not use are removed from it
+    static std::string iteration_param() { return "#loop_iter"; }
+    static std::string condition_param() { return "#loop_cond"; }
+    static std::string dependency_param(std::size_t i) { return "#loop_dep" + std::to_string(i); }
+
+    shape compute_shape(const std::vector<shape>& inputs, std::vector<module_ref> mods) const
+    {
+        check_shapes{inputs, *this}.standard();
+        if(inputs.size() < 2)
+        {
+            MIGRAPHX_THROW("LOOP: operator should have a trip count and a condition input.");
+        }
+        if(mods.size() != 1)
+        {
+            MIGRAPHX_THROW("LOOP: operator should have one submodule.");
+        }
+        if(max_iterations < 0)
+        {
+            MIGRAPHX_THROW("LOOP: max_iterations must not be negative.");
+        }
+
+        auto dep_num                    = inputs.size() - 2;
+        std::vector<std::string> pnames = {iteration_param(), condition_param()};
+        for(std::size_t i = 0; i < dep_num; i++)
+            pnames.push_back(dependency_param(i));
+        for(const auto& pname : mods.front()->get_parameter_names())
+        {
+            if(not contains(pnames, pname))
+                MIGRAPHX_THROW("LOOP: unknown submodule parameter: " + pname);
+        }
+
+        auto mod_out_shapes = mods.front()->get_output_shapes();
+        if(mod_out_shapes.size() < dep_num + 1)
+        {
+            MIGRAPHX_THROW("LOOP: submodule should return a condition and " +
+                           std::to_string(dep_num) + " loop carried dependencies.");
+        }
+        if(not std::equal(inputs.begin() + 2,
+                          inputs.end(),
+                          mod_out_shapes.begin() + 1,
+                          [](const shape& x, const shape& y) {
+                              return x.type() == y.type() and x.lens() == y.lens();
+                          }))
+        {
+            MIGRAPHX_THROW("LOOP: loop carried dependencies must keep their shapes.");
+        }
+
+        std::vector<shape> out_shapes(inputs.begin() + 2, inputs.end());
+        std::transform(mod_out_shapes.begin() + 1 + dep_num,
+                       mod_out_shapes.end(),
+                       std::back_inserter(out_shapes),
+                       [&](const auto& s) {
+                           auto lens = s.lens();
+                           lens.insert(lens.begin(), max_iterations);
+                           return shape{s.type(), lens};
+                       });
+        return shape(out_shapes);
+    }
+
+    static bool aliases(const argument& x, const argument& y)
+    {
+        const auto* first = y.data();
+        const auto* last  = first + y.get_shape().bytes();
+        return x.data() >= first and x.data() < last;
+    }
+
+    static void copy_argument(const argument& dst, const argument& src)
+    {
+        if(dst.data() == src.data())
+            return;
+        visit_all(dst, src)([&](auto output, auto input) {
+            std::copy(input.begin(), input.end(), output.begin());
+        });
+    }
+
+    argument compute(const shape& output_shape,
+                     const std::vector<argument>& args,
+                     const std::vector<module_ref>& mods,
+                     const std::function<std::vector<argument>(
+                         module_ref&, const std::unordered_map<std::string, argument>&)>& run) const
+    {
+        module_ref mod = mods.front();
+        auto dep_num   = args.size() - 2;
+
+        // Every buffer is allocated once up front: the loop carried dependencies
+        // live in the output buffers and the parameters of the submodule refer to
+        // them, so each iteration only copies the values the submodule returned
+        const auto& out_shapes = output_shape.sub_shapes();
+        std::vector<argument> outputs;
+        outputs.reserve(out_shapes.size());
+        std::transform(out_shapes.begin(),
+                       out_shapes.end(),
+                       std::back_inserter(outputs),
+                       [](const auto& s) { return argument{s}; });
+        for(std::size_t i = 0; i < dep_num; i++)
+            copy_argument(outputs[i], args[i + 2]);
+        for(std::size_t i = dep_num; i < outputs.size(); i++)
+            std::memset(outputs[i].data(), 0, out_shapes[i].bytes());
+
+        argument iter_arg{shape{shape::int64_type}};
+        argument cond_arg{args[1].get_shape()};
+        std::unordered_map<std::string, argument> params;
+        params.emplace(iteration_param(), iter_arg);
+        params.emplace(condition_param(), cond_arg);
+        for(std::size_t i = 0; i < dep_num; i++)
+            params.emplace(dependency_param(i), outputs[i]);
+
+        auto trip_count = args[0].at<int64_t>();
+        bool cond       = args[1].at<bool>();
+        for(int64_t iter = 0; iter < trip_count and cond; iter++)
+        {
+            if(iter == max_iterations)
+                MIGRAPHX_THROW("LOOP: more than max_iterations (" +
+                               std::to_string(max_iterations) + ") iterations would run.");
+            iter_arg.visit([&](auto v) { v.front() = iter; });
+            cond_arg.visit([&](auto v) { v.front() = cond; });
+            auto results = run(mod, params);
+            assert(results.size() == outputs.size() + 1);
+
+            cond = results.front().at<bool>();
+            for(std::size_t i = dep_num; i < outputs.size(); i++)
+            {
+                const auto& scan_s = results[i + 1].get_shape();
+                shape slice_s{scan_s.type(), scan_s.lens()};
+                auto* slice_data = outputs[i].data() + std::size_t(iter) * slice_s.bytes();
+                copy_argument(argument{slice_s, slice_data}, results[i + 1]);
+            }
+            // The scan outputs are stored first, and a dependency returned in the
+            // place of another one is copied out, so that nothing is read after
+            // the loop carried dependencies are overwritten
+            for(std::size_t i = 0; i < dep_num; i++)
+            {
+                if(std::any_of(outputs.begin(), outputs.begin() + dep_num, [&](const auto& out) {
+                       return out.data() != outputs[i].data() and
+                              aliases(results[i + 1], out);
+                   }))
+                    results[i + 1] = results[i + 1].copy();
+            }
+            for(std::size_t i = 0; i < dep_num; i++)
+                copy_argument(outputs[i], results[i + 1]);
+        }
+
+        return argument{outputs};
+    }
+};
+
+} // namespace op
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif
@@ -0,0 +1,173 @@
+#ifndef MIGRAPHX_GUARD_OPERATORS_NONMAXSUPPRESSION_HPP
+#define MIGRAPHX_GUARD_OPERATORS_NONMAXSUPPRESSION_HPP
+
+#include <migraphx/check_shapes.hpp>
+#include <migraphx/argument.hpp>
+#include <migraphx/par_for.hpp>
+#include <migraphx/config.hpp>
+#include <migraphx/errors.hpp>
+#include <algorithm>
+#include <array>
+#include <vector>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace op {
+
+/**
+ * @brief Selects the boxes that do not overlap a box with a higher score
+ *
+ * The inputs are the boxes [batches, boxes, 4], the scores [batches, classes, boxes] and,
+ * optionally, the max number of boxes selected for each class, the iou threshold and the score
+ * threshold. The output has a row of [batch, class, box] indices for each selected box. Since the
+ * number of selected boxes is only known at runtime, the output has a row for every box of every
+ * class, and the rows past the last selected box are -1, which is never a valid index.
+ */
+struct nonmaxsuppression
+{
+    bool center_point_box = false;
+
+    template <class Self, class F>
+    static auto reflect(Self& self, F f)
+    {
+        return pack(f(self.center_point_box, "center_point_box"));
+    }
+
+    std::string name() const { return "nonmaxsuppression"; }
+
+    shape compute_shape(std::vector<shape> inputs) const
+    {
+        check_shapes{inputs, *this}.has(2, 3, 4, 5).standard();
+        const auto& boxes_lens  = inputs[0].lens();
+        const auto& scores_lens = inputs[1].lens();
+        if(boxes_lens.size() != 3 or boxes_lens[2] != 4)
+        {
+            MIGRAPHX_THROW("NONMAXSUPPRESSION: boxes should have the shape [batches, boxes, 4]");
+        }
+        if(scores_lens.size() != 3 or scores_lens[0] != boxes_lens[0] or
+           scores_lens[2] != boxes_lens[1])
+        {
+            MIGRAPHX_THROW(
+                "NONMAXSUPPRESSION: scores should have the shape [batches, classes, boxes]");
+        }
+        if(std::any_of(inputs.begin() + 2, inputs.end(), [](const shape& s) {
+               return s.elements() != 1;
+           }))
+        {
+            MIGRAPHX_THROW("NONMAXSUPPRESSION: thresholds should have one element");
+        }
+
+        std::size_t max_num_boxes = scores_lens[0] * scores_lens[1] * scores_lens[2];
+        return {shape::int64_type, {max_num_boxes, 3}};
+    }
+
+    // Corners of a box as {y1, x1, y2, x2} with y1 <= y2 and x1 <= x2
+    template <class T>
+    std::array<double, 4> corners(const T& boxes, std::size_t i) const
+    {
+        const auto* box = boxes.data() + i * 4;
+        std::array<double, 4> result;
+        if(center_point_box)
+        {
+            double xc = box[0];
+            double yc = box[1];
+            double w  = box[2];
+            double h  = box[3];
+            result    = {yc - h / 2, xc - w / 2, yc + h / 2, xc + w / 2};
+        }
+        else
+        {
+            result = {std::min<double>(box[0], box[2]),
+                      std::min<double>(box[1], box[3]),
+                      std::max<double>(box[0], box[2]),
+                      std::max<double>(box[1], box[3])};
+        }
+        return result;
+    }
+
+    static double iou(const std::array<double, 4>& b1, const std::array<double, 4>& b2)
+    {
+        double area1 = (b1[2] - b1[0]) * (b1[3] - b1[1]);
+        double area2 = (b2[2] - b2[0]) * (b2[3] - b2[1]);
+        if(area1 <= 0 or area2 <= 0)
+            return 0;
+        double h     = std::min(b1[2], b2[2]) - std::max(b1[0], b2[0]);
+        double w     = std::min(b1[3], b2[3]) - std::max(b1[1], b2[1]);
+        double inter = std::max(h, 0.0) * std::max(w, 0.0);
+        return inter / (area1 + area2 - inter);
+    }
+
+    argument compute(const shape& output_shape, std::vector<argument> args) const
+    {
+        const auto& scores_lens = args[1].get_shape().lens();
+        auto batch_num          = scores_lens[0];
+        auto class_num          = scores_lens[1];
+        auto box_num            = scores_lens[2];
+
+        int64_t max_output_boxes = args.size() > 2 ? args[2].at<int64_t>() : 0;
+        double iou_threshold     = args.size() > 3 ? args[3].at<double>() : 0;
+        bool has_score_threshold = args.size() > 4;
+        double score_threshold   = has_score_threshold ? args[4].at<double>() : 0;
+
+        auto max_selected = std::min<std::size_t>(std::max<int64_t>(max_output_boxes, 0), box_num);
+
+        // The boxes of each class of each batch are selected independently
+        std::vector<std::vector<int64_t>> selected(batch_num * class_num);
+        visit_all(args[0], args[1])([&](auto boxes, auto scores) {
+            par_for(batch_num * class_num, [&](auto bc) {
+                auto batch            = bc / class_num;
+                const auto* bc_scores = scores.data() + bc * box_num;
+
+                std::vector<int64_t> candidates;
+                for(std::size_t i = 0; i < box_num; ++i)
+                {
+                    if(not has_score_threshold or bc_scores[i] > score_threshold)
+                        candidates.push_back(i);
+                }
+                std::stable_sort(candidates.begin(), candidates.end(), [&](auto x, auto y) {
+                    return bc_scores[y] < bc_scores[x];
+                });
+
+                // Sweep the boxes from the highest score, keeping each one that
+                // does not overlap a box already kept
+                std::vector<std::array<double, 4>> kept;
+                for(auto i : candidates)
+                {
+                    if(kept.size() >= max_selected)
+                        break;
+                    auto box = this->corners(boxes, batch * box_num + i);
+                    if(std::any_of(kept.begin(), kept.end(), [&](const auto& k) {
+                           return iou(box, k) > iou_threshold;
+                       }))
+                        continue;
+                    kept.push_back(box);
+                    selected[bc].push_back(i);
+                }
+            });
+        });
+
+        argument result{output_shape};
+        result.visit([&](auto output) {
+            std::fill(output.begin(), output.end(), -1);
+            std::size_t row = 0;
+            for(std::size_t bc = 0; bc < selected.size(); ++bc)
+            {
+                for(auto i : selected[bc])
+                {
+                    output[row * 3]     = bc / class_num;
+                    output[row * 3 + 1] = bc % class_num;
+                    output[row * 3 + 2] = i;
+                    row++;
+                }
+            }
+        });
+
+        return result;
+    }
+};
+
+} // namespace op
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif
@@ -0,0 +1,67 @@
+#ifndef MIGRAPHX_GUARD_OPERATORS_NONZERO_HPP
+#define MIGRAPHX_GUARD_OPERATORS_NONZERO_HPP
+
+#include <migraphx/check_shapes.hpp>
+#include <migraphx/argument.hpp>
+#include <migraphx/float_equal.hpp>
+#include <migraphx/par_for.hpp>
+#include <migraphx/config.hpp>
+#include <algorithm>
+#include <vector>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace op {
+
+/**
+ * @brief Indices of the nonzero elements of its input
+ *
+ * The output has a row for each dimension of the input and a column for each nonzero element.
+ * Since the number of nonzero elements is only known at runtime, the output has a column for
+ * every element of the input, and the columns past the last nonzero element are -1, which is
+ * never a valid index.
+ */
+struct nonzero
+{
+    std::string name() const { return "nonzero"; }
+
+    shape compute_shape(std::vector<shape> inputs) const
+    {
+        check_shapes{inputs, *this}.has(1).standard();
+        auto elem_num = inputs[0].elements();
+        auto dim_num  = inputs[0].lens().size();
+        return {shape::int64_type, {dim_num, elem_num}};
+    }
+
+    argument compute(const shape& output_shape, std::vector<argument> args) const
+    {
+        std::vector<std::size_t> indices;
+        args.front().visit([&](auto input) {
+            for(std::size_t i = 0; i < input.size(); ++i)
+            {
+                if(not float_equal(input[i], 0))
+                    indices.push_back(i);
+            }
+        });
+
+        argument result{output_shape};
+        const auto& in_s = args.front().get_shape();
+        auto elem_num    = in_s.elements();
+        result.visit([&](auto output) {
+            std::fill(output.begin(), output.end(), -1);
+            par_for(indices.size(), [&](auto i) {
+                auto idx = in_s.multi(indices[i]);
+                for(std::size_t j = 0; j < idx.size(); ++j)
+                    output[j * elem_num + i] = idx[j];
+            });
+        });
+
+        return result;
+    }
+};
+
+} // namespace op
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif
@@ -0,0 +1,107 @@
+#ifndef MIGRAPHX_GUARD_OPERATORS_TOPK_HPP
+#define MIGRAPHX_GUARD_OPERATORS_TOPK_HPP
+
+#include <migraphx/check_shapes.hpp>
+#include <migraphx/argument.hpp>
+#include <migraphx/par_for.hpp>
+#include <migraphx/config.hpp>
+#include <migraphx/value.hpp>
+#include <migraphx/op/normalize_attribute.hpp>
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace op {
+
+/**
+ * @brief The k largest, or smallest, elements along an axis
+ *
+ * Returns a tuple of the values and their int64 indices along the axis, both sorted from the
+ * largest, or the smallest, value. Equal values are ordered by their index.
+ */
+struct topk
+{
+    int64_t k    = 1;
+    int64_t axis = -1;
+    bool largest = true;
+
+    template <class Self, class F>
+    static auto reflect(Self& self, F f)
+    {
+        return pack(f(self.k, "k"), f(self.axis, "axis"), f(self.largest, "largest"));
+    }
+
+    value attributes() const
+    {
+        value normalize;
+        normalize["axis"] = value::array{normalize_attribute::include_min};
+        return {{"normalize_axes", normalize}};
+    }
+
+    std::string name() const { return "topk"; }
+
+    shape normalize_compute_shape(std::vector<shape> inputs) const
+    {
+        check_shapes{inputs, *this}.has(1).standard();
+        auto lens = inputs[0].lens();
+        if(k < 0 or k > static_cast<int64_t>(lens[axis]))
+        {
+            MIGRAPHX_THROW("TOPK: k " + std::to_string(k) + " is out of range for axis of size " +
+                           std::to_string(lens[axis]));
+        }
+        lens[axis] = k;
+
+        return shape({shape{inputs[0].type(), lens}, shape{shape::int64_type, lens}});
+    }
+
+    argument compute(const shape& output_shape, std::vector<argument> args) const
+    {
+        const auto& in_s = args.front().get_shape();
+        auto axis_dim    = in_s.lens()[axis];
+        auto axis_stride = in_s.strides()[axis];
+
+        // There is a slice along the axis for each index of the other dimensions
+        auto lens  = in_s.lens();
+        lens[axis] = 1;
+        shape slice_s{in_s.type(), lens};
+
+        std::vector<argument> outputs = {argument{output_shape.sub_shapes()[0]},
+                                         argument{output_shape.sub_shapes()[1]}};
+        const auto& out_s = outputs[0].get_shape();
+        auto out_stride   = out_s.strides()[axis];
+        auto indices      = outputs[1].get<int64_t>();
+        visit_all(outputs[0], args[0])([&](auto output, auto input) {
+            par_for(slice_s.elements(), [&](auto i) {
+                auto idx     = slice_s.multi(i);
+                auto in_off  = in_s.index(idx);
+                auto out_off = out_s.index(idx);
+                auto compare = [&](int64_t x, int64_t y) {
+                    auto xv = input[in_off + x * axis_stride];
+                    auto yv = input[in_off + y * axis_stride];
+                    if(xv == yv)
+                        return x < y;
+                    return largest ? yv < xv : xv < yv;
+                };
+                // Only the first k indices are sorted, with a heap
+                std::vector<int64_t> order(axis_dim);
+                std::iota(order.begin(), order.end(), 0);
+                std::partial_sort(order.begin(), order.begin() + k, order.end(), compare);
+                for(int64_t j = 0; j < k; ++j)
+                {
+                    output[out_off + j * out_stride]  = input[in_off + order[j] * axis_stride];
+                    indices[out_off + j * out_stride] = order[j];
+                }
+            });
+        });
+
+        return argument{outputs};
+    }
+};
+
+} // namespace op
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif
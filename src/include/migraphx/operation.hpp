@@ -12,6 +12,7 @@
 #include <migraphx/streamutils.hpp>
 #include <migraphx/normalize_attributes.hpp>
 #include <migraphx/argument.hpp>
+#include <migraphx/literal.hpp>
 #include <migraphx/module_ref.hpp>
 #include <migraphx/serialize.hpp>
 #include <migraphx/auto_any_cast.hpp>
@@ -441,6 +442,133 @@ lifetime get_lifetime_op(const T&)
     return lifetime::local;
 }
 
+template <class T>
+auto has_field_op(rank<1>, const T& x, const std::string& field) -> decltype(x.to_value(), bool{})
+{
+    return x.to_value().contains(field);
+}
+
+template <class T>
+bool has_field_op(rank<0>, const T& x, const std::string& field)
+{
+    bool result = false;
+    reflect_each(x, [&](auto&&, const auto& name) { result = result or field == name; });
+    return result;
+}
+
+template <class T>
+bool has_field_op(const T& x, const std::string& field)
+{
+    return has_field_op(rank<1>{}, x, field);
+}
+
+template <class T>
+auto get_field_op(rank<1>, const T& x, const std::string& field) -> decltype(x.to_value(), value{})
+{
+    return x.to_value().at(field).without_key();
+}
+
+// Only the requested field is serialized
+template <class T>
+value get_field_op(rank<0>, const T& x, const std::string& field)
+{
+    value result;
+    bool found = false;
+    reflect_each(x, [&](const auto& y, const auto& name) {
+        if(found or field != name)
+            return;
+        result = migraphx::to_value(y);
+        found  = true;
+    });
+    if(not found)
+        MIGRAPHX_THROW("Unknown field " + field + " for operator " + x.name());
+    return result;
+}
+
+template <class T>
+value get_field_op(const T& x, const std::string& field)
+{
+    return get_field_op(rank<1>{}, x, field);
+}
+
+// A literal field is added to the table, and only its index is kept in the value
+template <class T>
+value field_to_value(const T& x, std::vector<literal>&)
+{
+    return migraphx::to_value(x);
+}
+
+inline value field_to_value(const literal& x, std::vector<literal>& literals)
+{
+    literals.push_back(x);
+    return {{"@literal", literals.size() - 1}};
+}
+
+template <class T>
+void field_from_value(const value& v, T& x, const std::vector<literal>&)
+{
+    x = migraphx::from_value<T>(v);
+}
+
+inline void field_from_value(const value& v, literal& x, const std::vector<literal>& literals)
+{
+    if(not v.contains("@literal") or v.at("@literal").is_object())
+    {
+        x = migraphx::from_value<literal>(v);
+        return;
+    }
+    auto i = v.at("@literal").to<std::size_t>();
+    if(i >= literals.size())
+        MIGRAPHX_THROW("Literal " + std::to_string(i) + " is not in the literal table");
+    x = literals[i];
+}
+
+template <class T>
+auto to_value_op(rank<1>, const T& x, std::vector<literal>&) -> decltype(x.to_value(), value{})
+{
+    return x.to_value();
+}
+
+template <class T>
+value to_value_op(rank<0>, const T& x, std::vector<literal>& literals)
+{
+    value result = value::object{};
+    reflect_each(x, [&](const auto& y, const std::string& name) {
+        result.emplace(name, field_to_value(y, literals));
+    });
+    return result;
+}
+
+template <class T>
+value to_value_op(const T& x, std::vector<literal>& literals)
+{
+    return to_value_op(rank<1>{}, x, literals);
+}
+
+template <class T>
+auto from_value_op(rank<1>, T& x, const value& v, const std::vector<literal>&)
+    -> decltype(x.from_value(v))
+{
+    x.from_value(v);
+}
+
+template <class T>
+void from_value_op(rank<0>, T& x, const value& v, const std::vector<literal>& literals)
+{
+    if(not(v.is_object() or (v.empty() and v.is_array())))
+        MIGRAPHX_THROW("Value is not an object");
+    reflect_each(x, [&](auto& y, const std::string& name) {
+        if(v.contains(name))
+            field_from_value(v.at(name).without_key(), y, literals);
+    });
+}
+
+template <class T>
+void from_value_op(T& x, const value& v, const std::vector<literal>& literals)
+{
+    from_value_op(rank<1>{}, x, v, literals);
+}
+
 } // namespace detail
 
 /*
@@ -466,9 +594,11 @@ lifetime get_lifetime_op(const T&)
  * shape& output,const std::vector<argument>& input,const std::vector<module_ref>&
  * module_args,std::function<std::vector<argument>(module_ref&, const
  * std::unordered_map<std::string, argument>&)> run) const; value to_value() const; void
- * from_value(const value& v) ; value attributes() const; friend std::ostream &
- * operator<<(std::ostream & os,const operation & op) ; friend bool operator==(const operation &
- * x,const operation & y) ;
+ * from_value(const value& v) ; value to_value(std::vector<literal>& literals) const; void
+ * from_value(const value& v,const std::vector<literal>& literals) ; value attributes() const; bool
+ * has_field(const std::string& field) const; value get_field(const std::string& field) const;
+ * friend std::ostream & operator<<(std::ostream & os,const operation & op) ; friend bool
+ * operator==(const operation & x,const operation & y) ;
  * };
  *
  */
@@ -644,12 +774,36 @@ struct operation
         (*this).private_detail_te_get_handle().from_value(v);
     }
 
+    value to_value(std::vector<literal>& literals) const
+    {
+        assert((*this).private_detail_te_handle_mem_var);
+        return (*this).private_detail_te_get_handle().to_value(literals);
+    }
+
+    void from_value(const value& v, const std::vector<literal>& literals)
+    {
+        assert((*this).private_detail_te_handle_mem_var);
+        (*this).private_detail_te_get_handle().from_value(v, literals);
+    }
+
     value attributes() const
     {
         assert((*this).private_detail_te_handle_mem_var);
         return (*this).private_detail_te_get_handle().attributes();
     }
 
+    bool has_field(const std::string& field) const
+    {
+        assert((*this).private_detail_te_handle_mem_var);
+        return (*this).private_detail_te_get_handle().has_field(field);
+    }
+
+    value get_field(const std::string& field) const
+    {
+        assert((*this).private_detail_te_handle_mem_var);
+        return (*this).private_detail_te_get_handle().get_field(field);
+    }
+
     friend std::ostream& operator<<(std::ostream& os, const operation& op)
     {
         assert(op.private_detail_te_handle_mem_var);
@@ -706,7 +860,11 @@ struct operation
                     module_ref&, const std::unordered_map<std::string, argument>&)> run) const = 0;
         virtual value to_value() const                                                         = 0;
         virtual void from_value(const value& v)                                                = 0;
+        virtual value to_value(std::vector<literal>& literals) const                           = 0;
+        virtual void from_value(const value& v, const std::vector<literal>& literals)          = 0;
         virtual value attributes() const                                                       = 0;
+        virtual bool has_field(const std::string& field) const                                 = 0;
+        virtual value get_field(const std::string& field) const                                = 0;
         virtual std::ostream& operator_shift_left(std::ostream& os) const                      = 0;
         virtual bool operator==(const operation& y) const                                      = 0;
     };
@@ -984,6 +1142,42 @@ struct operation
         detail::from_value_op(private_detail_te_self, v);
     }
 
+    template <class T>
+    static auto private_detail_te_default_to_value(char,
+                                                   T&& private_detail_te_self,
+                                                   std::vector<literal>& literals)
+        -> decltype(private_detail_te_self.to_value(literals))
+    {
+        return private_detail_te_self.to_value(literals);
+    }
+
+    template <class T>
+    static value private_detail_te_default_to_value(float,
+                                                    T&& private_detail_te_self,
+                                                    std::vector<literal>& literals)
+    {
+        return detail::to_value_op(private_detail_te_self, literals);
+    }
+
+    template <class T>
+    static auto private_detail_te_default_from_value(char,
+                                                     T&& private_detail_te_self,
+                                                     const value& v,
+                                                     const std::vector<literal>& literals)
+        -> decltype(private_detail_te_self.from_value(v, literals))
+    {
+        private_detail_te_self.from_value(v, literals);
+    }
+
+    template <class T>
+    static void private_detail_te_default_from_value(float,
+                                                     T&& private_detail_te_self,
+                                                     const value& v,
+                                                     const std::vector<literal>& literals)
+    {
+        detail::from_value_op(private_detail_te_self, v, literals);
+    }
+
     template <class T>
     static auto private_detail_te_default_attributes(char, T&& private_detail_te_self)
         -> decltype(private_detail_te_self.attributes())
@@ -997,6 +1191,40 @@ struct operation
         return detail::attributes_op(private_detail_te_self);
     }
 
+    template <class T>
+    static auto private_detail_te_default_has_field(char,
+                                                    T&& private_detail_te_self,
+                                                    const std::string& field)
+        -> decltype(private_detail_te_self.has_field(field))
+    {
+        return private_detail_te_self.has_field(field);
+    }
+
+    template <class T>
+    static bool private_detail_te_default_has_field(float,
+                                                    T&& private_detail_te_self,
+                                                    const std::string& field)
+    {
+        return detail::has_field_op(private_detail_te_self, field);
+    }
+
+    template <class T>
+    static auto private_detail_te_default_get_field(char,
+                                                    T&& private_detail_te_self,
+                                                    const std::string& field)
+        -> decltype(private_detail_te_self.get_field(field))
+    {
+        return private_detail_te_self.get_field(field);
+    }
+
+    template <class T>
+    static value private_detail_te_default_get_field(float,
+                                                     T&& private_detail_te_self,
+                                                     const std::string& field)
+    {
+        return detail::get_field_op(private_detail_te_self, field);
+    }
+
     template <typename PrivateDetailTypeErasedT>
     struct private_detail_te_handle_type : private_detail_te_handle_base_type
     {
@@ -1138,12 +1366,36 @@ struct operation
             private_detail_te_default_from_value(char(0), private_detail_te_value, v);
         }
 
+        value to_value(std::vector<literal>& literals) const override
+        {
+
+            return private_detail_te_default_to_value(char(0), private_detail_te_value, literals);
+        }
+
+        void from_value(const value& v, const std::vector<literal>& literals) override
+        {
+
+            private_detail_te_default_from_value(char(0), private_detail_te_value, v, literals);
+        }
+
         value attributes() const override
         {
 
             return private_detail_te_default_attributes(char(0), private_detail_te_value);
         }
 
+        bool has_field(const std::string& field) const override
+        {
+
+            return private_detail_te_default_has_field(char(0), private_detail_te_value, field);
+        }
+
+        value get_field(const std::string& field) const override
+        {
+
+            return private_detail_te_default_get_field(char(0), private_detail_te_value, field);
+        }
+
         std::ostream& operator_shift_left(std::ostream& os) const override
         {
             using migraphx::detail::operation_operators::operator<<;
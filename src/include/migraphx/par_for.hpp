@@ -4,6 +4,7 @@
 #include <thread>
 #include <cmath>
 #include <algorithm>
+#include <exception>
 #include <vector>
 #include <cassert>
 
@@ -90,6 +91,28 @@ void par_for(std::size_t n, F f)
     par_for(n, min_grain, f);
 }
 
+// Like par_for, but an exception thrown by f is rethrown on the calling thread after every
+// thread is done. When several are thrown, the one for the lowest index is rethrown.
+template <class F>
+void par_for_rethrow(std::size_t n, std::size_t min_grain, F f)
+{
+    std::vector<std::exception_ptr> errors(n);
+    par_for(n, min_grain, [&](std::size_t i) {
+        try
+        {
+            f(i);
+        }
+        catch(...)
+        {
+            errors[i] = std::current_exception();
+        }
+    });
+    auto it =
+        std::find_if(errors.begin(), errors.end(), [](const auto& e) { return e != nullptr; });
+    if(it != errors.end())
+        std::rethrow_exception(*it);
+}
+
 } // namespace MIGRAPHX_INLINE_NS
 } // namespace migraphx
 
@@ -0,0 +1,160 @@
+#ifndef MIGRAPHX_GUARD_RTGLIB_PAR_REDUCE_HPP
+#define MIGRAPHX_GUARD_RTGLIB_PAR_REDUCE_HPP
+
+#include <migraphx/config.hpp>
+#include <migraphx/shape.hpp>
+#include <migraphx/optional.hpp>
+#include <algorithm>
+#include <array>
+#include <vector>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+/// A reduction over adjacent dimensions of a standard shape, given by the
+/// number of elements before, in and after the reduced dimensions
+struct reduce_layout
+{
+    std::size_t outer  = 1;
+    std::size_t reduce = 1;
+    std::size_t inner  = 1;
+
+    std::size_t outputs() const { return outer * inner; }
+};
+
+/// Finds the layout of reducing the axes of a standard shape, which only
+/// exists when the reduced axes are adjacent once the dimensions are
+/// collapsed with reduce_dims
+optional<reduce_layout> find_reduce_layout(const shape& s, const std::vector<int64_t>& axes);
+
+namespace detail {
+
+// Independent accumulators in the innermost loop, so that it does not wait on
+// a single running value
+constexpr std::size_t reduce_lanes = 8;
+// Columns accumulated together when reducing an axis that is not innermost
+constexpr std::size_t reduce_block = 64;
+// Elements below which a reduction is not split across threads
+constexpr std::size_t reduce_min_grain = 4096;
+
+template <class Acc, class Read, class Op>
+Acc reduce_contiguous(
+    std::size_t base, std::size_t first, std::size_t last, Acc init, Read read, Op op)
+{
+    std::array<Acc, reduce_lanes> lanes;
+    lanes.fill(init);
+    std::size_t k = first;
+    for(; k + reduce_lanes <= last; k += reduce_lanes)
+    {
+        for(std::size_t l = 0; l < reduce_lanes; l++)
+            lanes[l] = op(lanes[l], read(base + k + l, k + l));
+    }
+    for(; k < last; k++)
+        lanes[0] = op(lanes[0], read(base + k, k));
+    Acc result = init;
+    for(const auto& lane : lanes)
+        result = op(result, lane);
+    return result;
+}
+
+template <class Acc, class Read, class Op>
+void reduce_strided(const reduce_layout& l,
+                    std::size_t base,
+                    std::size_t first,
+                    std::size_t last,
+                    Acc* acc,
+                    std::size_t n,
+                    Read read,
+                    Op op)
+{
+    for(std::size_t k = first; k < last; k++)
+    {
+        auto row = base + k * l.inner;
+        for(std::size_t j = 0; j < n; j++)
+            acc[j] = op(acc[j], read(row + j, k));
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief Reduces each output of a layout in a single pass over the input
+ *
+ * The value of the k-th element of a reduction, at index i of the input, is read(i, k), and
+ * values are combined with op, starting from init. Each result is passed to write with the
+ * index of its output. The work is run with execute(n, min_grain, f), which calls f(start, end)
+ * on ranges that cover [0, n), possibly on several threads. op has to be associative, as the
+ * reduction is split into partial results when there are fewer outputs than nthreads.
+ */
+template <class Execute, class Acc, class Read, class Op, class Write>
+void par_reduce(const reduce_layout& l,
+                std::size_t nthreads,
+                Execute execute,
+                Acc init,
+                Read read,
+                Op op,
+                Write write)
+{
+    if(l.outputs() == 0)
+        return;
+    std::size_t chunks = 1;
+    if(l.outputs() < nthreads and l.reduce >= 2 * detail::reduce_min_grain)
+        chunks = std::min(nthreads, l.reduce / detail::reduce_min_grain);
+    std::size_t chunk_size = (l.reduce + chunks - 1) / chunks;
+
+    // Each task reduces a block of outputs over a chunk of the reduced elements
+    std::size_t blocks = (l.inner + detail::reduce_block - 1) / detail::reduce_block;
+    std::size_t tasks  = l.outer * blocks;
+    std::vector<Acc> partials(chunks > 1 ? chunks * l.outputs() : 0, init);
+    auto reduce_task = [&](std::size_t task, std::size_t chunk, auto store) {
+        auto o     = task / blocks;
+        auto j0    = (task % blocks) * detail::reduce_block;
+        auto n     = std::min(detail::reduce_block, l.inner - j0);
+        auto first = chunk * chunk_size;
+        auto last  = std::min(l.reduce, first + chunk_size);
+        auto base  = o * l.reduce * l.inner + j0;
+        if(l.inner == 1)
+        {
+            store(o, detail::reduce_contiguous(base, first, last, init, read, op));
+            return;
+        }
+        std::array<Acc, detail::reduce_block> acc;
+        std::fill(acc.begin(), acc.begin() + n, init);
+        detail::reduce_strided(l, base, first, last, acc.data(), n, read, op);
+        for(std::size_t j = 0; j < n; j++)
+            store(o * l.inner + j0 + j, acc[j]);
+    };
+
+    if(chunks == 1)
+    {
+        // Enough tasks go to each thread for it to read at least the min grain
+        std::size_t task_size = std::max<std::size_t>(l.reduce * l.inner / tasks, 1);
+        std::size_t grain     = std::max<std::size_t>(detail::reduce_min_grain / task_size, 1);
+        execute(tasks, grain, [&](std::size_t start, std::size_t end) {
+            for(auto task = start; task < end; task++)
+                reduce_task(task, 0, write);
+        });
+        return;
+    }
+    execute(chunks * tasks, 1, [&](std::size_t start, std::size_t end) {
+        for(auto i = start; i < end; i++)
+        {
+            auto chunk = i / tasks;
+            reduce_task(i % tasks, chunk, [&](std::size_t out, const Acc& x) {
+                partials[chunk * l.outputs() + out] = x;
+            });
+        }
+    });
+    for(std::size_t out = 0; out < l.outputs(); out++)
+    {
+        Acc result = init;
+        for(std::size_t chunk = 0; chunk < chunks; chunk++)
+            result = op(result, partials[chunk * l.outputs() + out]);
+        write(out, result);
+    }
+}
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif
@@ -10,15 +10,67 @@
 #include <migraphx/target.hpp>
 #include <migraphx/tracer.hpp>
 #include <migraphx/env.hpp>
+#include <migraphx/value.hpp>
 #include <migraphx/config.hpp>
 #include <algorithm>
+#include <cstdint>
 #include <iostream>
+#include <string>
+#include <vector>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
 
-void run_passes(module& mod, const std::vector<pass>& passes, tracer trace = tracer{});
-void run_passes(program& prog, const std::vector<pass>& passes, tracer trace = tracer{});
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_TRACE_PASS_STATS)
+
+struct pass_stats
+{
+    std::string pass;
+    std::string module;
+    std::size_t runs = 0;
+    double ms        = 0;
+    // Change in the number of instructions
+    std::int64_t instructions = 0;
+    // Change in the bytes of the literals
+    std::int64_t literal_bytes = 0;
+    // Matches applied with find_matches
+    std::size_t matches = 0;
+};
+
+/// Statistics of each pass on each module, added up over every time the pass ran on the module
+struct pass_statistics
+{
+    void add(const pass_stats& s);
+
+    /// In the order the passes first ran on each module
+    const std::vector<pass_stats>& get_stats() const;
+    /// Added up over the modules, in the order the passes first ran
+    std::vector<pass_stats> get_pass_totals() const;
+    double total_ms() const;
+
+    value to_value() const;
+    /// Prints the totals of each pass, slowest first
+    void print(std::ostream& os) const;
+
+    private:
+    std::vector<pass_stats> stats;
+    std::unordered_map<std::string, std::size_t> index;
+};
+
+/// When stats is given, the time and the changes of each pass are added to it. Passes that
+/// apply to the whole program are counted under the "@program" module.
+void run_passes(module& mod,
+                const std::vector<pass>& passes,
+                tracer trace           = tracer{},
+                pass_statistics* stats = nullptr);
+/// When parallel is set, and nothing is traced, each pass runs at the same time on the modules
+/// that don't depend on each other, after their submodules. The stats are still added in an
+/// order that only depends on the program.
+void run_passes(program& prog,
+                const std::vector<pass>& passes,
+                tracer trace           = tracer{},
+                pass_statistics* stats = nullptr,
+                bool parallel          = false);
 
 } // namespace MIGRAPHX_INLINE_NS
 } // namespace migraphx
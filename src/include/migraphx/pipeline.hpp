@@ -0,0 +1,91 @@
+#ifndef MIGRAPHX_GUARD_RTGLIB_PIPELINE_HPP
+#define MIGRAPHX_GUARD_RTGLIB_PIPELINE_HPP
+
+#include <migraphx/program.hpp>
+#include <migraphx/target.hpp>
+#include <migraphx/compile_options.hpp>
+#include <migraphx/instruction_ref.hpp>
+#include <migraphx/config.hpp>
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+/// Estimated cost of an instruction, in the same units for every instruction
+using pipeline_weight = std::function<std::size_t(instruction_ref)>;
+
+/// The default cost: the elements computed, scaled for convolutions, dots and pooling like the
+/// weights of the gpu schedule model. Views, literals and parameters cost nothing.
+std::size_t default_pipeline_weight(instruction_ref ins);
+
+struct pipeline_stage_stats
+{
+    std::size_t instructions = 0;
+    std::size_t weight       = 0;
+    std::size_t runs         = 0;
+    // Time spent running the stage
+    double busy_ms = 0;
+    // Time spent waiting for a micro-batch from the previous stage
+    double wait_input_ms = 0;
+    // Time spent waiting for room in the queue of the next stage
+    double wait_output_ms = 0;
+
+    double latency_ms() const;
+    /// Fraction of the time the stage was running while it was waiting for micro-batches
+    double utilization() const;
+};
+
+struct pipeline_stage
+{
+    program prog;
+    // Names of the values returned by the stage
+    std::vector<std::string> outputs;
+    pipeline_stage_stats stats;
+};
+
+/**
+ * @brief Runs a program as a pipeline of stages that run concurrently on micro-batches
+ *
+ * The main module is split into one contiguous stage for each target, balanced by the estimated
+ * cost of its instructions, and each stage is compiled for its own target. Each stage runs on its
+ * own thread with the context of its target, which for the cpu can limit the threads it uses and
+ * pin them to a NUMA node, and the stages pass the micro-batches to each other through bounded
+ * queues. Values crossing from one stage to another are copied, since the next micro-batch reuses
+ * the memory of the stage that computed them.
+ */
+struct pipeline
+{
+    /// Fills the parameters of the next micro-batch, returning false when there are no more
+    using reader = std::function<bool(parameter_map& params)>;
+    /// Receives the outputs of each micro-batch, in the order they were read
+    using writer = std::function<void(const std::vector<argument>& outputs)>;
+
+    pipeline() = default;
+    pipeline(const program& p,
+             const std::vector<target>& targets,
+             const compile_options& options = compile_options{},
+             const pipeline_weight& weight  = nullptr);
+
+    std::size_t size() const;
+    const program& get_stage(std::size_t i) const;
+
+    /// Runs micro-batches through the stages until the reader returns false, returning how many
+    /// were run. The reader runs on its own thread, and the writer on the calling thread.
+    std::size_t run(const reader& read, const writer& write, std::size_t queue_size = 2);
+
+    /// Counters of each stage, accumulated over every run
+    std::vector<pipeline_stage_stats> get_stats() const;
+    void print_stats(std::ostream& os) const;
+
+    private:
+    std::vector<pipeline_stage> stages;
+    std::vector<std::string> outputs;
+};
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif
@@ -20,6 +20,7 @@ inline namespace MIGRAPHX_INLINE_NS {
 
 MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_TRACE_COMPILE)
 MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_TRACE_EVAL)
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_DISABLE_PARALLEL_COMPILE)
 
 struct program_impl;
 
@@ -49,6 +50,25 @@ struct program
 
     std::unordered_map<std::string, shape> get_parameter_shapes() const;
 
+    /// Makes a parameter of the main module a state: its buffer is kept by the
+    /// program, starts zero-filled, and is passed to every eval that does not
+    /// give the parameter, so ops that write into it, such as cache_append,
+    /// carry their results over to the next eval
+    void add_state(const std::string& name);
+
+    std::vector<std::string> get_state_names() const;
+
+    /// The buffer of a state, which is shared with the program
+    argument get_state(const std::string& name) const;
+
+    /// Copies the data of an argument into a state
+    void set_state(const std::string& name, const argument& a);
+
+    /// Fills a state with zeros
+    void reset_state(const std::string& name);
+
+    void reset_states();
+
     std::vector<argument> eval(parameter_map params) const;
 
     std::size_t size() const;
@@ -70,6 +90,12 @@ struct program
     value to_value() const;
     void from_value(const value& v);
 
+    /// Same as to_value but the data of each literal is left out and the
+    /// literal is appended to `literals` instead, with its index stored in the value
+    value to_value(std::vector<literal>& literals) const;
+    /// Reverse of to_value(literals)
+    void from_value(const value& v, const std::vector<literal>& literals);
+
     void debug_print() const;
     void debug_print(instruction_ref ins) const;
     void print(std::unordered_map<instruction_ref, std::string>& names,
@@ -0,0 +1,30 @@
+#ifndef MIGRAPHX_GUARD_RTGLIB_SINK_TRANSPOSE_HPP
+#define MIGRAPHX_GUARD_RTGLIB_SINK_TRANSPOSE_HPP
+
+#include <string>
+#include <migraphx/instruction_ref.hpp>
+#include <migraphx/config.hpp>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+struct module;
+
+/**
+ * Move transposes down through pointwise, multibroadcast, reduce, concat and
+ * slice operators, rewriting their axes, until they cancel with another
+ * transpose or reach an operator that depends on the layout. This removes the
+ * pairs of transposes that wrap NHWC operators in models coming from
+ * TensorFlow. Transposes are only moved past operators whose other inputs are
+ * transposed the same way, constant or broadcasted, so no copies are added.
+ */
+struct sink_transpose
+{
+    std::string name() const { return "sink_transpose"; }
+    void apply(module& m) const;
+};
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif
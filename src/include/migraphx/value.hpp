@@ -166,13 +166,17 @@ struct value
     value() = default;
 
     value(const value& rhs);
+    value(value&& rhs) noexcept;
     value& operator=(value rhs);
     value(const std::string& pkey, const value& rhs);
+    value(const std::string& pkey, value&& rhs);
 
     value(const std::initializer_list<value>& i);
     value(const std::vector<value>& v, bool array_on_empty = true);
+    value(std::vector<value>&& v, bool array_on_empty = true);
     value(const std::unordered_map<std::string, value>& m);
     value(const std::string& pkey, const std::vector<value>& v, bool array_on_empty = true);
+    value(const std::string& pkey, std::vector<value>&& v, bool array_on_empty = true);
     value(const std::string& pkey, const std::unordered_map<std::string, value>& m);
     value(const std::string& pkey, std::nullptr_t);
     value(std::nullptr_t);
@@ -289,7 +293,9 @@ struct value
     void resize(std::size_t n, const value& v);
 
     std::pair<value*, bool> insert(const value& v);
+    std::pair<value*, bool> insert(value&& v);
     value* insert(const value* pos, const value& v);
+    value* insert(const value* pos, value&& v);
 
     template <class... Ts>
     std::pair<value*, bool> emplace(Ts&&... xs)
@@ -305,10 +311,14 @@ struct value
 
     void push_back(const value& v) { insert(end(), v); }
 
+    void push_back(value&& v) { insert(end(), std::move(v)); }
+
     void push_front(const value& v) { insert(begin(), v); }
 
-    value with_key(const std::string& pkey) const;
-    value without_key() const;
+    value with_key(const std::string& pkey) const&;
+    value with_key(const std::string& pkey) &&;
+    value without_key() const&;
+    value without_key() &&;
 
     template <class Visitor>
     void visit(Visitor v) const
@@ -369,7 +379,7 @@ struct value
     To to() const
     {
         To result;
-        this->visit([&](auto y) { result = try_convert_value<To>(y); });
+        this->visit([&](const auto& y) { result = try_convert_value<To>(y); });
         return result;
     }
 
@@ -387,9 +397,10 @@ struct value
         std::vector<To> result;
         const auto& values = is_object() ? get_object() : get_array();
         result.reserve(values.size());
-        std::transform(values.begin(), values.end(), std::back_inserter(result), [&](auto v) {
-            return v.template to<To>();
-        });
+        std::transform(values.begin(),
+                       values.end(),
+                       std::back_inserter(result),
+                       [&](const value& v) { return v.template to<To>(); });
         return result;
     }
 
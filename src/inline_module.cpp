@@ -59,9 +59,7 @@ static void inline_submodule(module& m, instruction_ref ins, bool cond)
     assert(mod_outputs.size() >= ins_outputs.size());
     for(const auto& out : ins_outputs)
     {
-        auto val = out->get_operator().to_value();
-        assert(val.contains("index"));
-        auto index = val.at("index").to<std::size_t>();
+        auto index = out->get_operator().get_field("index").to<std::size_t>();
         m.replace_instruction(out, mod_outputs.at(index));
     }
 }
@@ -14,8 +14,7 @@ inline namespace MIGRAPHX_INLINE_NS {
 static void update_op(const instruction_ref& input, const instruction_ref& ins, module& m)
 {
     auto op         = ins->get_operator();
-    auto val        = op.to_value();
-    auto op_padding = val.at("padding").to_vector<size_t>();
+    auto op_padding = op.get_field("padding").to_vector<size_t>();
 
     auto kdims = input->get_shape().lens().size() - 2;
     if(std::equal(op_padding.begin(),
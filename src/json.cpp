@@ -3,6 +3,8 @@
 #include <migraphx/literal.hpp>
 #include <nlohmann/json.hpp>
 #include <migraphx/json.hpp>
+#include <istream>
+#include <ostream>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
@@ -143,6 +145,72 @@ migraphx::value from_json_string(const std::string& str)
     json j = json::parse(str);
     return j.get<value>();
 }
+migraphx::value from_json_stream(std::istream& is)
+{
+    json j = json::parse(is);
+    return j.get<value>();
+}
+
+void json_writer::separator()
+{
+    if(after_key)
+    {
+        after_key = false;
+        return;
+    }
+    if(written.empty())
+        return;
+    if(written.back())
+        *os << ",";
+    written.back() = true;
+}
+
+void json_writer::write_map(std::size_t)
+{
+    separator();
+    *os << "{";
+    written.push_back(false);
+}
+void json_writer::write_array(std::size_t)
+{
+    separator();
+    *os << "[";
+    written.push_back(false);
+}
+void json_writer::end_map()
+{
+    *os << "}";
+    written.pop_back();
+}
+void json_writer::end_array()
+{
+    *os << "]";
+    written.pop_back();
+}
+void json_writer::write_key(const std::string& key)
+{
+    separator();
+    *os << json(key).dump() << ":";
+    after_key = true;
+}
+void json_writer::write(const value& v)
+{
+    separator();
+    *os << to_json_string(v);
+}
+// Same layout as value_to_json uses for value::binary
+void json_writer::write_binary(const char* data, std::size_t size)
+{
+    separator();
+    *os << "{\"bytes\":[";
+    for(std::size_t i = 0; i < size; i++)
+    {
+        if(i > 0)
+            *os << ",";
+        *os << static_cast<int>(static_cast<std::uint8_t>(data[i]));
+    }
+    *os << "]}";
+}
 
 } // namespace MIGRAPHX_INLINE_NS
 } // namespace migraphx
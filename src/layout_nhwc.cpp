@@ -0,0 +1,76 @@
+#include <migraphx/layout_nhwc.hpp>
+#include <migraphx/module.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/iterator_for.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/eliminate_contiguous.hpp>
+#include <migraphx/dead_code_elimination.hpp>
+#include <migraphx/env.hpp>
+#include <algorithm>
+#include <iostream>
+#include <numeric>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_TRACE_LAYOUT_NHWC)
+
+static std::vector<int64_t> channels_last(std::size_t rank)
+{
+    std::vector<int64_t> result(rank);
+    std::iota(result.begin() + 1, result.end(), 2);
+    result.back() = 1;
+    return result;
+}
+
+static void transform_convolutions(module& m)
+{
+    for(auto ins : iterator_for(m))
+    {
+        if(ins->name() != "convolution")
+            continue;
+        auto perm = channels_last(ins->get_shape().lens().size());
+        auto x    = m.insert_instruction(
+            ins, make_op("layout", {{"permutation", perm}}), ins->inputs().front());
+        auto conv = m.insert_instruction(ins, ins->get_operator(), x, ins->inputs().back());
+        m.replace_instruction(ins, make_op("contiguous"), conv);
+    }
+}
+
+// Remove the layouts of inputs that are already laid out as channels last
+static void remove_layouts(module& m)
+{
+    for(auto ins : iterator_for(m))
+    {
+        if(ins->name() != "layout")
+            continue;
+        auto input = ins->inputs().front();
+        if(ins->get_shape() == input->get_shape())
+            m.replace_instruction(ins, input);
+    }
+}
+
+static std::size_t count_name(const module& m, const std::string& name)
+{
+    return std::count_if(
+        m.begin(), m.end(), [&](const instruction& ins) { return ins.name() == name; });
+}
+
+void layout_nhwc::apply(module& m) const
+{
+    transform_convolutions(m);
+    dead_code_elimination{}.apply(m);
+    eliminate_contiguous{"contiguous"}.apply(m);
+    dead_code_elimination{}.apply(m);
+    remove_layouts(m);
+    dead_code_elimination{}.apply(m);
+    if(enabled(MIGRAPHX_TRACE_LAYOUT_NHWC{}))
+    {
+        std::cout << "layout_nhwc: " << count_name(m, "layout") << " layout and "
+                  << count_name(m, "contiguous") << " contiguous left around "
+                  << count_name(m, "convolution") << " convolutions" << std::endl;
+    }
+}
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
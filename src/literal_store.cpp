@@ -0,0 +1,102 @@
+#include <migraphx/literal_store.hpp>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+struct literal_store
+{
+    struct entry
+    {
+        const char* data  = nullptr;
+        std::size_t bytes = 0;
+        std::weak_ptr<char> buffer;
+    };
+    std::mutex m;
+    std::unordered_multimap<std::size_t, entry> entries;
+    std::size_t total_bytes = 0;
+
+    void remove(std::size_t h, const char* data)
+    {
+        std::lock_guard<std::mutex> lock(m);
+        auto r = entries.equal_range(h);
+        for(auto it = r.first; it != r.second; ++it)
+        {
+            if(it->second.data != data)
+                continue;
+            total_bytes -= it->second.bytes;
+            entries.erase(it);
+            return;
+        }
+    }
+};
+
+// The store is kept alive by every buffer it hands out, so buffers released during static
+// destruction can still unregister themselves
+static std::shared_ptr<literal_store> get_literal_store()
+{
+    static auto store = std::make_shared<literal_store>(); // NOLINT
+    return store;
+}
+
+static std::size_t hash_bytes(const char* data, std::size_t n)
+{
+    const std::uint64_t prime = 1099511628211ULL;
+    std::uint64_t h           = 14695981039346656037ULL ^ n;
+    std::size_t i             = 0;
+    for(; i + sizeof(std::uint64_t) <= n; i += sizeof(std::uint64_t))
+    {
+        std::uint64_t w;
+        std::memcpy(&w, data + i, sizeof(w));
+        h = (h ^ w) * prime;
+        h ^= h >> 29u;
+    }
+    for(; i < n; i++)
+        h = (h ^ static_cast<unsigned char>(data[i])) * prime;
+    return h;
+}
+
+std::shared_ptr<char> intern_literal_data(const std::shared_ptr<char>& buffer, std::size_t bytes)
+{
+    if(buffer == nullptr or bytes == 0)
+        return buffer;
+    auto store = get_literal_store();
+    auto h     = hash_bytes(buffer.get(), bytes);
+    // Buffers locked while searching must be released after the mutex, since dropping the
+    // last reference unregisters the buffer from the store
+    std::vector<std::shared_ptr<char>> candidates;
+    std::shared_ptr<char> result;
+    std::lock_guard<std::mutex> lock(store->m);
+    auto r = store->entries.equal_range(h);
+    for(auto it = r.first; it != r.second; ++it)
+    {
+        if(it->second.bytes != bytes)
+            continue;
+        auto candidate = it->second.buffer.lock();
+        if(candidate == nullptr)
+            continue;
+        candidates.push_back(candidate);
+        if(candidate == buffer or std::memcmp(candidate.get(), buffer.get(), bytes) == 0)
+            return candidate;
+    }
+    result = std::shared_ptr<char>(buffer.get(), [store, buffer, h](char* data) {
+        store->remove(h, data);
+    });
+    store->entries.emplace(h, literal_store::entry{buffer.get(), bytes, result});
+    store->total_bytes += bytes;
+    return result;
+}
+
+std::size_t literal_store_bytes()
+{
+    auto store = get_literal_store();
+    std::lock_guard<std::mutex> lock(store->m);
+    return store->total_bytes;
+}
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
@@ -1,16 +1,20 @@
 #include <migraphx/load_save.hpp>
-#include <migraphx/file_buffer.hpp>
 #include <migraphx/json.hpp>
 #include <migraphx/msgpack.hpp>
-#include <migraphx/file_buffer.hpp>
+#include <migraphx/serialize.hpp>
 #include <fstream>
+#include <memory>
+#include <new>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
 
 program load(const std::string& filename, const file_options& options)
 {
-    return load_buffer(read_buffer(filename), options);
+    std::ifstream is(filename, std::ios::binary);
+    if(not is)
+        MIGRAPHX_THROW("Error opening file: " + filename);
+    return load(is, options);
 }
 program load_buffer(const std::vector<char>& buffer, const file_options& options)
 {
@@ -34,9 +38,253 @@ program load_buffer(const char* buffer, std::size_t size, const file_options& op
     return p;
 }
 
+// Aligned for the cpu, so compiled literals don't have to be copied again when they are finalized
+static std::shared_ptr<char> allocate_literal(std::size_t size)
+{
+    constexpr std::align_val_t alignment{64};
+    return {static_cast<char*>(::operator new(size, alignment)),
+            [=](char* x) { ::operator delete(x, alignment); }};
+}
+
+// Reads the program value with the literal data going straight into the
+// literal buffers instead of into the value
+static program read_program(msgpack_reader& r)
+{
+    std::vector<literal> literals;
+    auto read_literal = [&] {
+        shape s;
+        std::shared_ptr<char> data;
+        std::size_t size = 0;
+        auto n           = r.read_map();
+        for(std::size_t i = 0; i < n; i++)
+        {
+            auto key = r.read_string();
+            if(key == "shape")
+            {
+                s = migraphx::from_value<shape>(r.read());
+            }
+            else if(key == "data")
+            {
+                size = r.read_binary();
+                data = allocate_literal(size);
+                r.read_bytes(data.get(), size);
+            }
+            else
+            {
+                r.read();
+            }
+        }
+        if(data == nullptr or size != s.bytes())
+            MIGRAPHX_THROW("Invalid literal data");
+        literals.push_back(literal{s, data}.intern());
+        return value(literals.size() - 1);
+    };
+
+    // The literals held by operators are read the same way
+    auto read_op_literal = [&](const std::string& key, value& v) {
+        if(key != "@literal")
+            return false;
+        v = read_literal();
+        return true;
+    };
+
+    auto read_nodes = [&] {
+        value nodes = value::array{};
+        auto n      = r.read_array();
+        for(std::size_t i = 0; i < n; i++)
+        {
+            value node = value::object{};
+            auto m     = r.read_map();
+            for(std::size_t j = 0; j < m; j++)
+            {
+                auto key = r.read_string();
+                if(key == "literal")
+                    node[key] = read_literal();
+                else if(key == "operator")
+                    node[key] = r.read(read_op_literal);
+                else
+                    node[key] = r.read();
+            }
+            nodes.push_back(node);
+        }
+        return nodes;
+    };
+
+    value v = value::object{};
+    auto n  = r.read_map();
+    for(std::size_t i = 0; i < n; i++)
+    {
+        auto key = r.read_string();
+        if(key != "modules")
+        {
+            v[key] = r.read();
+            continue;
+        }
+        value module_vals = value::object{};
+        auto nmods        = r.read_map();
+        for(std::size_t j = 0; j < nmods; j++)
+        {
+            auto name     = r.read_string();
+            value mod_val = value::object{};
+            auto nfields  = r.read_map();
+            for(std::size_t k = 0; k < nfields; k++)
+            {
+                auto field = r.read_string();
+                if(field != "nodes")
+                    mod_val[field] = r.read();
+                else if(r.read_nil())
+                    mod_val[field] = nullptr;
+                else
+                    mod_val[field] = read_nodes();
+            }
+            module_vals[name] = mod_val;
+        }
+        v[key] = module_vals;
+    }
+    program p;
+    p.from_value(v, literals);
+    return p;
+}
+
+program load(std::istream& is, const file_options& options)
+{
+    if(options.format == "msgpack")
+    {
+        msgpack_reader r{is};
+        return read_program(r);
+    }
+    else if(options.format == "json")
+    {
+        program p;
+        p.from_value(from_json_stream(is));
+        return p;
+    }
+    else
+    {
+        MIGRAPHX_THROW("Unknown format: " + options.format);
+    }
+}
+
+template <class Writer>
+static void write_literal(Writer& w, const literal& l)
+{
+    w.write_map(2);
+    w.write_key("shape");
+    w.write(migraphx::to_value(l.get_shape()));
+    w.write_key("data");
+    w.write_binary(l.data(), l.get_shape().bytes());
+    w.end_map();
+}
+
+// Writes an operator value, where the literals it holds are only indices into the table
+template <class Writer>
+static void write_operator(Writer& w, const value& v, const std::vector<literal>& literals)
+{
+    if(v.is_object())
+    {
+        w.write_map(v.size());
+        for(const auto& x : v)
+        {
+            w.write_key(x.get_key());
+            if(x.get_key() == "@literal")
+                write_literal(w, literals.at(x.to<std::size_t>()));
+            else
+                write_operator(w, x.without_key(), literals);
+        }
+        w.end_map();
+    }
+    else if(v.is_array())
+    {
+        w.write_array(v.size());
+        for(const auto& x : v)
+            write_operator(w, x.without_key(), literals);
+        w.end_array();
+    }
+    else
+    {
+        w.write(v);
+    }
+}
+
+// Writes the program value with the literal data taken directly from the
+// literal buffers
+template <class Writer>
+static void write_program(Writer& w, const value& v, const std::vector<literal>& literals)
+{
+    auto write_node = [&](const value& node) {
+        w.write_map(node.size());
+        for(const auto& x : node)
+        {
+            w.write_key(x.get_key());
+            if(x.get_key() == "literal")
+                write_literal(w, literals.at(x.to<std::size_t>()));
+            else if(x.get_key() == "operator")
+                write_operator(w, x.without_key(), literals);
+            else
+                w.write(x.without_key());
+        }
+        w.end_map();
+    };
+
+    w.write_map(v.size());
+    for(const auto& x : v)
+    {
+        w.write_key(x.get_key());
+        if(x.get_key() != "modules")
+        {
+            w.write(x.without_key());
+            continue;
+        }
+        w.write_map(x.size());
+        for(const auto& mod_val : x)
+        {
+            w.write_key(mod_val.get_key());
+            w.write_map(mod_val.size());
+            for(const auto& field : mod_val)
+            {
+                w.write_key(field.get_key());
+                if(field.get_key() != "nodes" or not field.is_array())
+                {
+                    w.write(field.without_key());
+                    continue;
+                }
+                w.write_array(field.size());
+                for(const auto& node : field)
+                    write_node(node);
+                w.end_array();
+            }
+            w.end_map();
+        }
+        w.end_map();
+    }
+    w.end_map();
+}
+
 void save(const program& p, const std::string& filename, const file_options& options)
 {
-    write_buffer(filename, save_buffer(p, options));
+    std::ofstream os(filename, std::ios::binary);
+    if(not os)
+        MIGRAPHX_THROW("Error opening file: " + filename);
+    save(p, os, options);
+}
+void save(const program& p, std::ostream& os, const file_options& options)
+{
+    std::vector<literal> literals;
+    value v = p.to_value(literals);
+    if(options.format == "msgpack")
+    {
+        msgpack_writer w{os};
+        write_program(w, v, literals);
+    }
+    else if(options.format == "json")
+    {
+        json_writer w{os};
+        write_program(w, v, literals);
+    }
+    else
+    {
+        MIGRAPHX_THROW("Unknown format: " + options.format);
+    }
 }
 std::vector<char> save_buffer(const program& p, const file_options& options)
 {
@@ -7,6 +7,7 @@
 #include <migraphx/time.hpp>
 #include <migraphx/iterator_for.hpp>
 #include <migraphx/iterator.hpp>
+#include <migraphx/par_for.hpp>
 #include <migraphx/pass_manager.hpp>
 #include <migraphx/make_op.hpp>
 #include <migraphx/register_target.hpp>
@@ -28,6 +29,10 @@ struct module_impl
     std::unordered_set<instruction*> instruction_set;
     std::string name;
     uint32_t nparams = 0;
+    // Parameter names computed by finalize, cleared whenever an instruction is
+    // added, removed or replaced
+    std::vector<std::string> param_names;
+    bool has_param_names = false;
 
     bool contains(instruction_ref ins) const
     {
@@ -42,6 +47,7 @@ struct module_impl
         // cppcheck-suppress redundantInitialization
         auto r = instructions.emplace(pos, std::forward<Ts>(xs)...);
         instruction_set.insert(std::addressof(*r));
+        has_param_names = false;
         return r;
     }
     instruction_ref insert(instruction_ref pos, const instruction& ins)
@@ -68,12 +74,14 @@ struct module_impl
     instruction_ref erase(instruction_ref pos)
     {
         instruction_set.erase(std::addressof(*pos));
+        has_param_names = false;
         return instructions.erase(pos);
     }
 
     instruction_ref erase(instruction_ref start, instruction_ref last)
     {
         std::for_each(start, last, [&](auto& ins) { instruction_set.erase(std::addressof(ins)); });
+        has_param_names = false;
         return instructions.erase(start, last);
     }
 };
@@ -111,6 +119,7 @@ void module::assign(const module& m)
     {
         impl->instructions.clear();
     }
+    impl->has_param_names = false;
     impl->name = m.impl->name;
 
     std::unordered_map<instruction_ref, instruction_ref> ins_map;
@@ -203,6 +212,7 @@ instruction_ref module::replace_instruction(instruction_ref ins,
 
     shape r = compute_shape(op, args);
     instruction::replace(ins, op, r, std::move(args));
+    impl->has_param_names = false;
     assert(ins->valid(begin()));
     return ins;
 }
@@ -215,6 +225,7 @@ instruction_ref module::replace_instruction(instruction_ref ins,
     assert(not starts_with(op.name(), "@"));
     auto out_shape = compute_shape(op, args, module_args);
     instruction::replace(ins, op, out_shape, std::move(args), std::move(module_args));
+    impl->has_param_names = false;
     assert(ins->valid(begin()));
     return ins;
 }
@@ -292,7 +303,7 @@ instruction_ref module::move_instructions(instruction_ref src, instruction_ref d
 
 instruction_ref module::add_literal(literal l)
 {
-    impl->emplace_front(std::move(l));
+    impl->emplace_front(l.intern());
     return impl->instructions.begin();
 }
 
@@ -342,6 +353,8 @@ shape module::get_parameter_shape(std::string name) const
 
 std::vector<std::string> module::get_parameter_names() const
 {
+    if(impl->has_param_names)
+        return impl->param_names;
     std::vector<std::string> result;
     std::vector<builtin::param> params;
     for(auto&& ins : impl->instructions)
@@ -473,18 +486,48 @@ instruction_ref module::find_dangling_reference() const
 
 void module::finalize(context& ctx)
 {
-    for(auto ins : iterator_for(*this))
+    std::vector<module*> mods = {this};
+    auto sub_modules          = this->get_sub_modules();
+    mods.insert(mods.end(), sub_modules.begin(), sub_modules.end());
+    finalize(mods, ctx);
+}
+
+void module::finalize(const std::vector<module*>& mods, context& ctx, bool parallel)
+{
+    // A submodule can be listed more than once, but is only finalized once
+    std::vector<module*> unique_mods;
+    std::unordered_set<module*> visited;
+    std::copy_if(mods.begin(), mods.end(), std::back_inserter(unique_mods), [&](auto* mod) {
+        return visited.insert(mod).second;
+    });
+    std::vector<instruction_ref> instructions;
+    for(auto* mod : unique_mods)
     {
-        ins->finalize(ctx);
-        for(const auto& smod : ins->module_inputs())
-        {
-            smod->finalize(ctx);
-        }
+        for(auto ins : iterator_for(*mod))
+            instructions.push_back(ins);
+    }
+    if(parallel)
+    {
+        par_for_rethrow(instructions.size(), 1, [&](auto i) { instructions[i]->finalize(ctx); });
+    }
+    else
+    {
+        for(auto ins : instructions)
+            ins->finalize(ctx);
+    }
+
+    for(auto* mod : unique_mods)
+    {
+        // Cache the parameter names so control flow operators can bind their
+        // inputs without walking the submodule every time it is run
+        mod->impl->param_names     = mod->get_parameter_names();
+        mod->impl->has_param_names = true;
     }
 
     // Warn when an instruction is not normalized
-    auto ins = std::find_if(begin(), end(), [](auto& i) { return i.need_normalization(); });
-    if(ins != end())
+    if(std::any_of(instructions.begin(), instructions.end(), [](auto ins) {
+           return ins->need_normalization();
+       }))
         std::cerr << "WARNING: Instruction needs normalization, performance may be affected."
                   << std::endl;
 }
@@ -1,6 +1,9 @@
 #include <migraphx/msgpack.hpp>
 #include <migraphx/serialize.hpp>
 #include <msgpack.hpp>
+#include <cstring>
+#include <istream>
+#include <ostream>
 
 namespace msgpack {
 MSGPACK_API_VERSION_NAMESPACE(MSGPACK_DEFAULT_API_NS)
@@ -173,5 +176,202 @@ value from_msgpack(const std::vector<char>& buffer)
     return from_msgpack(buffer.data(), buffer.size());
 }
 
+void msgpack_writer::write_map(std::size_t n)
+{
+    msgpack::packer<std::ostream> pk{*os};
+    pk.pack_map(n);
+}
+void msgpack_writer::write_array(std::size_t n)
+{
+    msgpack::packer<std::ostream> pk{*os};
+    pk.pack_array(n);
+}
+void msgpack_writer::write_key(const std::string& key)
+{
+    msgpack::packer<std::ostream> pk{*os};
+    pk.pack(key);
+}
+void msgpack_writer::write(const value& v)
+{
+    msgpack::packer<std::ostream> pk{*os};
+    pk.pack(v);
+}
+void msgpack_writer::write_binary(const char* data, std::size_t size)
+{
+    msgpack::packer<std::ostream> pk{*os};
+    pk.pack_bin(size);
+    pk.pack_bin_body(data, size);
+}
+
+std::uint8_t msgpack_reader::read_byte()
+{
+    auto c = is->get();
+    if(c == std::istream::traits_type::eof())
+        MIGRAPHX_THROW("msgpack: unexpected end of stream");
+    return static_cast<std::uint8_t>(c);
+}
+
+// Multi-byte values are stored big-endian
+std::uint64_t msgpack_reader::read_uint(std::size_t n)
+{
+    std::uint64_t result = 0;
+    for(std::size_t i = 0; i < n; i++)
+        result = (result << 8u) | read_byte();
+    return result;
+}
+
+void msgpack_reader::read_bytes(char* data, std::size_t size)
+{
+    if(not is->read(data, size))
+        MIGRAPHX_THROW("msgpack: unexpected end of stream");
+}
+
+std::size_t msgpack_reader::map_size(std::uint8_t tag)
+{
+    if((tag & 0xf0u) == 0x80u)
+        return tag & 0x0fu;
+    if(tag == 0xde)
+        return read_uint(2);
+    if(tag == 0xdf)
+        return read_uint(4);
+    MIGRAPHX_THROW("msgpack: expected a map");
+}
+
+std::size_t msgpack_reader::array_size(std::uint8_t tag)
+{
+    if((tag & 0xf0u) == 0x90u)
+        return tag & 0x0fu;
+    if(tag == 0xdc)
+        return read_uint(2);
+    if(tag == 0xdd)
+        return read_uint(4);
+    MIGRAPHX_THROW("msgpack: expected an array");
+}
+
+std::size_t msgpack_reader::string_size(std::uint8_t tag)
+{
+    if((tag & 0xe0u) == 0xa0u)
+        return tag & 0x1fu;
+    if(tag >= 0xd9 and tag <= 0xdb)
+        return read_uint(std::size_t{1} << (tag - 0xd9u));
+    MIGRAPHX_THROW("msgpack: expected a string");
+}
+
+std::size_t msgpack_reader::binary_size(std::uint8_t tag)
+{
+    if(tag >= 0xc4 and tag <= 0xc6)
+        return read_uint(std::size_t{1} << (tag - 0xc4u));
+    MIGRAPHX_THROW("msgpack: expected binary data");
+}
+
+bool msgpack_reader::read_nil()
+{
+    if(is->peek() != 0xc0)
+        return false;
+    is->get();
+    return true;
+}
+
+std::size_t msgpack_reader::read_map() { return map_size(read_byte()); }
+std::size_t msgpack_reader::read_array() { return array_size(read_byte()); }
+std::size_t msgpack_reader::read_binary() { return binary_size(read_byte()); }
+std::string msgpack_reader::read_string()
+{
+    std::string result(string_size(read_byte()), '\0');
+    read_bytes(&result[0], result.size());
+    return result;
+}
+
+value msgpack_reader::read() { return read(read_byte()); }
+
+value msgpack_reader::read(const std::function<bool(const std::string& key, value& v)>& read_field)
+{
+    return read(read_byte(), &read_field);
+}
+
+// Produces the same values as the convert<migraphx::value> adaptor above
+value msgpack_reader::read(std::uint8_t tag,
+                           const std::function<bool(const std::string& key, value& v)>* read_field)
+{
+    if(tag <= 0x7f)
+        return std::uint64_t{tag};
+    if(tag >= 0xe0)
+        return std::int64_t{static_cast<std::int8_t>(tag)};
+    if((tag & 0xf0u) == 0x80u or tag == 0xde or tag == 0xdf)
+    {
+        value r = value::object{};
+        auto n  = map_size(tag);
+        for(std::size_t i = 0; i < n; i++)
+        {
+            auto key = read_string();
+            value x;
+            if(read_field == nullptr or not(*read_field)(key, x))
+                x = read(read_byte(), read_field);
+            r[key] = x;
+        }
+        return r;
+    }
+    if((tag & 0xf0u) == 0x90u or tag == 0xdc or tag == 0xdd)
+    {
+        value r = value::array{};
+        auto n  = array_size(tag);
+        for(std::size_t i = 0; i < n; i++)
+            r.push_back(read(read_byte(), read_field));
+        return r;
+    }
+    if((tag & 0xe0u) == 0xa0u or (tag >= 0xd9 and tag <= 0xdb))
+    {
+        std::string result(string_size(tag), '\0');
+        read_bytes(&result[0], result.size());
+        return result;
+    }
+    if(tag >= 0xc4 and tag <= 0xc6)
+    {
+        value::binary result(binary_size(tag));
+        read_bytes(reinterpret_cast<char*>(result.data()), result.size());
+        return result;
+    }
+    switch(tag)
+    {
+    case 0xc0: return nullptr;
+    case 0xc2: return false;
+    case 0xc3: return true;
+    case 0xca:
+    {
+        auto bits = static_cast<std::uint32_t>(read_uint(4));
+        float f;
+        std::memcpy(&f, &bits, sizeof(f));
+        return double{f};
+    }
+    case 0xcb:
+    {
+        auto bits = read_uint(8);
+        double d;
+        std::memcpy(&d, &bits, sizeof(d));
+        return d;
+    }
+    case 0xcc:
+    case 0xcd:
+    case 0xce:
+    case 0xcf: return read_uint(std::size_t{1} << (tag - 0xccu));
+    case 0xd0:
+    case 0xd1:
+    case 0xd2:
+    case 0xd3:
+    {
+        auto n    = std::size_t{1} << (tag - 0xd0u);
+        auto bits = read_uint(n);
+        // Sign extend
+        auto shift = 64 - 8 * n;
+        auto x     = static_cast<std::int64_t>(bits << shift) >> shift;
+        // Non-negative integers are positive integers regardless of their encoding
+        if(x >= 0)
+            return static_cast<std::uint64_t>(x);
+        return x;
+    }
+    default: MIGRAPHX_THROW("msgpack EXT type not supported.");
+    }
+}
+
 } // namespace MIGRAPHX_INLINE_NS
 } // namespace migraphx
@@ -0,0 +1,95 @@
+#include <migraphx/instruction_ref.hpp>
+#include <migraphx/onnx/op_parser.hpp>
+#include <migraphx/onnx/onnx_parser.hpp>
+#include <migraphx/onnx/checks.hpp>
+#include <migraphx/ranges.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/op/loop.hpp>
+#include <limits>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace onnx {
+
+struct parse_loop : op_parser<parse_loop>
+{
+    std::vector<op_desc> operators() const { return {{"Loop"}}; }
+
+    std::vector<instruction_ref> parse(const op_desc& /*opd*/,
+                                       onnx_parser& parser,
+                                       const onnx_parser::node_info& info,
+                                       std::vector<instruction_ref> args) const
+    {
+        const auto& body_graph = info.attributes.at("body").g();
+        if(args.size() < 2)
+        {
+            MIGRAPHX_THROW("PARSE_LOOP: trip count and condition inputs are required!");
+        }
+
+        // The trip count and the condition can both be left out, the scan
+        // outputs are sized by the trip count when it is a constant. Without
+        // a trip count only the condition stops the loop.
+        int64_t max_iterations = parser.max_loop_iterations;
+        if(args[0]->name() == "undefined")
+        {
+            args[0] = info.add_literal(
+                literal{shape{shape::int64_type}, {std::numeric_limits<int64_t>::max()}});
+        }
+        else
+        {
+            auto arg_iters = args[0]->eval();
+            if(not arg_iters.empty())
+                max_iterations = arg_iters.at<int64_t>();
+        }
+        if(args[1]->name() == "undefined")
+        {
+            args[1] = info.add_literal(literal{shape{shape::bool_type}, {true}});
+        }
+        if(args[1]->get_shape().elements() != 1)
+        {
+            MIGRAPHX_THROW("PARSE_LOOP: condition input can have only one element!");
+        }
+
+        const auto& body_inputs = body_graph.input();
+        if(static_cast<std::size_t>(body_inputs.size()) != args.size())
+        {
+            MIGRAPHX_THROW("PARSE_LOOP: body should take the iteration number, the condition "
+                           "and the loop carried dependencies!");
+        }
+
+        // The types of the body inputs are often left out, so the parameters take
+        // the shapes of the loop inputs instead
+        module_ref body = parser.prog.create_module(info.name + "_loop");
+        parser.instructions[body_inputs.Get(0).name()] =
+            body->add_parameter(op::loop::iteration_param(), shape{shape::int64_type});
+        parser.instructions[body_inputs.Get(1).name()] =
+            body->add_parameter(op::loop::condition_param(), args[1]->get_shape());
+        for(std::size_t i = 2; i < args.size(); ++i)
+        {
+            const auto& name          = body_inputs.Get(i).name();
+            parser.instructions[name] =
+                body->add_parameter(op::loop::dependency_param(i - 2), args[i]->get_shape());
+        }
+        parser.parse_graph(body, body_graph);
+
+        auto loop_ret = info.add_instruction(
+            make_op("loop", {{"max_iterations", max_iterations}}), args, {body});
+        auto out_s    = loop_ret->get_shape();
+        assert(out_s.type() == shape::tuple_type);
+
+        const auto& vec_shapes = out_s.sub_shapes();
+        std::vector<instruction_ref> out_inss;
+        for(std::size_t i = 0; i < vec_shapes.size(); ++i)
+        {
+            auto ret = info.add_instruction(make_op("get_tuple_elem", {{"index", i}}), loop_ret);
+            out_inss.push_back(ret);
+        }
+
+        return out_inss;
+    }
+};
+
+} // namespace onnx
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
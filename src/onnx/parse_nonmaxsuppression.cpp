@@ -0,0 +1,41 @@
+#include <migraphx/onnx/op_parser.hpp>
+#include <migraphx/ranges.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/make_op.hpp>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace onnx {
+
+struct parse_nonmaxsuppression : op_parser<parse_nonmaxsuppression>
+{
+    std::vector<op_desc> operators() const { return {{"NonMaxSuppression"}}; }
+
+    instruction_ref parse(const op_desc& /*opd*/,
+                          const onnx_parser& parser,
+                          const onnx_parser::node_info& info,
+                          std::vector<instruction_ref> args) const
+    {
+        int center_point_box = 0;
+        if(contains(info.attributes, "center_point_box"))
+        {
+            center_point_box = parser.parse_value(info.attributes.at("center_point_box")).at<int>();
+        }
+
+        // Trailing inputs left out use the defaults of the operator, and the
+        // ones left out in front of a given input are replaced by the defaults
+        while(args.size() > 2 and args.back()->name() == "undefined")
+            args.pop_back();
+        if(args.size() > 2 and args[2]->name() == "undefined")
+            args[2] = info.add_literal(literal{shape{shape::int64_type}, {0}});
+        if(args.size() > 3 and args[3]->name() == "undefined")
+            args[3] = info.add_literal(literal{shape{shape::float_type}, {0.0f}});
+
+        return info.add_instruction(
+            make_op("nonmaxsuppression", {{"center_point_box", center_point_box != 0}}), args);
+    }
+};
+
+} // namespace onnx
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
@@ -30,8 +30,13 @@ struct parse_nonzero : op_parser<parse_nonzero>
                           const onnx_parser::node_info& info,
                           std::vector<instruction_ref> args) const
     {
+        // The indices of a constant input are computed here, which also gives
+        // the output its exact size
         migraphx::argument data_arg = args.back()->eval();
-        check_arg_empty(data_arg, "PARSE_NONZERO: cannot support non-constant input!");
+        if(data_arg.empty())
+        {
+            return info.add_instruction(make_op("nonzero"), args.back());
+        }
 
         std::vector<std::size_t> indices;
         data_arg.visit([&](auto val) {
@@ -0,0 +1,159 @@
+#include <migraphx/instruction_ref.hpp>
+#include <migraphx/onnx/op_parser.hpp>
+#include <migraphx/onnx/onnx_parser.hpp>
+#include <migraphx/onnx/checks.hpp>
+#include <migraphx/ranges.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/op/loop.hpp>
+#include <algorithm>
+#include <numeric>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace onnx {
+
+// Scan is run as a loop whose body gathers the current slice of each scan input
+struct parse_scan : op_parser<parse_scan>
+{
+    std::vector<op_desc> operators() const { return {{"Scan"}}; }
+
+    static std::vector<int64_t> get_ints(const onnx_parser::node_info& info,
+                                         const std::string& name,
+                                         std::size_t n,
+                                         int64_t default_value)
+    {
+        if(not contains(info.attributes, name))
+            return std::vector<int64_t>(n, default_value);
+        const auto& attr = info.attributes.at(name).ints();
+        if(static_cast<std::size_t>(attr.size()) != n)
+        {
+            MIGRAPHX_THROW("PARSE_SCAN: attribute " + name + " should have " +
+                           std::to_string(n) + " values!");
+        }
+        return {attr.begin(), attr.end()};
+    }
+
+    static int64_t normalize_axis(int64_t axis, std::size_t rank)
+    {
+        int64_t n = rank;
+        if(axis < -n or axis >= n)
+        {
+            MIGRAPHX_THROW("PARSE_SCAN: axis " + std::to_string(axis) + " is out of range!");
+        }
+        return axis < 0 ? axis + n : axis;
+    }
+
+    std::vector<instruction_ref> parse(const op_desc& /*opd*/,
+                                       onnx_parser& parser,
+                                       const onnx_parser::node_info& info,
+                                       std::vector<instruction_ref> args) const
+    {
+        if(parser.opset_version < 9)
+        {
+            MIGRAPHX_THROW("PARSE_SCAN: Scan before opset 9 is not supported!");
+        }
+        const auto& body_graph = info.attributes.at("body").g();
+        auto scan_num          = info.attributes.at("num_scan_inputs").i();
+        if(scan_num < 1 or static_cast<std::size_t>(scan_num) > args.size())
+        {
+            MIGRAPHX_THROW("PARSE_SCAN: invalid number of scan inputs!");
+        }
+        std::size_t state_num   = args.size() - scan_num;
+        const auto& body_inputs = body_graph.input();
+        if(static_cast<std::size_t>(body_inputs.size()) != args.size())
+        {
+            MIGRAPHX_THROW("PARSE_SCAN: body should take the states and one slice of each scan "
+                           "input!");
+        }
+        std::size_t out_scan_num = body_graph.output().size() - state_num;
+
+        auto in_axes  = get_ints(info, "scan_input_axes", scan_num, 0);
+        auto in_dirs  = get_ints(info, "scan_input_directions", scan_num, 0);
+        auto out_axes = get_ints(info, "scan_output_axes", out_scan_num, 0);
+        auto out_dirs = get_ints(info, "scan_output_directions", out_scan_num, 0);
+
+        std::size_t seq_len = 0;
+        for(std::size_t j = 0; j < in_axes.size(); ++j)
+        {
+            const auto& s = args[state_num + j]->get_shape();
+            in_axes[j]    = normalize_axis(in_axes[j], s.lens().size());
+            auto len      = s.lens()[in_axes[j]];
+            if(j > 0 and len != seq_len)
+            {
+                MIGRAPHX_THROW("PARSE_SCAN: scan inputs must have the same sequence length!");
+            }
+            seq_len = len;
+        }
+
+        // The body takes the iteration number and the condition in front of the
+        // states, like the body of a Loop
+        module_ref body = parser.prog.create_module(info.name + "_scan");
+        auto iter = body->add_parameter(op::loop::iteration_param(), shape{shape::int64_type});
+        auto cond = body->add_parameter(op::loop::condition_param(), shape{shape::bool_type});
+        for(std::size_t i = 0; i < state_num; ++i)
+        {
+            const auto& name          = body_inputs.Get(i).name();
+            parser.instructions[name] =
+                body->add_parameter(op::loop::dependency_param(i), args[i]->get_shape());
+        }
+        auto last_index = body->add_literal(literal{shape{shape::int64_type}, {seq_len - 1}});
+        for(std::size_t j = 0; j < in_axes.size(); ++j)
+        {
+            auto index = iter;
+            if(in_dirs[j] != 0)
+                index = body->add_instruction(make_op("sub"), last_index, iter);
+            const auto& name          = body_inputs.Get(state_num + j).name();
+            parser.instructions[name] = body->add_instruction(
+                make_op("gather", {{"axis", in_axes[j]}}), args[state_num + j], index);
+        }
+        parser.parse_graph(body, body_graph);
+
+        // Return the condition along with the outputs of the body
+        auto body_ret = std::prev(body->end());
+        auto outputs  = body_ret->inputs();
+        outputs.insert(outputs.begin(), cond);
+        body->remove_instruction(body_ret);
+        body->add_return(outputs);
+
+        std::vector<instruction_ref> loop_args = {
+            info.add_literal(literal{shape{shape::int64_type}, {seq_len}}),
+            info.add_literal(literal{shape{shape::bool_type}, {true}})};
+        loop_args.insert(loop_args.end(), args.begin(), args.begin() + state_num);
+        auto loop_ret = info.add_instruction(
+            make_op("loop", {{"max_iterations", seq_len}}), loop_args, {body});
+        auto out_s    = loop_ret->get_shape();
+        assert(out_s.type() == shape::tuple_type);
+
+        const auto& vec_shapes = out_s.sub_shapes();
+        std::vector<instruction_ref> out_inss;
+        for(std::size_t i = 0; i < vec_shapes.size(); ++i)
+        {
+            auto ret = info.add_instruction(make_op("get_tuple_elem", {{"index", i}}), loop_ret);
+            if(i >= state_num)
+            {
+                // The loop stacks the scan outputs along a new leading axis
+                auto k = i - state_num;
+                if(out_dirs[k] != 0)
+                    ret = info.add_instruction(make_op("reverse", {{"axes", {0}}}), ret);
+                auto rank = vec_shapes[i].lens().size();
+                auto axis = normalize_axis(out_axes[k], rank);
+                if(axis != 0)
+                {
+                    // Move the leading axis to the scan output axis
+                    std::vector<int64_t> perm(rank);
+                    std::iota(perm.begin(), perm.end(), 0);
+                    std::rotate(perm.begin(), perm.begin() + 1, perm.begin() + axis + 1);
+                    ret = info.add_instruction(make_op("transpose", {{"dims", perm}}), ret);
+                }
+            }
+            out_inss.push_back(ret);
+        }
+
+        return out_inss;
+    }
+};
+
+} // namespace onnx
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
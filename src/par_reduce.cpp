@@ -0,0 +1,42 @@
+#include <migraphx/par_reduce.hpp>
+#include <migraphx/reduce_dims.hpp>
+#include <migraphx/ranges.hpp>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+optional<reduce_layout> find_reduce_layout(const shape& s, const std::vector<int64_t>& axes)
+{
+    if(not s.standard())
+        return nullopt;
+    auto out_lens = s.lens();
+    for(auto axis : axes)
+        out_lens[axis] = 1;
+    auto shapes         = reduce_dims({s, shape{s.type(), out_lens}});
+    const auto& lens    = shapes[0].lens();
+    const auto& reduced = shapes[1].lens();
+
+    reduce_layout result;
+    bool found = false;
+    for(std::size_t i = 0; i < lens.size(); i++)
+    {
+        if(lens[i] == reduced[i])
+        {
+            (found ? result.inner : result.outer) *= lens[i];
+        }
+        else if(found and result.inner > 1)
+        {
+            // A second group of reduced dimensions
+            return nullopt;
+        }
+        else
+        {
+            found = true;
+            result.reduce *= lens[i];
+        }
+    }
+    return result;
+}
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
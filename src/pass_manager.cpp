@@ -7,9 +7,16 @@
 #include <migraphx/ranges.hpp>
 #include <migraphx/time.hpp>
 #include <migraphx/iterator_for.hpp>
+#include <migraphx/matcher.hpp>
+#include <migraphx/par_for.hpp>
+#include <migraphx/functional.hpp>
+#include <iomanip>
 #include <iostream>
 #include <sstream>
 #include <algorithm>
+#include <numeric>
+#include <unordered_map>
+#include <unordered_set>
 #include <utility>
 
 namespace migraphx {
@@ -32,39 +39,299 @@ void validate_pass(module& mod, const pass& p, tracer trace)
     trace();
 #endif
 }
-void run_pass(module& mod, const pass& p, tracer trace)
+namespace match {
+std::size_t& get_match_count()
+{
+    thread_local std::size_t count = 0;
+    return count;
+}
+} // namespace match
+
+static std::int64_t get_literal_bytes(const module& mod)
+{
+    std::int64_t result = 0;
+    for(const auto& ins : mod)
+    {
+        if(ins.name() == "@literal")
+            result += ins.get_shape().bytes();
+    }
+    return result;
+}
+
+void pass_statistics::add(const pass_stats& s)
+{
+    auto key = s.pass + ":" + s.module;
+    auto it  = index.find(key);
+    if(it == index.end())
+    {
+        index.emplace(key, stats.size());
+        stats.push_back(s);
+        return;
+    }
+    auto& x = stats[it->second];
+    x.runs += s.runs;
+    x.ms += s.ms;
+    x.instructions += s.instructions;
+    x.literal_bytes += s.literal_bytes;
+    x.matches += s.matches;
+}
+
+const std::vector<pass_stats>& pass_statistics::get_stats() const { return stats; }
+
+std::vector<pass_stats> pass_statistics::get_pass_totals() const
+{
+    pass_statistics totals;
+    for(auto s : stats)
+    {
+        s.module = "";
+        totals.add(s);
+    }
+    return totals.stats;
+}
+
+double pass_statistics::total_ms() const
+{
+    return std::accumulate(
+        stats.begin(), stats.end(), 0.0, [](double x, const auto& s) { return x + s.ms; });
+}
+
+static value to_value(const pass_stats& s)
+{
+    value result = {{"pass", s.pass},
+                    {"runs", s.runs},
+                    {"ms", s.ms},
+                    {"instructions", s.instructions},
+                    {"literal_bytes", s.literal_bytes},
+                    {"matches", s.matches}};
+    if(not s.module.empty())
+        result["module"] = s.module;
+    return result;
+}
+
+value pass_statistics::to_value() const
+{
+    value modules = value::array{};
+    value passes  = value::array{};
+    for(const auto& s : stats)
+        modules.push_back(migraphx::to_value(s));
+    for(const auto& s : get_pass_totals())
+        passes.push_back(migraphx::to_value(s));
+    return {{"total_ms", total_ms()}, {"passes", passes}, {"modules", modules}};
+}
+
+void pass_statistics::print(std::ostream& os) const
+{
+    auto totals = get_pass_totals();
+    std::stable_sort(totals.begin(), totals.end(), [](const auto& x, const auto& y) {
+        return x.ms > y.ms;
+    });
+    auto total = total_ms();
+    os << std::fixed << std::setprecision(3);
+    for(const auto& s : totals)
+    {
+        os << s.pass << ": " << s.ms << "ms, " << (total > 0 ? s.ms * 100 / total : 0.0)
+           << "%, " << s.runs << " runs, " << s.instructions << " instructions, "
+           << s.literal_bytes << " literal bytes, " << s.matches << " matches" << std::endl;
+    }
+    os << "Total passes time: " << total << "ms" << std::endl;
+}
+
+void run_pass(module& mod, const pass& p, tracer trace, pass_statistics* stats)
 {
     trace("Module: ", mod.name(), ", Pass: ", p.name());
     assert(mod.validate() == mod.end());
-    p.apply(mod);
+    if(stats == nullptr)
+    {
+        p.apply(mod);
+    }
+    else
+    {
+        auto instructions  = static_cast<std::int64_t>(mod.size());
+        auto literal_bytes = get_literal_bytes(mod);
+        auto matches       = match::get_match_count();
+        pass_stats s;
+        s.pass          = p.name();
+        s.module        = mod.name();
+        s.runs          = 1;
+        s.ms            = time<std::chrono::duration<double, std::milli>>([&] { p.apply(mod); });
+        s.instructions  = static_cast<std::int64_t>(mod.size()) - instructions;
+        s.literal_bytes = get_literal_bytes(mod) - literal_bytes;
+        s.matches       = match::get_match_count() - matches;
+        stats->add(s);
+    }
     trace(mod);
     validate_pass(mod, p, trace);
 }
-void run_pass(program& prog, const pass& p, tracer trace)
+void run_pass(program& prog, const pass& p, tracer trace, pass_statistics* stats)
 {
     trace("Pass: ", p.name());
-    p.apply(prog);
+    if(stats == nullptr)
+    {
+        p.apply(prog);
+    }
+    else
+    {
+        auto matches = match::get_match_count();
+        pass_stats s;
+        s.pass    = p.name();
+        s.module  = "@program";
+        s.runs    = 1;
+        s.ms      = time<std::chrono::duration<double, std::milli>>([&] { p.apply(prog); });
+        s.matches = match::get_match_count() - matches;
+        stats->add(s);
+    }
     trace(prog);
 }
 
-void run_passes(module& mod, const std::vector<pass>& passes, tracer trace)
+void run_passes(module& mod, const std::vector<pass>& passes, tracer trace, pass_statistics* stats)
 {
     for(const auto& p : passes)
     {
-        run_pass(mod, p, trace);
+        run_pass(mod, p, trace, stats);
+    }
+}
+
+// The modules with their submodules, and whether none of their instructions use an instruction
+// from another module
+struct module_footprint
+{
+    std::unordered_set<module*> modules;
+    bool closed = true;
+};
+
+static module_footprint get_footprint(module* mod)
+{
+    module_footprint result;
+    result.modules.insert(mod);
+    auto sub_modules = mod->get_sub_modules();
+    result.modules.insert(sub_modules.begin(), sub_modules.end());
+    std::unordered_set<instruction_ref> instructions;
+    for(auto* m : result.modules)
+    {
+        for(auto ins : iterator_for(*m))
+            instructions.insert(ins);
     }
+    result.closed = std::all_of(instructions.begin(), instructions.end(), [&](auto ins) {
+        return std::all_of(ins->inputs().begin(), ins->inputs().end(), [&](auto input) {
+            return contains(instructions, input);
+        });
+    });
+    return result;
 }
 
-void run_passes(program& prog, const std::vector<pass>& passes, tracer trace)
+// Splits the modules into groups that a pass can run on at the same time. Every submodule of a
+// module is in an earlier group, and the modules in a group share no submodules and use no
+// instructions from other modules. The groups only depend on the order the modules are given.
+static std::vector<std::vector<module*>> group_modules(const std::vector<module*>& mods)
+{
+    // The longest chain of submodules below each module
+    std::unordered_map<module*, std::size_t> heights;
+    auto get_height = fix<std::size_t>([&](auto self, module* mod) -> std::size_t {
+        if(contains(heights, mod))
+            return heights.at(mod);
+        std::size_t h = 0;
+        for(auto&& ins : *mod)
+        {
+            for(auto* smod : ins.module_inputs())
+                h = std::max(h, self(smod) + 1);
+        }
+        heights[mod] = h;
+        return h;
+    });
+    std::vector<std::vector<module*>> levels;
+    std::unordered_set<module*> visited;
+    for(auto* mod : mods)
+    {
+        if(not visited.insert(mod).second)
+            continue;
+        auto h = get_height(mod);
+        if(levels.size() <= h)
+            levels.resize(h + 1);
+        levels[h].push_back(mod);
+    }
+
+    struct module_group
+    {
+        std::vector<module*> modules;
+        std::unordered_set<module*> used;
+        bool closed = true;
+    };
+    std::vector<std::vector<module*>> result;
+    for(const auto& level : levels)
+    {
+        std::vector<module_group> groups;
+        for(auto* mod : level)
+        {
+            auto footprint = get_footprint(mod);
+            auto it        = groups.end();
+            // A module that uses instructions from other modules runs on its own
+            if(footprint.closed)
+            {
+                it = std::find_if(groups.begin(), groups.end(), [&](const auto& g) {
+                    return g.closed and std::none_of(footprint.modules.begin(),
+                                                     footprint.modules.end(),
+                                                     [&](auto* m) { return contains(g.used, m); });
+                });
+            }
+            if(it == groups.end())
+            {
+                groups.push_back({{mod}, footprint.modules, footprint.closed});
+            }
+            else
+            {
+                it->modules.push_back(mod);
+                it->used.insert(footprint.modules.begin(), footprint.modules.end());
+            }
+        }
+        std::transform(groups.begin(),
+                       groups.end(),
+                       std::back_inserter(result),
+                       [](const auto& g) { return g.modules; });
+    }
+    return result;
+}
+
+static void run_pass_parallel(program& prog, const pass& p, pass_statistics* stats)
+{
+    // Visit the modules in the same order as when the pass runs on one module at a time
+    auto mods = prog.get_modules();
+    std::reverse(mods.begin(), mods.end());
+    for(const auto& group : group_modules(mods))
+    {
+        std::vector<pass_statistics> group_stats(group.size());
+        par_for_rethrow(group.size(), 1, [&](auto i) {
+            run_pass(*group[i], p, tracer{}, stats == nullptr ? nullptr : &group_stats[i]);
+        });
+        if(stats == nullptr)
+            continue;
+        for(const auto& gs : group_stats)
+        {
+            for(const auto& s : gs.get_stats())
+                stats->add(s);
+        }
+    }
+    run_pass(prog, p, tracer{}, stats);
+}
+
+void run_passes(program& prog,
+                const std::vector<pass>& passes,
+                tracer trace,
+                pass_statistics* stats,
+                bool parallel)
 {
     for(const auto& p : passes)
     {
+        if(parallel and not trace.enabled())
+        {
+            run_pass_parallel(prog, p, stats);
+            continue;
+        }
         auto mods = prog.get_modules();
         for(const auto& mod : reverse(mods))
         {
-            run_pass(*mod, p, trace);
+            run_pass(*mod, p, trace, stats);
         }
-        run_pass(prog, p, trace);
+        run_pass(prog, p, trace, stats);
     }
 }
 
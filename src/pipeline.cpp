@@ -0,0 +1,383 @@
+#include <migraphx/pipeline.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/iterator_for.hpp>
+#include <migraphx/builtin.hpp>
+#include <migraphx/par_for.hpp>
+#include <migraphx/ranges.hpp>
+#include <migraphx/errors.hpp>
+#include <migraphx/time.hpp>
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <numeric>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+std::size_t default_pipeline_weight(instruction_ref ins)
+{
+    const auto& op = ins->get_operator();
+    if(op.name().front() == '@')
+        return 0;
+    std::vector<shape> shapes;
+    std::transform(ins->inputs().begin(),
+                   ins->inputs().end(),
+                   std::back_inserter(shapes),
+                   [](auto i) { return i->get_shape(); });
+    if(op.output_alias(shapes) >= 0)
+        return 0;
+    std::size_t scale = 1;
+    if(contains({"convolution", "quant_convolution", "deconvolution"}, op.name()))
+        scale = 8;
+    else if(contains({"dot", "quant_dot", "pooling"}, op.name()))
+        scale = 4;
+    return scale * ins->get_shape().elements();
+}
+
+double pipeline_stage_stats::latency_ms() const { return runs == 0 ? 0 : busy_ms / runs; }
+
+double pipeline_stage_stats::utilization() const
+{
+    auto total = busy_ms + wait_input_ms + wait_output_ms;
+    return total == 0 ? 0 : busy_ms / total;
+}
+
+static std::vector<instruction_ref> get_outputs(const module& m)
+{
+    auto last = std::prev(m.end());
+    if(last->name() == "@return")
+        return last->inputs();
+    return {last};
+}
+
+static std::vector<std::size_t> assign_stages(const std::vector<instruction_ref>& instructions,
+                                              std::size_t n,
+                                              const pipeline_weight& weight)
+{
+    std::vector<std::size_t> weights;
+    std::transform(
+        instructions.begin(), instructions.end(), std::back_inserter(weights), weight);
+    auto total = std::accumulate(weights.begin(), weights.end(), std::size_t{0});
+    std::vector<std::size_t> result;
+    std::size_t stage    = 0;
+    std::size_t w        = 0;
+    std::size_t in_stage = 0;
+    for(std::size_t i = 0; i < instructions.size(); i++)
+    {
+        auto remaining = instructions.size() - i;
+        if(stage + 1 < n and in_stage > 0 and
+           (w * n >= (stage + 1) * total or remaining < n - stage))
+        {
+            stage++;
+            in_stage = 0;
+        }
+        result.push_back(stage);
+        w += weights[i];
+        in_stage++;
+    }
+    return result;
+}
+
+static std::vector<pipeline_stage> split_stages(const program& p,
+                                                std::size_t n,
+                                                const pipeline_weight& weight,
+                                                std::vector<std::string>& output_names)
+{
+    if(not p.get_state_names().empty())
+        MIGRAPHX_THROW("PIPELINE: Programs with states can't be pipelined");
+    const auto* mm = p.get_main_module();
+    std::unordered_map<instruction_ref, std::size_t> index;
+    std::vector<instruction_ref> instructions;
+    for(auto ins : iterator_for(*mm))
+    {
+        index.emplace(ins, index.size());
+        if(not ins->module_inputs().empty())
+            MIGRAPHX_THROW("PIPELINE: Instructions with submodules can't be pipelined");
+        if(contains({"@literal", "@param", "@return"}, ins->name()))
+            continue;
+        instructions.push_back(ins);
+    }
+    if(instructions.empty())
+        MIGRAPHX_THROW("PIPELINE: The program has nothing to run");
+    n = std::min(n, instructions.size());
+
+    auto stage_ids = assign_stages(instructions, n, weight);
+    std::unordered_map<instruction_ref, std::size_t> stage_of;
+    for(std::size_t i = 0; i < instructions.size(); i++)
+        stage_of[instructions[i]] = stage_ids[i];
+
+    auto value_name = [&](instruction_ref ins) {
+        if(ins->name() == "@param")
+            return any_cast<builtin::param>(ins->get_operator()).parameter;
+        return "pipeline:" + std::to_string(index.at(ins));
+    };
+    auto outputs = get_outputs(*mm);
+    std::transform(
+        outputs.begin(), outputs.end(), std::back_inserter(output_names), value_name);
+
+    std::vector<pipeline_stage> stages(n);
+    std::size_t i = 0;
+    for(std::size_t s = 0; s < n; s++)
+    {
+        auto& stage = stages[s];
+        auto* m     = stage.prog.get_main_module();
+        std::unordered_map<instruction_ref, instruction_ref> map_ins;
+        auto get_input = [&](instruction_ref x) {
+            if(contains(map_ins, x))
+                return map_ins.at(x);
+            if(x->name() == "@literal")
+                map_ins[x] = m->add_literal(x->get_literal());
+            else
+                map_ins[x] = m->add_parameter(value_name(x), x->get_shape());
+            return map_ins.at(x);
+        };
+        std::vector<instruction_ref> returns;
+        std::unordered_set<instruction_ref> returned;
+        auto add_output = [&](instruction_ref x) {
+            if(returned.insert(x).second)
+            {
+                returns.push_back(get_input(x));
+                stage.outputs.push_back(value_name(x));
+            }
+        };
+        std::vector<instruction_ref> stage_instructions;
+        for(; i < instructions.size() and stage_ids[i] == s; i++)
+        {
+            auto ins = instructions[i];
+            std::vector<instruction_ref> args;
+            std::transform(ins->inputs().begin(),
+                           ins->inputs().end(),
+                           std::back_inserter(args),
+                           get_input);
+            map_ins[ins] = m->add_instruction(ins->get_operator(), args);
+            stage_instructions.push_back(ins);
+            stage.stats.instructions++;
+            stage.stats.weight += weight(ins);
+        }
+        // Return what the later stages use and the outputs of the program
+        for(auto ins : stage_instructions)
+        {
+            if(contains(outputs, ins) or std::any_of(ins->outputs().begin(),
+                                                     ins->outputs().end(),
+                                                     [&](auto out) {
+                                                         return contains(stage_of, out) and
+                                                                stage_of.at(out) > s;
+                                                     }))
+                add_output(ins);
+        }
+        if(s == n - 1)
+        {
+            for(auto ins : outputs)
+            {
+                if(ins->name() == "@literal")
+                    add_output(ins);
+            }
+        }
+        m->add_return(returns);
+    }
+    return stages;
+}
+
+pipeline::pipeline(const program& p,
+                   const std::vector<target>& targets,
+                   const compile_options& options,
+                   const pipeline_weight& weight)
+{
+    if(targets.empty())
+        MIGRAPHX_THROW("PIPELINE: No targets to run the stages on");
+    stages = split_stages(
+        p, targets.size(), weight ? weight : pipeline_weight{&default_pipeline_weight}, outputs);
+    for(std::size_t s = 0; s < stages.size(); s++)
+        stages[s].prog.compile(targets[s], options);
+}
+
+std::size_t pipeline::size() const { return stages.size(); }
+
+const program& pipeline::get_stage(std::size_t i) const { return stages.at(i).prog; }
+
+namespace {
+
+template <class T>
+struct bounded_queue
+{
+    std::size_t capacity = 1;
+    std::deque<T> items;
+    bool closed = false;
+    std::mutex m;
+    std::condition_variable not_empty;
+    std::condition_variable not_full;
+
+    bool push(T x)
+    {
+        std::unique_lock<std::mutex> lock(m);
+        not_full.wait(lock, [&] { return closed or items.size() < capacity; });
+        if(closed)
+            return false;
+        items.push_back(std::move(x));
+        not_empty.notify_one();
+        return true;
+    }
+
+    // Returns false once the queue is closed and empty
+    bool pop(T& x)
+    {
+        std::unique_lock<std::mutex> lock(m);
+        not_empty.wait(lock, [&] { return closed or not items.empty(); });
+        if(items.empty())
+            return false;
+        x = std::move(items.front());
+        items.pop_front();
+        not_full.notify_one();
+        return true;
+    }
+
+    void close(bool discard = false)
+    {
+        std::lock_guard<std::mutex> lock(m);
+        closed = true;
+        if(discard)
+            items.clear();
+        not_empty.notify_all();
+        not_full.notify_all();
+    }
+};
+
+} // namespace
+
+std::size_t pipeline::run(const reader& read, const writer& write, std::size_t queue_size)
+{
+    using milliseconds = std::chrono::duration<double, std::milli>;
+    if(stages.empty())
+        MIGRAPHX_THROW("PIPELINE: No stages to run");
+    // Queue s holds the micro-batches waiting for stage s, and the last one the finished ones
+    std::vector<bounded_queue<parameter_map>> queues(stages.size() + 1);
+    for(auto& q : queues)
+        q.capacity = std::max<std::size_t>(queue_size, 1);
+
+    std::mutex error_mutex;
+    std::exception_ptr error;
+    auto abort = [&] {
+        {
+            std::lock_guard<std::mutex> lock(error_mutex);
+            if(error == nullptr)
+                error = std::current_exception();
+        }
+        for(auto& q : queues)
+            q.close(true);
+    };
+
+    std::size_t count = 0;
+    {
+        std::vector<joinable_thread> threads;
+        threads.emplace_back([&] {
+            try
+            {
+                for(;;)
+                {
+                    parameter_map params;
+                    if(not read(params) or not queues.front().push(std::move(params)))
+                        break;
+                }
+                queues.front().close();
+            }
+            catch(...)
+            {
+                abort();
+            }
+        });
+        for(std::size_t s = 0; s < stages.size(); s++)
+        {
+            threads.emplace_back([&, s] {
+                auto& stage = stages[s];
+                auto names  = stage.prog.get_parameter_names();
+                try
+                {
+                    for(;;)
+                    {
+                        parameter_map values;
+                        bool more = false;
+                        stage.stats.wait_input_ms +=
+                            time<milliseconds>([&] { more = queues[s].pop(values); });
+                        if(not more)
+                            break;
+                        stage.stats.busy_ms += time<milliseconds>([&] {
+                            parameter_map params;
+                            for(const auto& name : names)
+                            {
+                                if(not contains(values, name))
+                                    MIGRAPHX_THROW("PIPELINE: Parameter not found: " + name);
+                                params[name] = values.at(name);
+                            }
+                            auto results = stage.prog.eval(params);
+                            for(std::size_t i = 0; i < results.size(); i++)
+                                values[stage.outputs[i]] = results[i].copy();
+                        });
+                        stage.stats.runs++;
+                        stage.stats.wait_output_ms += time<milliseconds>(
+                            [&] { more = queues[s + 1].push(std::move(values)); });
+                        if(not more)
+                            break;
+                    }
+                    queues[s + 1].close();
+                }
+                catch(...)
+                {
+                    abort();
+                }
+            });
+        }
+        try
+        {
+            parameter_map values;
+            while(queues.back().pop(values))
+            {
+                std::vector<argument> results;
+                std::transform(outputs.begin(),
+                               outputs.end(),
+                               std::back_inserter(results),
+                               [&](const auto& name) { return values.at(name); });
+                write(results);
+                count++;
+            }
+        }
+        catch(...)
+        {
+            abort();
+        }
+    }
+    if(error != nullptr)
+        std::rethrow_exception(error);
+    return count;
+}
+
+std::vector<pipeline_stage_stats> pipeline::get_stats() const
+{
+    std::vector<pipeline_stage_stats> result;
+    std::transform(stages.begin(), stages.end(), std::back_inserter(result), [](const auto& s) {
+        return s.stats;
+    });
+    return result;
+}
+
+void pipeline::print_stats(std::ostream& os) const
+{
+    os << std::fixed << std::setprecision(3);
+    for(std::size_t s = 0; s < stages.size(); s++)
+    {
+        const auto& stats = stages[s].stats;
+        os << "Stage " << s << ": " << stats.instructions << " instructions, weight "
+           << stats.weight << ", " << stats.runs << " runs, " << stats.latency_ms()
+           << "ms per run, " << stats.utilization() * 100 << "% busy, waited "
+           << stats.wait_input_ms << "ms for input and " << stats.wait_output_ms
+           << "ms for output" << std::endl;
+    }
+}
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
@@ -34,6 +34,7 @@ struct program_impl
     std::unordered_map<std::string, module> modules;
     context ctx;
     std::string target_name;
+    std::map<std::string, argument> states;
 };
 
 program::program() : impl(std::make_unique<program_impl>()) { this->create_module("main"); }
@@ -66,6 +67,11 @@ void program::assign(const program& p)
     impl->target_name = p.impl->target_name;
     impl->modules     = p.impl->modules;
 
+    // A copy has its own states
+    impl->states.clear();
+    for(auto&& state : p.impl->states)
+        impl->states.emplace(state.first, state.second.copy());
+
     // build a map from old ins to new ins
     // Build a map from old module to new module
     std::unordered_map<module_ref, module_ref> mod_map;
@@ -119,6 +125,59 @@ std::unordered_map<std::string, shape> program::get_parameter_shapes() const
     return mm->get_parameter_shapes();
 }
 
+static argument make_state(const shape& s)
+{
+    argument result{s};
+    std::fill(result.data(), result.data() + s.bytes(), 0);
+    return result;
+}
+
+void program::add_state(const std::string& name)
+{
+    auto s = this->get_parameter_shape(name);
+    if(s == shape{})
+        MIGRAPHX_THROW("Parameter not found for state: " + name);
+    impl->states[name] = make_state(s);
+}
+
+std::vector<std::string> program::get_state_names() const
+{
+    std::vector<std::string> result;
+    std::transform(impl->states.begin(),
+                   impl->states.end(),
+                   std::back_inserter(result),
+                   [](auto&& state) { return state.first; });
+    return result;
+}
+
+argument program::get_state(const std::string& name) const
+{
+    auto it = impl->states.find(name);
+    if(it == impl->states.end())
+        MIGRAPHX_THROW("State not found: " + name);
+    return it->second;
+}
+
+void program::set_state(const std::string& name, const argument& a)
+{
+    auto state = this->get_state(name);
+    if(a.get_shape() != state.get_shape())
+        MIGRAPHX_THROW("Incorrect shape {" + to_string(a.get_shape()) + "} for state: " + name);
+    std::copy(a.data(), a.data() + a.get_shape().bytes(), state.data());
+}
+
+void program::reset_state(const std::string& name)
+{
+    auto state = this->get_state(name);
+    std::fill(state.data(), state.data() + state.get_shape().bytes(), 0);
+}
+
+void program::reset_states()
+{
+    for(auto&& state : impl->states)
+        this->reset_state(state.first);
+}
+
 std::size_t program::size() const { return impl->modules.size(); }
 
 std::vector<shape> program::get_output_shapes() const
@@ -137,6 +196,15 @@ instruction_ref program::validate() const
 
 bool program::is_compiled() const { return not this->impl->target_name.empty(); }
 
+// A target can give an empty context when its ops don't use one
+static bool has_context(const context& ctx) { return ctx.type_id() != typeid(std::nullptr_t); }
+
+static bool parallel_compile(const context& ctx)
+{
+    return has_context(ctx) and ctx.parallel_compile() and
+           not enabled(MIGRAPHX_DISABLE_PARALLEL_COMPILE{});
+}
+
 void program::compile(const target& t, compile_options options)
 {
     assert(not this->is_compiled());
@@ -148,12 +216,20 @@ void program::compile(const target& t, compile_options options)
     options.trace(*this);
     options.trace();
 
+    pass_statistics stats;
+    auto* pass_stats = options.pass_stats;
+    if(pass_stats == nullptr and enabled(MIGRAPHX_TRACE_PASS_STATS{}))
+        pass_stats = &stats;
+
+    auto parallel = parallel_compile(this->impl->ctx);
     auto&& passes = t.get_passes(this->impl->ctx, options);
-    run_passes(*this, passes, options.trace);
+    run_passes(*this, passes, options.trace, pass_stats, parallel);
+    if(enabled(MIGRAPHX_TRACE_PASS_STATS{}))
+        pass_stats->print(std::cout);
 
     auto mods = this->get_modules();
 
-    // Validate and finalize
+    // Validate every module before finalizing any of them
     for(const auto& mod : reverse(mods))
     {
         auto invalid = mod->validate();
@@ -169,25 +245,24 @@ void program::compile(const target& t, compile_options options)
             MIGRAPHX_THROW("Dangling reference in module " + mod->name() + " from instruction " +
                            std::to_string(index));
         }
-        mod->finalize(this->impl->ctx);
     }
+    module::finalize(mods, this->impl->ctx, parallel);
 }
 
 void program::finalize()
 {
-    auto* mm = this->get_main_module();
-    mm->finalize(this->impl->ctx);
+    auto parallel = parallel_compile(this->impl->ctx);
+    module::finalize(this->get_modules(), this->impl->ctx, parallel);
 }
 
 template <class F>
 std::vector<argument> generic_eval(const module* mod,
                                    context& ctx,
-                                   std::unordered_map<std::string, argument> params,
-                                   std::unordered_map<instruction_ref, argument> results,
+                                   const std::unordered_map<std::string, argument>& params,
+                                   std::unordered_map<instruction_ref, argument>& results,
                                    F trace)
 {
     assert(mod->validate() == mod->end());
-    results.reserve(mod->size() * 2);
     std::vector<argument> values;
     values.reserve(16);
     for(auto ins : iterator_for(*mod))
@@ -202,9 +277,10 @@ std::vector<argument> generic_eval(const module* mod,
             results.emplace(
                 ins, trace(ins, [&] {
                     auto param_name = any_cast<builtin::param>(ins->get_operator()).parameter;
-                    if(not contains(params, param_name))
+                    auto it         = params.find(param_name);
+                    if(it == params.end())
                         MIGRAPHX_THROW("Parameter not found: " + param_name);
-                    auto param = params[param_name];
+                    const auto& param = it->second;
                     if(param.get_shape() != ins->get_shape())
                         MIGRAPHX_THROW("Incorrect shape {" + to_string(param.get_shape()) +
                                        "} for parameter: " + param_name);
@@ -238,9 +314,15 @@ std::vector<argument> generic_eval(const module* mod,
                 });
 
             const auto& mod_args = ins->module_inputs();
-            auto module_eval     = [&](module_ref smod,
+            // Submodules share the results of the enclosing module rather than
+            // copying them, and their own results are dropped once they return
+            // so that a module run several times always starts clean
+            auto module_eval = [&](module_ref smod,
                                    const std::unordered_map<std::string, argument>& inputs) {
-                return generic_eval(smod, ctx, inputs, results, trace);
+                auto outputs = generic_eval(smod, ctx, inputs, results, trace);
+                for(auto i : iterator_for(*smod))
+                    results.erase(i);
+                return outputs;
             };
 
             results.emplace(ins, trace(ins, [&] {
@@ -259,8 +341,27 @@ std::vector<argument> generic_eval(const program& p,
                                    std::unordered_map<std::string, argument> params,
                                    F trace)
 {
+    // States that are not given use the buffers kept by the program
+    for(const auto& name : p.get_state_names())
+        params.emplace(name, p.get_state(name));
     const module* mm = p.get_main_module();
-    return generic_eval(mm, ctx, params, {}, trace);
+    std::unordered_map<instruction_ref, argument> results;
+    results.reserve(mm->size() * 2);
+    if(not has_context(ctx))
+        return generic_eval(mm, ctx, params, results, trace);
+    ctx.begin_eval();
+    std::vector<argument> outputs;
+    try
+    {
+        outputs = generic_eval(mm, ctx, params, results, trace);
+    }
+    catch(...)
+    {
+        ctx.end_eval();
+        throw;
+    }
+    ctx.end_eval();
+    return outputs;
 }
 
 std::vector<argument> program::eval(parameter_map params) const
@@ -306,17 +407,23 @@ std::vector<argument> program::eval(parameter_map params) const
 
 const int program_file_version = 5;
 
-value program::to_value() const
+static value program_to_value(const program& p,
+                              const std::string& target_name,
+                              const context& ctx,
+                              std::vector<literal>* literals)
 {
     value result;
     result["version"] = program_file_version;
-    result["target"]  = this->impl->target_name;
-    if(not this->impl->target_name.empty())
-        result["context"] = this->impl->ctx.to_value();
+    result["target"]  = target_name;
+    if(not target_name.empty())
+        result["context"] = ctx.to_value();
+
+    if(not p.get_state_names().empty())
+        result["states"] = p.get_state_names();
 
     value module_vals = value::object{};
     std::unordered_map<instruction_ref, std::string> names;
-    for(auto& mod : this->get_modules())
+    for(auto& mod : p.get_modules())
     {
         value mod_val;
         value nodes;
@@ -329,8 +436,23 @@ value program::to_value() const
                 node["shape"]      = migraphx::to_value(ins->get_shape());
                 node["normalized"] = ins->is_normalized();
                 if(ins->name() == "@literal")
-                    node["literal"] = migraphx::to_value(ins->get_literal());
-                node["operator"] = ins->get_operator().to_value();
+                {
+                    if(literals == nullptr)
+                    {
+                        node["literal"] = migraphx::to_value(ins->get_literal());
+                    }
+                    else
+                    {
+                        node["literal"] = literals->size();
+                        literals->push_back(ins->get_literal());
+                    }
+                }
+                // Literals held by operators, like the weights of a compiled program, go to
+                // the table too
+                if(literals == nullptr)
+                    node["operator"] = ins->get_operator().to_value();
+                else
+                    node["operator"] = ins->get_operator().to_value(*literals);
                 std::vector<std::string> inputs;
                 std::transform(ins->inputs().begin(),
                                ins->inputs().end(),
@@ -364,10 +486,21 @@ value program::to_value() const
     return result;
 }
 
+value program::to_value() const
+{
+    return program_to_value(*this, this->impl->target_name, this->impl->ctx, nullptr);
+}
+
+value program::to_value(std::vector<literal>& literals) const
+{
+    return program_to_value(*this, this->impl->target_name, this->impl->ctx, &literals);
+}
+
 static void mod_from_val(module_ref mod,
                          const value& v,
                          std::unordered_map<std::string, instruction_ref>& instructions,
-                         const std::unordered_map<std::string, module_ref>& map_mods)
+                         const std::unordered_map<std::string, module_ref>& map_mods,
+                         const std::vector<literal>& literals)
 {
     const auto& module_val = v.at(mod->name());
     for(const value& node : module_val.at("nodes"))
@@ -384,11 +517,16 @@ static void mod_from_val(module_ref mod,
         }
         else if(name == "@literal")
         {
-            output = mod->add_literal(migraphx::from_value<literal>(node.at("literal")));
+            const auto& lit_val = node.at("literal");
+            if(not lit_val.is_object())
+                output = mod->add_literal(literals.at(lit_val.to<std::size_t>()));
+            else
+                output = mod->add_literal(migraphx::from_value<literal>(lit_val));
         }
         else
         {
-            auto op = make_op(name, fields);
+            auto op = make_op(name);
+            op.from_value(fields, literals);
             std::vector<instruction_ref> inputs;
             std::transform(node.at("inputs").begin(),
                            node.at("inputs").end(),
@@ -409,7 +547,7 @@ static void mod_from_val(module_ref mod,
 
                 for(auto& smod : module_inputs)
                 {
-                    mod_from_val(smod, v, instructions, map_mods);
+                    mod_from_val(smod, v, instructions, map_mods, literals);
                 }
             }
 
@@ -431,7 +569,9 @@ static void mod_from_val(module_ref mod,
     }
 }
 
-void program::from_value(const value& v)
+void program::from_value(const value& v) { this->from_value(v, {}); }
+
+void program::from_value(const value& v, const std::vector<literal>& literals)
 {
     auto version = v.at("version").to<int>();
     if(version != program_file_version)
@@ -463,7 +603,14 @@ void program::from_value(const value& v)
 
     std::unordered_map<std::string, instruction_ref> map_insts;
     auto* mm = get_main_module();
-    mod_from_val(mm, module_vals, map_insts, map_mods);
+    mod_from_val(mm, module_vals, map_insts, map_mods, literals);
+
+    this->impl->states.clear();
+    if(v.contains("states"))
+    {
+        for(const auto& name : v.at("states"))
+            this->add_state(name.to<std::string>());
+    }
 
     this->finalize();
 }
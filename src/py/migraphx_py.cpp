@@ -14,6 +14,11 @@
 #include <migraphx/register_target.hpp>
 #include <migraphx/json.hpp>
 #include <migraphx/make_op.hpp>
+#include <migraphx/ranges.hpp>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
 
 #ifdef HAVE_GPU
 #include <migraphx/gpu/hip.hpp>
@@ -117,6 +122,22 @@ struct npy_format_descriptor<half>
 } // namespace detail
 } // namespace pybind11
 
+// Holds a program in python along with the lock for its runs. Evaluating a program uses its
+// context and preallocated memory, so runs of the same program are serialized while different
+// programs can run concurrently. The lock lives as long as the program does.
+template <class T>
+struct program_holder
+{
+    std::shared_ptr<T> p;
+    std::shared_ptr<std::mutex> run_mutex = std::make_shared<std::mutex>();
+
+    program_holder() = default;
+    explicit program_holder(T* x) : p(x) {}
+
+    T* get() const { return p.get(); }
+};
+PYBIND11_DECLARE_HOLDER_TYPE(T, program_holder<T>);
+
 template <class F>
 void visit_type(const migraphx::shape& s, F f)
 {
@@ -208,6 +229,143 @@ migraphx::shape to_shape(const py::buffer_info& info)
     }
 }
 
+migraphx::argument to_argument(const py::buffer& b)
+{
+    py::buffer_info info = b.request();
+    return migraphx::argument(to_shape(info), info.ptr);
+}
+
+// Arguments bound once to the parameters of a program, so that it can be run repeatedly without
+// converting the buffers again. The buffers are kept alive while they are bound.
+struct parameters
+{
+    migraphx::parameter_map map;
+    std::unordered_map<std::string, py::object> buffers;
+
+    void set(const std::string& name, const py::buffer& b)
+    {
+        map[name]     = to_argument(b);
+        buffers[name] = b;
+    }
+};
+
+migraphx::parameter_map to_parameter_map(const py::dict& params)
+{
+    migraphx::parameter_map pm;
+    for(auto x : params)
+    {
+        std::string key = x.first.cast<std::string>();
+        pm[key]         = to_argument(x.second.cast<py::buffer>());
+    }
+    return pm;
+}
+
+std::vector<migraphx::argument> to_arguments(const py::list& buffers)
+{
+    std::vector<migraphx::argument> result;
+    for(auto x : buffers)
+        result.push_back(to_argument(x.cast<py::buffer>()));
+    return result;
+}
+
+// Binds the outputs to the output parameters of the program when it has them, so they are written
+// directly
+migraphx::parameter_map bind_outputs(const migraphx::program& p,
+                                     migraphx::parameter_map pm,
+                                     const std::vector<migraphx::argument>& outputs)
+{
+    auto param_shapes = p.get_parameter_shapes();
+    for(std::size_t i = 0; i < outputs.size(); i++)
+    {
+        auto name = "main:#output_" + std::to_string(i);
+        if(migraphx::contains(param_shapes, name))
+            pm[name] = outputs[i];
+    }
+    return pm;
+}
+
+// Runs the program, which does not need the GIL. The outputs are bound to the output parameters of
+// the program when it has them, or else the results are copied into them. The other results can
+// point into memory that the program reuses on its next run, so they are copied before another
+// run can start.
+std::vector<migraphx::argument> run_program(const program_holder<migraphx::program>& h,
+                                            const migraphx::parameter_map& params,
+                                            const std::vector<migraphx::argument>& outputs)
+{
+    const auto& p = *h.get();
+    std::lock_guard<std::mutex> lock(*h.run_mutex);
+    auto result = outputs.empty() ? p.eval(params) : p.eval(bind_outputs(p, params, outputs));
+    if(outputs.size() > result.size())
+        MIGRAPHX_THROW("MIGRAPHX PYTHON: Too many output buffers");
+    for(std::size_t i = 0; i < outputs.size(); i++)
+    {
+        if(result[i].data() == outputs[i].data())
+            continue;
+        if(result[i].get_shape().lens() != outputs[i].get_shape().lens() or
+           result[i].get_shape().type() != outputs[i].get_shape().type())
+            MIGRAPHX_THROW("MIGRAPHX PYTHON: Incorrect shape {" +
+                           migraphx::to_string(outputs[i].get_shape()) + "} for output " +
+                           std::to_string(i));
+        migraphx::visit_all(outputs[i], result[i])(
+            [](auto output, auto input) { std::copy(input.begin(), input.end(), output.begin()); });
+        result[i] = outputs[i];
+    }
+    std::transform(result.begin() + outputs.size(),
+                   result.end(),
+                   result.begin() + outputs.size(),
+                   [](const migraphx::argument& r) { return r.copy(); });
+    return result;
+}
+
+// The result of run_async. The buffers used by the run are kept alive until it finishes.
+struct run_future
+{
+    std::vector<py::object> keep_alive;
+    std::shared_future<std::vector<migraphx::argument>> result;
+
+    run_future()                  = default;
+    run_future(run_future&&)      = default;
+
+    ~run_future()
+    {
+        // Wait for the run before releasing the buffers, without blocking other python threads
+        if(result.valid())
+        {
+            py::gil_scoped_release nogil;
+            result.wait();
+        }
+    }
+
+    bool done() const
+    {
+        return result.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    }
+
+    std::vector<migraphx::argument> get() const
+    {
+        {
+            py::gil_scoped_release nogil;
+            result.wait();
+        }
+        return result.get();
+    }
+};
+
+// The parameters are copied, since they can be changed in python while the program runs
+run_future run_async(program_holder<migraphx::program> h,
+                     migraphx::parameter_map pm,
+                     std::vector<migraphx::argument> outputs,
+                     std::vector<py::object> keep_alive)
+{
+    auto run = [h = std::move(h), pm = std::move(pm), outputs = std::move(outputs)] {
+        return run_program(h, pm, outputs);
+    };
+    run_future f;
+    f.keep_alive = std::move(keep_alive);
+    f.result     = std::async(std::launch::async, std::move(run)).share();
+    return f;
+}
+
 MIGRAPHX_PYBIND11_MODULE(migraphx, m)
 {
     py::class_<migraphx::shape>(m, "shape")
@@ -253,44 +411,110 @@ MIGRAPHX_PYBIND11_MODULE(migraphx, m)
         .def("__ne__", std::not_equal_to<migraphx::module>{})
         .def("__repr__", [](const migraphx::module& mm) { return migraphx::to_string(mm); });
 
-    py::class_<migraphx::program>(m, "program")
+    py::class_<migraphx::program, program_holder<migraphx::program>>(m, "program")
         .def("get_parameter_names", &migraphx::program::get_parameter_names)
         .def("get_parameter_shapes", &migraphx::program::get_parameter_shapes)
         .def("get_output_shapes", &migraphx::program::get_output_shapes)
+        .def("add_state", &migraphx::program::add_state)
+        .def("get_state_names", &migraphx::program::get_state_names)
+        .def("get_state", &migraphx::program::get_state)
+        .def("set_state",
+             [](migraphx::program& p, const std::string& name, py::buffer b) {
+                 py::buffer_info info = b.request();
+                 p.set_state(name, migraphx::argument(to_shape(info), info.ptr));
+             })
+        .def("reset_state", &migraphx::program::reset_state)
+        .def("reset_states", &migraphx::program::reset_states)
         .def(
             "compile",
-            [](migraphx::program& p, const migraphx::target& t, bool offload_copy, bool fast_math) {
+            [](migraphx::program& p,
+               const migraphx::target& t,
+               bool offload_copy,
+               bool fast_math,
+               bool output_buffers) {
                 migraphx::compile_options options;
-                options.offload_copy = offload_copy;
-                options.fast_math    = fast_math;
+                options.offload_copy   = offload_copy;
+                options.fast_math      = fast_math;
+                options.output_buffers = output_buffers;
                 p.compile(t, options);
             },
             py::arg("t"),
-            py::arg("offload_copy") = true,
-            py::arg("fast_math")    = true)
+            py::arg("offload_copy")   = true,
+            py::arg("fast_math")      = true,
+            py::arg("output_buffers") = false)
         .def("get_main_module",
              [](migraphx::program& p) {
                  auto* mm = p.get_main_module();
                  return *mm;
              })
-        .def("run",
-             [](migraphx::program& p, py::dict params) {
-                 migraphx::parameter_map pm;
-                 for(auto x : params)
-                 {
-                     std::string key      = x.first.cast<std::string>();
-                     py::buffer b         = x.second.cast<py::buffer>();
-                     py::buffer_info info = b.request();
-                     pm[key]              = migraphx::argument(to_shape(info), info.ptr);
-                 }
-                 return p.eval(pm);
-             })
+        .def(
+            "run",
+            [](const program_holder<migraphx::program>& h,
+               const py::dict& params,
+               const py::list& outputs) {
+                auto pm   = to_parameter_map(params);
+                auto outs = to_arguments(outputs);
+                py::gil_scoped_release nogil;
+                return run_program(h, pm, outs);
+            },
+            py::arg("params"),
+            py::arg("outputs") = py::list{})
+        .def(
+            "run",
+            [](const program_holder<migraphx::program>& h,
+               const parameters& params,
+               const py::list& outputs) {
+                auto outs = to_arguments(outputs);
+                py::gil_scoped_release nogil;
+                return run_program(h, params.map, outs);
+            },
+            py::arg("params"),
+            py::arg("outputs") = py::list{})
+        .def(
+            "run_async",
+            [](const py::object& self, const py::dict& params, const py::list& outputs) {
+                return run_async(self.cast<program_holder<migraphx::program>>(),
+                                 to_parameter_map(params),
+                                 to_arguments(outputs),
+                                 {self, params, outputs});
+            },
+            py::arg("params"),
+            py::arg("outputs") = py::list{})
+        .def(
+            "run_async",
+            [](const py::object& self, const py::object& params, const py::list& outputs) {
+                return run_async(self.cast<program_holder<migraphx::program>>(),
+                                 params.cast<const parameters&>().map,
+                                 to_arguments(outputs),
+                                 {self, params, outputs});
+            },
+            py::arg("params"),
+            py::arg("outputs") = py::list{})
         .def("sort", &migraphx::program::sort)
         .def("print", [](const migraphx::program& p) { std::cout << p << std::endl; })
         .def("__eq__", std::equal_to<migraphx::program>{})
         .def("__ne__", std::not_equal_to<migraphx::program>{})
         .def("__repr__", [](const migraphx::program& p) { return migraphx::to_string(p); });
 
+    py::class_<parameters>(m, "parameters")
+        .def(py::init<>())
+        .def(py::init([](const py::dict& params) {
+            parameters result;
+            for(auto x : params)
+                result.set(x.first.cast<std::string>(), x.second.cast<py::buffer>());
+            return result;
+        }))
+        .def("__setitem__", &parameters::set)
+        .def("__contains__",
+             [](const parameters& params, const std::string& name) {
+                 return migraphx::contains(params.map, name);
+             })
+        .def("__len__", [](const parameters& params) { return params.map.size(); });
+
+    py::class_<run_future>(m, "run_future")
+        .def("done", &run_future::done)
+        .def("result", &run_future::get);
+
     py::class_<migraphx::operation>(m, "op")
         .def(py::init([](const std::string& name, py::kwargs kwargs) {
             migraphx::value v = migraphx::value::object{};
@@ -325,12 +549,14 @@ MIGRAPHX_PYBIND11_MODULE(migraphx, m)
              unsigned int default_dim_value,
              std::unordered_map<std::string, std::vector<std::size_t>> map_input_dims,
              bool skip_unknown_operators,
-             bool print_program_on_error) {
+             bool print_program_on_error,
+             int64_t max_loop_iterations) {
               migraphx::onnx_options options;
               options.default_dim_value      = default_dim_value;
               options.map_input_dims         = map_input_dims;
               options.skip_unknown_operators = skip_unknown_operators;
               options.print_program_on_error = print_program_on_error;
+              options.max_loop_iterations    = max_loop_iterations;
               return migraphx::parse_onnx(filename, options);
           },
           "Parse onnx file",
@@ -338,19 +564,22 @@ MIGRAPHX_PYBIND11_MODULE(migraphx, m)
           py::arg("default_dim_value") = 1,
           py::arg("map_input_dims") = std::unordered_map<std::string, std::vector<std::size_t>>(),
           py::arg("skip_unknown_operators") = false,
-          py::arg("print_program_on_error") = false);
+          py::arg("print_program_on_error") = false,
+          py::arg("max_loop_iterations") = 10);
 
     m.def("parse_onnx_buffer",
           [](const std::string& onnx_buffer,
              unsigned int default_dim_value,
              std::unordered_map<std::string, std::vector<std::size_t>> map_input_dims,
              bool skip_unknown_operators,
-             bool print_program_on_error) {
+             bool print_program_on_error,
+             int64_t max_loop_iterations) {
               migraphx::onnx_options options;
               options.default_dim_value      = default_dim_value;
               options.map_input_dims         = map_input_dims;
               options.skip_unknown_operators = skip_unknown_operators;
               options.print_program_on_error = print_program_on_error;
+              options.max_loop_iterations    = max_loop_iterations;
               return migraphx::parse_onnx_buffer(onnx_buffer, options);
           },
           "Parse onnx file",
@@ -358,7 +587,8 @@ MIGRAPHX_PYBIND11_MODULE(migraphx, m)
           py::arg("default_dim_value") = 1,
           py::arg("map_input_dims") = std::unordered_map<std::string, std::vector<std::size_t>>(),
           py::arg("skip_unknown_operators") = false,
-          py::arg("print_program_on_error") = false);
+          py::arg("print_program_on_error") = false,
+          py::arg("max_loop_iterations") = 10);
 
     m.def("load",
           [](const std::string& name, const std::string& format) {
@@ -2,6 +2,8 @@
 #include <migraphx/argument.hpp>
 #include <migraphx/literal.hpp>
 #include <migraphx/context.hpp>
+#include <migraphx/errors.hpp>
+#include <string>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
@@ -21,8 +23,18 @@ void raw_data_to_value(value& v, const RawData& rd)
 void migraphx_to_value(value& v, const literal& l) { raw_data_to_value(v, l); }
 void migraphx_from_value(const value& v, literal& l)
 {
+    // The reader expands literals held by operators in place
+    if(v.contains("@literal"))
+    {
+        const auto& x = v.at("@literal");
+        if(not x.is_object())
+            MIGRAPHX_THROW("Literal " + std::to_string(x.to<std::size_t>()) +
+                           " needs a literal table");
+        migraphx_from_value(x, l);
+        return;
+    }
     auto s = migraphx::from_value<shape>(v.at("shape"));
-    l      = literal(s, v.at("data").get_binary().data());
+    l      = literal(s, v.at("data").get_binary().data()).intern();
 }
 
 void migraphx_to_value(value& v, const argument& a) { raw_data_to_value(v, a); }
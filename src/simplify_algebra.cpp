@@ -461,7 +461,7 @@ struct find_splits
         {
             auto slc         = any_cast<op::slice>(split_front->get_operator());
             auto slc_axes    = slc.axes;
-            auto reduce_axes = start->get_operator().to_value()["axes"].to_vector<int64_t>();
+            auto reduce_axes = start->get_operator().get_field("axes").to_vector<int64_t>();
             // axes of slice and reduce op cannot have overlap
             if(std::any_of(slc_axes.begin(), slc_axes.end(), [&](auto axis) {
                    return (std::find(reduce_axes.begin(), reduce_axes.end(), axis) !=
@@ -742,11 +742,19 @@ struct find_conv_dot_horiz_fusion
     {
         auto ins = r.result;
 
-        auto pred = [](auto i, auto j) {
+        // Only fuse the ops that read the input with constant weights, so the concat of the
+        // weights is folded at compile time
+        auto fusable = [&](auto i) {
+            return i->inputs().front() == ins and i->inputs().at(1)->can_eval();
+        };
+
+        auto pred = [&](auto i, auto j) {
             if(i->get_operator() != j->get_operator())
                 return false;
             if(not contains({"dot", "convolution"}, i->name()))
                 return true;
+            if(fusable(i) != fusable(j))
+                return false;
             auto x = i->inputs()[1]->get_shape().lens();
             auto y = j->inputs()[1]->get_shape().lens();
             if(x.size() != y.size())
@@ -764,7 +772,7 @@ struct find_conv_dot_horiz_fusion
             if(std::distance(start, last) < 2)
                 return;
             auto&& name = (*start)->name();
-            if(not contains({"dot", "convolution"}, name))
+            if(not contains({"dot", "convolution"}, name) or not fusable(*start))
                 return;
             auto op   = (*start)->get_operator();
             int group = 1;
@@ -0,0 +1,158 @@
+#include <migraphx/sink_transpose.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/module.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/iterator_for.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/optional.hpp>
+#include <migraphx/permutation.hpp>
+#include <migraphx/ranges.hpp>
+#include <migraphx/stringutils.hpp>
+#include <migraphx/tune_axis.hpp>
+#include <migraphx/dead_code_elimination.hpp>
+#include <migraphx/env.hpp>
+#include <algorithm>
+#include <iostream>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_TRACE_SINK_TRANSPOSE)
+
+static std::vector<int64_t> get_dims(instruction_ref ins)
+{
+    return ins->get_operator().to_value()["dims"].to_vector<int64_t>();
+}
+
+static bool is_identity(const std::vector<int64_t>& dims)
+{
+    for(std::size_t i = 0; i < dims.size(); i++)
+    {
+        if(dims[i] != int64_t(i))
+            return false;
+    }
+    return true;
+}
+
+// Constants are folded and broadcasts are views, so these can be transposed back for free
+static bool is_free_to_transpose(instruction_ref ins)
+{
+    return ins->can_eval() or ins->get_shape().broadcasted();
+}
+
+// Map an axis of the transposed tensor to the axis of its input
+static int64_t map_axis(int64_t axis, const std::vector<int64_t>& dims)
+{
+    return dims[tune_axis(dims.size(), axis)];
+}
+
+// The operator to apply to the input of the transpose, so that transposing its result gives
+// the same result as applying ins to the transpose
+static optional<operation> untransposed_op(instruction_ref ins, const std::vector<int64_t>& dims)
+{
+    auto&& op = ins->get_operator();
+    if(op.attributes().contains("pointwise"))
+        return op;
+    auto v = op.to_value();
+    if(ins->name() == "slice" or starts_with(ins->name(), "reduce_"))
+    {
+        std::vector<int64_t> axes;
+        for(auto axis : v["axes"].to_vector<int64_t>())
+            axes.push_back(map_axis(axis, dims));
+        v["axes"] = axes;
+        return make_op(ins->name(), v);
+    }
+    if(ins->name() == "concat")
+    {
+        v["axis"] = map_axis(v["axis"].to<int64_t>(), dims);
+        return make_op(ins->name(), v);
+    }
+    if(ins->name() == "multibroadcast")
+    {
+        auto lens = ins->get_shape().lens();
+        if(lens.size() != dims.size())
+            return nullopt;
+        v["output_lens"] = reorder_dims(lens, invert_permutation(dims));
+        return make_op(ins->name(), v);
+    }
+    return nullopt;
+}
+
+// Move the transpose after its only output. Returns false if it can't be moved any further.
+static bool sink(module& m, instruction_ref ins)
+{
+    if(ins->outputs().size() != 1 or is_free_to_transpose(ins->inputs().front()))
+        return false;
+    auto output = ins->outputs().front();
+    auto dims   = get_dims(ins);
+    // The ops after a contiguous can expect a standard input, so it is only moved past when
+    // another transpose follows, and dropped along with the pair
+    if(output->name() == "contiguous")
+    {
+        if(output->outputs().size() != 1 or output->outputs().front()->name() != "transpose")
+            return false;
+        output = output->outputs().front();
+    }
+    if(output->name() == "transpose")
+    {
+        auto composed = reorder_dims(dims, get_dims(output));
+        if(is_identity(composed))
+            m.replace_instruction(output, ins->inputs().front());
+        else
+            m.replace_instruction(
+                output, make_op("transpose", {{"dims", composed}}), ins->inputs().front());
+        return true;
+    }
+    auto op = untransposed_op(output, dims);
+    if(not op)
+        return false;
+    auto inputs = output->inputs();
+    if(not std::all_of(inputs.begin(), inputs.end(), [&](auto input) {
+           return (input->name() == "transpose" and get_dims(input) == dims) or
+                  is_free_to_transpose(input);
+       }))
+        return false;
+    auto idims = invert_permutation(dims);
+    std::transform(inputs.begin(), inputs.end(), inputs.begin(), [&](auto input) {
+        if(input->name() == "transpose" and get_dims(input) == dims)
+            return input->inputs().front();
+        return m.insert_instruction(output, make_op("transpose", {{"dims", idims}}), input);
+    });
+    auto x = m.insert_instruction(output, *op, inputs);
+    m.replace_instruction(output, make_op("transpose", {{"dims", dims}}), x);
+    return true;
+}
+
+// Transposes of constants are not counted, since they are folded
+static std::size_t count_transposes(const module& m)
+{
+    return std::count_if(m.begin(), m.end(), [](const instruction& ins) {
+        return ins.name() == "transpose" and not ins.can_eval();
+    });
+}
+
+void sink_transpose::apply(module& m) const
+{
+    auto before  = count_transposes(m);
+    bool changed = true;
+    while(changed)
+    {
+        changed = false;
+        for(auto ins : iterator_for(m))
+        {
+            if(ins->name() != "transpose")
+                continue;
+            changed |= sink(m, ins);
+        }
+        dead_code_elimination{}.apply(m);
+    }
+    if(enabled(MIGRAPHX_TRACE_COMPILE{}) or enabled(MIGRAPHX_TRACE_SINK_TRANSPOSE{}))
+    {
+        auto after = count_transposes(m);
+        std::cout << "sink_transpose: eliminated " << (before > after ? before - after : 0)
+                  << " of " << before << " transposes" << std::endl;
+    }
+}
+
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
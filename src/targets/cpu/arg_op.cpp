@@ -0,0 +1,51 @@
+#include <migraphx/config.hpp>
+#include <migraphx/context.hpp>
+#include <migraphx/check_shapes.hpp>
+#include <migraphx/cpu/context.hpp>
+#include <migraphx/register_op.hpp>
+#include <migraphx/op/argmax.hpp>
+#include <migraphx/op/argmin.hpp>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace cpu {
+
+template <class Op>
+struct cpu_arg_op : auto_register_op<cpu_arg_op<Op>>
+{
+    Op op;
+
+    template <class Self, class F>
+    static auto reflect(Self& self, F f)
+    {
+        return migraphx::reflect(self.op, f);
+    }
+
+    std::string name() const { return "cpu::" + op.name(); }
+
+    shape compute_shape(const std::vector<shape>& inputs) const
+    {
+        check_shapes{inputs, *this}.has(1);
+        return op.normalize_compute_shape(inputs);
+    }
+
+    argument
+    // cppcheck-suppress constParameter
+    compute(context& ctx, const shape& output_shape, const std::vector<argument>& args) const
+    {
+        // A long axis with few outputs is split across the threads of the context
+        return op.reduce(output_shape,
+                         args.front(),
+                         ctx.bulk_threads(),
+                         [&](std::size_t n, std::size_t min_grain, auto f) {
+                             ctx.bulk_execute(n, min_grain, f);
+                         });
+    }
+};
+
+template struct cpu_arg_op<op::argmax>;
+template struct cpu_arg_op<op::argmin>;
+
+} // namespace cpu
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
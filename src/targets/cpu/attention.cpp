@@ -0,0 +1,218 @@
+#include <migraphx/config.hpp>
+#include <migraphx/context.hpp>
+#include <migraphx/cpu/context.hpp>
+#include <migraphx/check_shapes.hpp>
+#include <migraphx/argument.hpp>
+#include <migraphx/register_op.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace cpu {
+
+// Rows of queries processed together, so that each block of keys and values
+// is read once for all of them
+constexpr std::size_t attention_rows = 16;
+// Keys whose scores are computed at once
+constexpr std::size_t attention_cols = 64;
+
+/**
+ * @brief Computes softmax(scale * q * kt + mask) * v for the last two dimensions
+ *
+ * The inputs are q [..., m, d], kt [..., d, n], v [..., n, dv] and, optionally, a mask with the
+ * shape of the scores [..., m, n]. Each block of rows goes over the keys in blocks, keeping a
+ * running max and sum of the softmax and rescaling its output whenever the max grows. Only the
+ * scores of one block of rows and one block of keys are stored, so the [..., m, n] scores are
+ * never written to memory.
+ */
+struct cpu_attention : auto_register_op<cpu_attention>
+{
+    float scale = 1.0;
+
+    template <class Self, class F>
+    static auto reflect(Self& self, F f)
+    {
+        return pack(f(self.scale, "scale"));
+    }
+
+    std::string name() const { return "cpu::attention"; }
+
+    shape compute_shape(std::vector<shape> inputs) const
+    {
+        // Compensate for allocation
+        inputs.pop_back();
+        check_shapes{inputs, *this}.has(3, 4).same_type().same_ndims();
+        const auto& q_lens  = inputs[0].lens();
+        const auto& kt_lens = inputs[1].lens();
+        const auto& v_lens  = inputs[2].lens();
+        auto rank           = q_lens.size();
+        if(rank < 2)
+            MIGRAPHX_THROW("ATTENTION: inputs should have at least 2 dimensions");
+        if(not std::equal(q_lens.begin(), q_lens.end() - 2, kt_lens.begin()) or
+           not std::equal(q_lens.begin(), q_lens.end() - 2, v_lens.begin()))
+            MIGRAPHX_THROW("ATTENTION: batch dimensions should match");
+        if(q_lens[rank - 1] != kt_lens[rank - 2] or kt_lens[rank - 1] != v_lens[rank - 2])
+            MIGRAPHX_THROW("ATTENTION: inner dimensions should match");
+        auto score_lens      = q_lens;
+        score_lens[rank - 1] = kt_lens[rank - 1];
+        if(inputs.size() == 4 and inputs[3].lens() != score_lens)
+            MIGRAPHX_THROW("ATTENTION: mask should have the shape of the scores");
+        auto lens      = q_lens;
+        lens[rank - 1] = v_lens[rank - 1];
+        return {inputs[0].type(), lens};
+    }
+
+    // A matrix given by the last two dimensions of a batch of an argument
+    template <class T>
+    struct matrix
+    {
+        const T* data;
+        std::size_t row_stride;
+        std::size_t col_stride;
+
+        float operator()(std::size_t i, std::size_t j) const
+        {
+            return static_cast<float>(data[i * row_stride + j * col_stride]);
+        }
+    };
+
+    template <class T>
+    static matrix<T> get_matrix(const T* data, const shape& s, std::size_t b)
+    {
+        auto rank          = s.lens().size();
+        std::size_t offset = 0;
+        for(std::size_t i = rank - 2; i > 0; i--)
+        {
+            offset += (b % s.lens()[i - 1]) * s.strides()[i - 1];
+            b /= s.lens()[i - 1];
+        }
+        return {data + offset, s.strides()[rank - 2], s.strides()[rank - 1]};
+    }
+
+    template <class T>
+    void compute_rows(std::size_t i0,
+                      std::size_t rows,
+                      matrix<T> q,
+                      matrix<T> kt,
+                      matrix<T> v,
+                      const matrix<T>* mask,
+                      std::size_t d,
+                      std::size_t n,
+                      std::size_t dv,
+                      T* output) const
+    {
+        const float lowest = -std::numeric_limits<float>::infinity();
+        std::array<float, attention_rows * attention_cols> scores;
+        std::array<float, attention_rows> row_max;
+        std::array<float, attention_rows> row_sum;
+        std::vector<float> acc(rows * dv, 0.0f);
+        row_max.fill(lowest);
+        row_sum.fill(0.0f);
+        for(std::size_t j0 = 0; j0 < n; j0 += attention_cols)
+        {
+            auto cols = std::min(attention_cols, n - j0);
+            for(std::size_t r = 0; r < rows; r++)
+            {
+                float* s = scores.data() + r * attention_cols;
+                std::fill(s, s + cols, 0.0f);
+                for(std::size_t k = 0; k < d; k++)
+                {
+                    float x = q(i0 + r, k);
+                    for(std::size_t j = 0; j < cols; j++)
+                        s[j] += x * kt(k, j0 + j);
+                }
+                for(std::size_t j = 0; j < cols; j++)
+                    s[j] *= scale;
+                if(mask != nullptr)
+                {
+                    for(std::size_t j = 0; j < cols; j++)
+                        s[j] += (*mask)(i0 + r, j0 + j);
+                }
+            }
+            for(std::size_t r = 0; r < rows; r++)
+            {
+                const float* s = scores.data() + r * attention_cols;
+                float* a       = acc.data() + r * dv;
+                float new_max  = std::max(row_max[r], *std::max_element(s, s + cols));
+                // Every score so far is masked out
+                if(new_max == lowest)
+                    continue;
+                // Rescale what was accumulated with the previous max
+                float correction = std::exp(row_max[r] - new_max);
+                row_sum[r] *= correction;
+                for(std::size_t t = 0; t < dv; t++)
+                    a[t] *= correction;
+                for(std::size_t j = 0; j < cols; j++)
+                {
+                    float p = std::exp(s[j] - new_max);
+                    row_sum[r] += p;
+                    for(std::size_t t = 0; t < dv; t++)
+                        a[t] += p * v(j0 + j, t);
+                }
+                row_max[r] = new_max;
+            }
+        }
+        for(std::size_t r = 0; r < rows; r++)
+        {
+            for(std::size_t t = 0; t < dv; t++)
+                output[r * dv + t] = static_cast<T>(acc[r * dv + t] / row_sum[r]);
+        }
+    }
+
+    argument
+    // cppcheck-suppress constParameter
+    compute(context& ctx, const shape& output_shape, const std::vector<argument>& args) const
+    {
+        bool has_mask   = args.size() == 5;
+        const auto& out = output_shape.lens();
+        auto rank       = out.size();
+        std::size_t m   = out[rank - 2];
+        std::size_t dv  = out[rank - 1];
+        std::size_t d   = args[0].get_shape().lens()[rank - 1];
+        std::size_t n   = args[1].get_shape().lens()[rank - 1];
+
+        std::size_t batches    = output_shape.elements() / (m * dv);
+        std::size_t row_blocks = (m + attention_rows - 1) / attention_rows;
+        visit_all(args.back(), args[0], args[1], args[2])(
+            [&](auto output, auto q, auto kt, auto v) {
+                using type       = typename decltype(output)::value_type;
+                const type* mask = has_mask ? args[3].cast<type>() : nullptr;
+                ctx.bulk_execute(batches * row_blocks, 1, [&](auto start, auto end) {
+                    for(auto task = start; task < end; task++)
+                    {
+                        auto b    = task / row_blocks;
+                        auto i0   = (task % row_blocks) * attention_rows;
+                        auto rows = std::min(attention_rows, m - i0);
+                        auto mask_b =
+                            has_mask ? get_matrix(mask, args[3].get_shape(), b) : matrix<type>{};
+                        this->compute_rows(i0,
+                                           rows,
+                                           get_matrix(q.data(), args[0].get_shape(), b),
+                                           get_matrix(kt.data(), args[1].get_shape(), b),
+                                           get_matrix(v.data(), args[2].get_shape(), b),
+                                           has_mask ? &mask_b : nullptr,
+                                           d,
+                                           n,
+                                           dv,
+                                           output.data() + (b * m + i0) * dv);
+                    }
+                });
+            });
+
+        return args.back();
+    }
+
+    std::ptrdiff_t output_alias(const std::vector<shape>& shapes) const
+    {
+        return shapes.size() - 1;
+    }
+};
+
+} // namespace cpu
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
@@ -1,4 +1,5 @@
 #include <migraphx/cpu/dnnl.hpp>
+#include <migraphx/cpu/context.hpp>
 
 #if defined(__GNUC__) && __GNUC__ <= 5
 namespace std {
@@ -27,6 +28,13 @@ dnnl_context& get_dnnl_context()
     return ctx;
 }
 
+void limit_dnnl_threads(migraphx::context& ctx)
+{
+    auto* cpu_ctx = ctx.any_cast<context>();
+    if(cpu_ctx != nullptr)
+        cpu_ctx->limit_threads();
+}
+
 #ifdef __clang__
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Wswitch-enum"
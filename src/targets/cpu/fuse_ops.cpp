@@ -16,32 +16,13 @@ MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_DISABLE_DNNL_POST_OPS_WORKAROUND);
 
 MIGRAPHX_PRED_MATCHER(has_post_ops, instruction_ref ins)
 {
-    auto v = ins->get_operator().to_value();
-    return v.contains("post_ops");
+    return ins->get_operator().has_field("post_ops");
 }
 
 MIGRAPHX_PRED_MATCHER(without_post_ops, instruction_ref ins)
 {
-    auto v = ins->get_operator().to_value();
-    return v.contains("post_ops") and v["post_ops"].empty();
-}
-
-bool workaround_dnnl_broken_post_ops(const operation& op, const operation& post_op)
-{
-    if(contains({"dnnl::dot", "dnnl::convolution"}, op.name()))
-        return true;
-    auto pv = post_op.to_value();
-    if(not pv.at("post_ops").empty())
-        return true;
-    auto v         = op.to_value();
-    auto last_op   = v.at("post_ops").empty() ? v : v.at("post_ops").back();
-    auto algo      = last_op.contains("algo") ? last_op.at("algo").to<std::string>() : op.name();
-    auto post_algo = pv["algo"].to<std::string>();
-    if(starts_with(algo, "eltwise") and starts_with(post_algo, "eltwise"))
-        return true;
-    if(algo == post_algo)
-        return true;
-    return false;
+    const auto& op = ins->get_operator();
+    return op.has_field("post_ops") and op.get_field("post_ops").empty();
 }
 
 operation merge_post_ops(const operation& op, const operation& post_op)
@@ -57,6 +38,44 @@ operation merge_post_ops(const operation& op, const operation& post_op)
     return make_op(op.name(), v);
 }
 
+// Convolution and dot take any number of adds, such as a bias and a residual, followed by at
+// most one activation
+bool is_conv_post_ops(const value& post_ops)
+{
+    bool activation = false;
+    for(const auto& po : post_ops)
+    {
+        auto algo = po.at("algo").to<std::string>();
+        if(activation)
+            return false;
+        if(starts_with(algo, "eltwise"))
+            activation = true;
+        else if(algo != "binary_add")
+            return false;
+    }
+    return true;
+}
+
+bool workaround_dnnl_broken_post_ops(const operation& op, const operation& post_op)
+{
+    if(contains({"dnnl::dot", "dnnl::convolution"}, op.name()))
+        return not is_conv_post_ops(merge_post_ops(op, post_op).get_field("post_ops"));
+    if(not post_op.get_field("post_ops").empty())
+        return true;
+    auto post_ops = op.get_field("post_ops");
+    auto algo     = op.name();
+    if(not post_ops.empty())
+        algo = post_ops.back().at("algo").to<std::string>();
+    else if(op.has_field("algo"))
+        algo = op.get_field("algo").to<std::string>();
+    auto post_algo = post_op.get_field("algo").to<std::string>();
+    if(starts_with(algo, "eltwise") and starts_with(post_algo, "eltwise"))
+        return true;
+    if(algo == post_algo)
+        return true;
+    return false;
+}
+
 struct find_post_ops
 {
     context* ctx = nullptr;
@@ -65,16 +84,18 @@ struct find_post_ops
         if(enabled(MIGRAPHX_DISABLE_DNNL_POST_OPS_WORKAROUND{}))
             return match::name("dnnl::eltwise",
                                "dnnl::binary")(match::arg(0)(has_post_ops(), match::used_once()));
-        else
-            return match::name("dnnl::eltwise")(
-                without_post_ops(),
-                match::arg(0)(match::name("dnnl::binary")(without_post_ops(), match::used_once())));
+        auto conv   = match::name("dnnl::convolution", "dnnl::dot")(match::used_once()).bind("x");
+        auto binary = match::name("dnnl::binary")(without_post_ops(), match::used_once());
+        return match::any_of(
+            match::name("dnnl::eltwise")(match::arg(0)(conv)),
+            match::name("dnnl::binary")(match::any_arg(0, 1)(conv)),
+            match::name("dnnl::eltwise")(without_post_ops(), match::arg(0)(binary)));
     }
 
     void apply(module& m, const match::matcher_result& r) const
     {
         auto ins   = r.result;
-        auto x_ins = ins->inputs().front();
+        auto x_ins = contains(r.instructions, "x") ? r.instructions.at("x") : ins->inputs().front();
         auto x     = x_ins->get_operator();
 
         if(workaround_dnnl_broken_post_ops(x, ins->get_operator()))
@@ -84,7 +105,11 @@ struct find_post_ops
         auto inputs   = x_ins->inputs();
         inputs.back() = ins->inputs().back();
         if(ins->name() == "dnnl::binary")
-            inputs.insert(std::prev(inputs.end()), ins->inputs().at(1));
+        {
+            // Adds can have the fused instruction on either side
+            auto y_ins = ins->inputs().at(0) == x_ins ? ins->inputs().at(1) : ins->inputs().at(0);
+            inputs.insert(std::prev(inputs.end()), y_ins);
+        }
         auto input_shapes = to_shapes(inputs);
         auto new_shape    = try_compute_shape(op, input_shapes);
         if(new_shape.empty() or new_shape.front() != ins->get_shape())
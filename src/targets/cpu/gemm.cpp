@@ -17,6 +17,19 @@ struct dnnl_gemm : dnnl_extend_op<dnnl_gemm, dnnl::matmul, op::dot>
 
     void required(const check_shapes& cs) const { cs.not_broadcasted(); }
 
+    // The output can be written in any packed layout given by the allocation
+    shape compute_shape(std::vector<shape> inputs) const
+    {
+        auto r            = dnnl_extend_op::compute_shape(inputs);
+        const auto& alloc = inputs.back();
+        if(alloc == r or alloc.lens() != r.lens() or not alloc.packed() or alloc.broadcasted())
+            return r;
+        inputs.pop_back();
+        // Call to get_primitive to make sure an algo is available for this layout
+        this->get_primitive(this->to_memory_desc(alloc, inputs));
+        return alloc;
+    }
+
     dnnl::matmul::desc get_desc(const std::unordered_map<int, dnnl::memory::desc>& m) const
     {
         return {m.at(DNNL_ARG_SRC), m.at(DNNL_ARG_WEIGHTS), m.at(DNNL_ARG_DST)};
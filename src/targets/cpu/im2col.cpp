@@ -0,0 +1,163 @@
+#include <migraphx/config.hpp>
+#include <migraphx/context.hpp>
+#include <migraphx/check_shapes.hpp>
+#include <migraphx/cpu/context.hpp>
+#include <migraphx/register_op.hpp>
+#include <migraphx/op/im2col.hpp>
+#include <algorithm>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace cpu {
+
+struct cpu_im2col : auto_register_op<cpu_im2col>
+{
+    op::im2col op;
+
+    template <class Self, class F>
+    static auto reflect(Self& self, F f)
+    {
+        return migraphx::reflect(self.op, f);
+    }
+
+    std::string name() const { return "cpu::im2col"; }
+    shape compute_shape(std::vector<shape> inputs) const
+    {
+        // Compensate for allocation
+        inputs.pop_back();
+        check_shapes(inputs, *this).has(2);
+        check_shapes({inputs.front()}, *this).standard();
+        return op.normalize_compute_shape(inputs);
+    }
+
+    argument
+    // cppcheck-suppress constParameter
+    compute(context& ctx, const shape& output_shape, const std::vector<argument>& args) const
+    {
+        const auto& input_shape    = args[0].get_shape();
+        const auto& weights_shape  = args[1].get_shape();
+        const std::size_t kdims    = op.kdims();
+        const std::size_t batch    = input_shape.lens()[0];
+        const std::size_t channels = weights_shape.lens()[1];
+
+        auto out_lens = op.output_spatial_lens(input_shape, weights_shape);
+        std::vector<std::size_t> in_lens(input_shape.lens().begin() + 2, input_shape.lens().end());
+        std::vector<std::size_t> in_strides(input_shape.strides().begin() + 2,
+                                            input_shape.strides().end());
+        std::vector<std::size_t> kernel_lens(weights_shape.lens().begin() + 2,
+                                             weights_shape.lens().end());
+
+        // The innermost kernel dimension is copied as one contiguous segment,
+        // the outer kernel positions are enumerated up front
+        const std::size_t kernel_w = kernel_lens.back();
+        std::vector<std::size_t> outer_lens(kernel_lens.begin(), kernel_lens.end() - 1);
+        outer_lens.insert(outer_lens.begin(), 1);
+        shape outer_shape{shape::float_type, outer_lens};
+        const std::size_t outer_size = outer_shape.elements();
+        std::vector<std::size_t> outer_idx(outer_size * kdims);
+        for(std::size_t q = 0; q < outer_size; q++)
+        {
+            auto* idx = outer_idx.data() + q * kdims;
+            outer_shape.multi_copy(q, idx, idx + kdims);
+        }
+
+        std::vector<std::size_t> pixel_lens(out_lens);
+        pixel_lens.insert(pixel_lens.begin(), batch);
+        shape pixel_shape{shape::float_type, pixel_lens};
+
+        const std::size_t rows       = output_shape.lens()[0];
+        const std::size_t row_len    = output_shape.lens()[1];
+        const std::size_t kernel_len = outer_size * kernel_w;
+        const std::size_t in_image   = input_shape.strides()[0];
+        const std::size_t in_plane   = input_shape.strides()[1];
+        const std::size_t min_grain  = std::max<std::size_t>(1, 16384 / row_len);
+
+        visit_all(args.back(), args[0])([&](auto col, auto input) {
+            using type           = typename decltype(col)::value_type;
+            const auto* in_ptr   = input.data();
+            auto* out_ptr        = col.data();
+            const auto last      = kdims - 1;
+            const auto& stride   = op.stride;
+            const auto& dilation = op.dilation;
+            const auto& padding  = op.padding;
+            ctx.bulk_execute(rows, min_grain, [&](auto start, auto end) {
+                std::vector<std::size_t> pixel(kdims + 1);
+                std::vector<std::ptrdiff_t> base(kdims);
+                // Input offset of each outer kernel position, or -1 when it
+                // falls into the padding
+                std::vector<std::ptrdiff_t> outer_offset(outer_size);
+                for(auto row = start; row < end; row++)
+                {
+                    pixel_shape.multi_copy(row, pixel.data(), pixel.data() + pixel.size());
+                    for(std::size_t d = 0; d < kdims; d++)
+                        base[d] = std::ptrdiff_t(pixel[d + 1] * stride[d]) -
+                                  std::ptrdiff_t(padding[d]);
+                    for(std::size_t q = 0; q < outer_size; q++)
+                    {
+                        std::ptrdiff_t offset = 0;
+                        for(std::size_t d = 0; d < last and offset >= 0; d++)
+                        {
+                            auto x = base[d] + std::ptrdiff_t(outer_idx[q * kdims + d + 1] *
+                                                              dilation[d]);
+                            if(x < 0 or x >= std::ptrdiff_t(in_lens[d]))
+                                offset = -1;
+                            else
+                                offset += x * std::ptrdiff_t(in_strides[d]);
+                        }
+                        outer_offset[q] = offset;
+                    }
+
+                    // Range of the innermost kernel dimension that lands inside the image
+                    const auto x0     = base[last];
+                    const auto dil    = std::ptrdiff_t(dilation[last]);
+                    const auto width  = std::ptrdiff_t(in_lens[last]);
+                    const auto kw     = std::ptrdiff_t(kernel_w);
+                    std::ptrdiff_t lo = x0 >= 0 ? 0 : (-x0 + dil - 1) / dil;
+                    std::ptrdiff_t hi = x0 >= width ? 0 : (width - 1 - x0) / dil + 1;
+                    lo                = std::min(lo, kw);
+                    hi                = std::max(lo, std::min(hi, kw));
+
+                    const auto* image = in_ptr + pixel[0] * in_image;
+                    auto* dst_row     = out_ptr + row * row_len;
+                    for(std::size_t c = 0; c < channels; c++)
+                    {
+                        const auto* plane = image + c * in_plane;
+                        auto* dst_c       = dst_row + c * kernel_len;
+                        for(std::size_t q = 0; q < outer_size; q++)
+                        {
+                            auto* dst = dst_c + q * kernel_w;
+                            if(outer_offset[q] < 0 or lo == hi)
+                            {
+                                std::fill(dst, dst + kernel_w, type(0));
+                                continue;
+                            }
+                            const auto* src = plane + (outer_offset[q] + x0 + lo * dil);
+                            std::fill(dst, dst + lo, type(0));
+                            if(dil == 1)
+                            {
+                                std::copy(src, src + (hi - lo), dst + lo);
+                            }
+                            else
+                            {
+                                for(std::ptrdiff_t k = 0; k < hi - lo; k++)
+                                    dst[lo + k] = src[k * dil];
+                            }
+                            std::fill(dst + hi, dst + kw, type(0));
+                        }
+                    }
+                }
+            });
+        });
+
+        return args.back();
+    }
+
+    std::ptrdiff_t output_alias(const std::vector<shape>& shapes) const
+    {
+        return shapes.size() - 1;
+    }
+};
+
+} // namespace cpu
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
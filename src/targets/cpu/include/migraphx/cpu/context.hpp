@@ -3,8 +3,12 @@
 
 #include <migraphx/config.hpp>
 #include <migraphx/cpu/dnnl.hpp>
+#include <migraphx/cpu/numa.hpp>
 #include <migraphx/cpu/parallel.hpp>
 #include <migraphx/par_for.hpp>
+#include <algorithm>
+#include <memory>
+#include <thread>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
@@ -12,12 +16,65 @@ namespace cpu {
 
 struct context
 {
+    // The NUMA node the memory is allocated on and the threads run on, or -1 for any
+    int numa_node = -1;
+    // The most threads an op runs on, or 0 for as many as there are
+    std::size_t threads = 0;
+
     void finish() const {}
 
+    // DNNL runs its primitives on an OpenMP team started by the calling thread, so the team is
+    // limited to the threads of the context for each thread that runs the program
+    void limit_threads() const
+    {
+#ifndef MIGRAPHX_DISABLE_OMP
+        thread_local std::size_t limit = 0;
+        if(threads == 0 or threads == limit)
+            return;
+        limit = threads;
+        omp_set_num_threads(threads);
+#endif
+    }
+
+    // The ops and the passes keep no state shared between instructions or modules, so they can
+    // be finalized and run on several threads
+    bool parallel_compile() const { return true; }
+
+    // The most threads bulk_execute splits the work over
+    std::size_t bulk_threads() const
+    {
+        if(threads > 0)
+            return std::min<std::size_t>(max_threads(), threads);
+        return max_threads();
+    }
+
+    // The calling thread runs part of each op, so it is pinned to the node once for the whole
+    // evaluation. It is given back the cpus it had at the end, since it belongs to the application.
+    void begin_eval() const
+    {
+        auto& binding = caller_binding();
+        if(numa_node >= 0 and binding == nullptr)
+            binding = std::make_unique<numa_thread_binding>(numa_node);
+    }
+
+    void end_eval() const { caller_binding().reset(); }
+
     template <class F>
     void bulk_execute(std::size_t n, std::size_t min_grain, F f)
     {
-        cpu::parallel_for(n, min_grain, f);
+        auto threadsize = std::min<std::size_t>(bulk_threads(), n / min_grain);
+        if(numa_node < 0)
+        {
+            cpu::parallel_for_impl(n, threadsize, f);
+            return;
+        }
+        // The worker threads stay pinned to the node
+        auto caller = std::this_thread::get_id();
+        cpu::parallel_for_impl(n, threadsize, [&](auto start, auto end) {
+            if(std::this_thread::get_id() != caller)
+                bind_thread_to_numa_node(numa_node);
+            f(start, end);
+        });
     }
 
     template <class F>
@@ -25,6 +82,13 @@ struct context
     {
         this->bulk_execute(n, 256, f);
     }
+
+    private:
+    static std::unique_ptr<numa_thread_binding>& caller_binding()
+    {
+        thread_local std::unique_ptr<numa_thread_binding> result;
+        return result;
+    }
 };
 
 } // namespace cpu
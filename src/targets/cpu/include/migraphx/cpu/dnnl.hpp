@@ -24,6 +24,9 @@ struct dnnl_context
 
 dnnl_context& get_dnnl_context();
 
+// Limits the OpenMP team that DNNL starts from the calling thread to the threads of the context
+void limit_dnnl_threads(migraphx::context& ctx);
+
 dnnl::memory::data_type to_dnnl_memory_data_type(shape::type_t t);
 
 dnnl::memory::format_tag to_dnnl_memory_format_tag(std::size_t n);
@@ -192,19 +195,29 @@ struct dnnl_op : auto_register_op<Derived>
         }
         return result;
     }
+    // The first add of an input laid out like the output is done with a sum post op, which adds
+    // to what is in the output buffer when the primitive is executed
+    int get_sum_post_op_arg(const std::unordered_map<int, dnnl::memory::desc>& m) const
+    {
+        int result = -1;
+        for_each_post_op([&](auto&& op, auto arg) {
+            if(result >= 0 or not contains(op.algo, "binary_add"))
+                return;
+            if(m.at(arg) == m.at(DNNL_ARG_DST))
+                result = arg;
+        });
+        return result;
+    }
     dnnl::primitive_attr
     get_primitive_attr(const std::unordered_map<int, dnnl::memory::desc>& m) const
     {
         dnnl::primitive_attr result;
         dnnl::post_ops po;
+        auto sum_arg = get_sum_post_op_arg(m);
         for_each_post_op([&](auto&& op, auto arg) {
-            if(contains(op.algo, "binary_add"))
+            if(contains(op.algo, "binary_add") and static_cast<int>(arg) == sum_arg)
             {
-                auto desc = m.at(arg);
-                if(desc == m.at(DNNL_ARG_DST))
-                    po.append_sum(1.0f);
-                else
-                    po.append_binary(to_dnnl_algo(op.algo), m.at(arg));
+                po.append_sum(1.0f);
             }
             else if(contains(op.algo, "binary"))
             {
@@ -234,6 +247,7 @@ struct dnnl_op : auto_register_op<Derived>
     }
     argument compute(context& ctx, const shape&, const std::vector<argument>& args) const
     {
+        limit_dnnl_threads(ctx);
         return execute(ctx, args);
     }
 
@@ -260,6 +274,11 @@ struct dnnl_op : auto_register_op<Derived>
         auto md          = to_memory_desc(output_shape, inputs);
         auto prim        = get_primitive(md);
         auto arg_lookup  = create_arg_map(inputs.size());
+        auto sum_arg     = get_sum_post_op_arg(md);
+        // Index of the input that has to be copied to the output for the sum post op
+        std::ptrdiff_t sum_input =
+            sum_arg < 0 ? -1 : std::find(arg_lookup.begin(), arg_lookup.end(), sum_arg) -
+                                   arg_lookup.begin();
 #ifndef NDEBUG
         auto prim_attr = get_primitive_attr(md);
 #endif
@@ -312,6 +331,7 @@ struct dnnl_op : auto_register_op<Derived>
                     {
                         pos.get_params_sum(i, scale);
                         algo = dnnl::algorithm::binary_add;
+                        j++;
                     }
                     else
                     {
@@ -327,6 +347,11 @@ struct dnnl_op : auto_register_op<Derived>
                 }
             }
 #endif
+            if(sum_input >= 0 and args[sum_input].data() != args.back().data())
+            {
+                auto* input = args[sum_input].data();
+                std::copy(input, input + output_shape.bytes(), args.back().data());
+            }
             std::unordered_map<int, dnnl::memory> m;
             m[DNNL_ARG_DST] = to_dnnl_memory(md.at(DNNL_ARG_DST), args.back());
             for(int i = 0; i < args.size() - 1; i++)
@@ -362,8 +387,11 @@ struct dnnl_extend_op : dnnl_op<Derived, Primitive>
         const auto& self = static_cast<const Derived&>(*this);
         // Compensate for allocation
         inputs.pop_back();
-        self.required(check_shapes(inputs, self));
-        auto r = migraphx::compute_shape(op, this->trim_post_op_inputs(inputs));
+        auto prim_inputs = this->trim_post_op_inputs(inputs);
+        self.required(check_shapes(prim_inputs, self));
+        check_shapes(inputs.data() + prim_inputs.size(), inputs.data() + inputs.size(), self)
+            .packed_or_broadcasted();
+        auto r = migraphx::compute_shape(op, prim_inputs);
         // Call to get_primitive to make sure an algo is available
         this->get_primitive(this->to_memory_desc(r, inputs));
         return r;
@@ -13,6 +13,8 @@ namespace cpu {
 
 struct lowering
 {
+    // Allocate the outputs of the main module as parameters
+    bool output_buffers = false;
     std::string name() const { return "cpu::lowering"; }
     void apply(module& m) const;
 };
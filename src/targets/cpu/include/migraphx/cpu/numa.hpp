@@ -0,0 +1,87 @@
+#ifndef MIGRAPHX_GUARD_AMDMIGRAPHX_CPU_NUMA_HPP
+#define MIGRAPHX_GUARD_AMDMIGRAPHX_CPU_NUMA_HPP
+
+#include <migraphx/config.hpp>
+#include <migraphx/argument.hpp>
+#include <migraphx/shape.hpp>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace cpu {
+
+// Alignment of all the memory allocated by the cpu target
+constexpr std::size_t memory_alignment = 64;
+
+struct numa_memory_stats
+{
+    int node                = 0;
+    std::size_t bytes       = 0;
+    std::size_t peak_bytes  = 0;
+    std::size_t allocations = 0;
+};
+
+/// Number of NUMA nodes of the host, which is 1 when they can't be queried
+std::size_t get_numa_node_count();
+
+/// The cpus of a NUMA node, or empty when it is not a node of the host
+const std::vector<std::size_t>& get_numa_node_cpus(int node);
+
+/// The NUMA node set with MIGRAPHX_CPU_NUMA_NODE, or -1 when it is not set
+int get_default_numa_node();
+
+/**
+ * @brief Allocates memory aligned to memory_alignment
+ *
+ * Allocations of at least the huge page size are mapped directly and backed by transparent huge
+ * pages. When node is not negative they are placed on that NUMA node, and counted in its stats.
+ * Smaller allocations are placed on the node of the thread that first writes them.
+ */
+std::shared_ptr<char> allocate_memory(std::size_t bytes, int node = -1);
+
+inline argument allocate_argument(const shape& s, int node = -1)
+{
+    return {s, allocate_memory(s.bytes(), node)};
+}
+
+/// Parse a list of cpus or nodes such as "0-3,8,10-11", as used by sysfs
+std::vector<std::size_t> parse_cpu_list(const std::string& s);
+
+/// The cpus the calling thread can run on, or empty when they can't be queried
+std::vector<std::size_t> get_thread_cpus();
+
+/// Lets the calling thread only run on the cpus. Nothing is changed when cpus is empty.
+void set_thread_cpus(const std::vector<std::size_t>& cpus);
+
+/**
+ * @brief Pins the calling thread to the cpus of a NUMA node for good
+ *
+ * This is only done once for each thread, so it is meant for the worker threads of a thread pool.
+ * The threads of the caller should use numa_thread_binding instead.
+ */
+void bind_thread_to_numa_node(int node);
+
+/// Pins the calling thread to the cpus of a NUMA node until it is destroyed, and then lets it run
+/// on the cpus it could run on before. Nothing is changed when node is negative.
+struct numa_thread_binding
+{
+    explicit numa_thread_binding(int node);
+    numa_thread_binding(const numa_thread_binding&) = delete;
+    numa_thread_binding& operator=(const numa_thread_binding&) = delete;
+    ~numa_thread_binding();
+
+    private:
+    std::vector<std::size_t> previous;
+};
+
+/// Memory currently mapped on each NUMA node by allocate_memory, and its peak
+std::vector<numa_memory_stats> get_numa_memory_stats();
+
+} // namespace cpu
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
+
+#endif
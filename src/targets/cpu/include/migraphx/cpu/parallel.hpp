@@ -59,7 +59,7 @@ void parallel_for_impl(std::size_t n, std::size_t threadsize, F f)
     else
     {
         std::size_t grainsize = std::ceil(static_cast<double>(n) / threadsize);
-#pragma omp parallel for num_threads(threadsize) schedule(static, 1) private(grainsize, n)
+#pragma omp parallel for num_threads(threadsize) schedule(static, 1) firstprivate(grainsize, n)
         for(std::size_t tid = 0; tid < threadsize; tid++)
         {
             std::size_t work = tid * grainsize;
@@ -14,9 +14,14 @@ namespace cpu {
 
 struct target
 {
+    // The NUMA node to allocate the memory of the program on and run its threads on
+    int numa_node = get_default_numa_node();
+    // The most threads each op runs on, or 0 for as many as there are
+    std::size_t threads = 0;
+
     std::string name() const;
     std::vector<pass> get_passes(migraphx::context& gctx, const compile_options&) const;
-    migraphx::context get_context() const { return context{}; }
+    migraphx::context get_context() const { return context{numa_node, threads}; }
 
     argument copy_to(const argument& arg) const { return arg; }
     argument copy_from(const argument& arg) const { return arg; }
@@ -25,6 +30,16 @@ struct target
 
 MIGRAPHX_REGISTER_TARGET(target);
 
+/// Compiles a replica of the program for each NUMA node, whose memory is placed on that node and
+/// whose threads are pinned to the cpus of that node, so each replica can serve the requests of
+/// one socket
+std::vector<program> compile_numa_replicas(const program& p,
+                                           const compile_options& options = compile_options{});
+
+/// Targets for the stages of a pipeline, which split the threads between the stages. When there
+/// are as many NUMA nodes as stages, each stage runs on a node of its own.
+std::vector<migraphx::target> get_pipeline_targets(std::size_t stages);
+
 } // namespace cpu
 } // namespace MIGRAPHX_INLINE_NS
 } // namespace migraphx
@@ -10,7 +10,6 @@
 #include <migraphx/op/dot.hpp>
 #include <migraphx/op/quant_dot.hpp>
 #include <migraphx/op/elu.hpp>
-#include <migraphx/op/im2col.hpp>
 #include <migraphx/op/leaky_relu.hpp>
 #include <migraphx/op/logsoftmax.hpp>
 #include <migraphx/op/lrn.hpp>
@@ -28,11 +27,14 @@
 #include <migraphx/register_op.hpp>
 #include <migraphx/make_op.hpp>
 #include <migraphx/program.hpp>
+#include <migraphx/ranges.hpp>
 #include <migraphx/tune_axis.hpp>
+#include <migraphx/match/attention.hpp>
 #include <migraphx/match/layernorm.hpp>
 #include <migraphx/match/gelu_erf.hpp>
 #include <migraphx/match/gelu_tanh.hpp>
 #include <migraphx/matcher.hpp>
+#include <numeric>
 #include <unordered_map>
 #include <utility>
 #include <iostream>
@@ -55,72 +57,6 @@ typename std::conditional_t<std::is_integral<T>{}, std::make_signed<T>, std::ena
     return x;
 }
 
-struct cpu_im2col
-{
-    op::im2col op;
-
-    template <class Self, class F>
-    static auto reflect(Self& self, F f)
-    {
-        return migraphx::reflect(self.op, f);
-    }
-
-    static std::string name() { return "cpu::im2col"; }
-    shape compute_shape(const std::vector<shape>& inputs) const
-    {
-        return op.normalize_compute_shape(inputs);
-    }
-
-    argument compute(context&, const shape& output_shape, std::vector<argument> args) const
-    {
-        argument result{output_shape};
-        auto input_shape   = args[0].get_shape();
-        auto weights_shape = args[1].get_shape();
-        visit_all(result, args[0])([&](auto col, auto input) {
-            const std::size_t& height   = input_shape.lens()[2];
-            const std::size_t& width    = input_shape.lens()[3];
-            const std::size_t& channels = weights_shape.lens()[1];
-            const std::size_t& kernel_h = weights_shape.lens()[2];
-            const std::size_t& kernel_w = weights_shape.lens()[3];
-            const std::size_t& pad_h    = op.padding[0];
-            const std::size_t& pad_w    = op.padding[1];
-            const std::size_t& stride_h = op.stride[0];
-            const std::size_t& stride_w = op.stride[1];
-
-            long kdiv2_h = long(kernel_h) / 2;
-            long kdiv2_w = long(kernel_w) / 2;
-            // calculate output sizes
-            const std::size_t col_height = (height - kernel_h + 2 * pad_h) / stride_h + 1;
-            const std::size_t col_width  = (width - kernel_w + 2 * pad_w) / stride_w + 1;
-            // account for padding for the starting position of the input pixels
-            long iinput = kdiv2_h - long(pad_h);
-            // loop over output pixels (ioutput, joutput)
-            for(std::size_t ioutput = 0; ioutput < col_height; ioutput++, iinput += stride_h)
-            {
-                long jinput = kdiv2_w - long(pad_w);
-                for(std::size_t joutput = 0; joutput < col_width; joutput++, jinput += stride_w)
-                {
-                    // compute linear index for output
-                    std::size_t ldx = ioutput * col_width + joutput;
-                    std::size_t p   = 0;
-                    dfor(channels,
-                         kernel_h,
-                         kernel_w)([&](std::size_t c, std::size_t koffset, std::size_t loffset) {
-                        auto idx    = iinput + long(koffset) - kdiv2_h;
-                        auto jdx    = jinput + long(loffset) - kdiv2_w;
-                        col(ldx, p) = ((idx >= 0) && (idx < height) && (jdx >= 0) && (jdx < width))
-                                          ? input(0, c, idx, jdx)
-                                          : 0;
-                        p++;
-                    });
-                }
-            }
-        });
-        return result;
-    }
-};
-MIGRAPHX_REGISTER_OP(cpu_im2col)
-
 struct cpu_op
 {
     operation op = op::identity{};
@@ -290,9 +226,11 @@ MIGRAPHX_REGISTER_OP(cpu_rnn_var_sl_last_output)
 struct cpu_apply
 {
     module* modl;
+    const lowering* pass = nullptr;
     std::unordered_map<std::string, std::function<instruction_ref(instruction_ref)>> apply_map{};
     std::unordered_map<instruction_ref, std::string> prog_output_names{};
     instruction_ref last{};
+    bool output_buffers = false;
 
     void create_output_names()
     {
@@ -343,6 +281,26 @@ struct cpu_apply
         }
     }
 
+    // Reductions dnnl does not have an algo or a type for use the cpu kernels
+    void extend_reduce(const std::vector<std::pair<std::string, std::string>>& algos)
+    {
+        for(auto&& pp : algos)
+        {
+            std::string op_name = pp.first;
+            std::string algo    = pp.second;
+            apply_map.emplace(op_name, [=](instruction_ref ins) {
+                auto v = ins->get_operator().to_value();
+                if(not algo.empty() and has_op("dnnl::reduction") and
+                   ins->get_shape().type() == shape::type_t::float_type)
+                {
+                    v["algo"] = algo;
+                    return replace(ins, make_op("dnnl::reduction", v));
+                }
+                return replace(ins, make_op("cpu::" + op_name, v));
+            });
+        }
+    }
+
     template <class M>
     auto fuse_match(M matcher, const operation& op, const std::vector<std::string>& bind_inputs)
     {
@@ -358,8 +316,56 @@ struct cpu_apply
         });
     }
 
+    auto fuse_attention()
+    {
+        return match::make_match_finder(match::attention(), [=](auto&, const auto& r) {
+            instruction_ref ins     = r.result;
+            instruction_ref scores  = r.instructions.at("scores");
+            instruction_ref softmax = r.instructions.at("softmax");
+            if(ins->get_shape().type() != shape::float_type)
+                return;
+            auto rank        = ins->get_shape().lens().size();
+            std::size_t axis =
+                tune_axis(rank, softmax->get_operator().get_field("axis").to<int64_t>(), "softmax");
+            if(axis != rank - 1 or ins->get_operator().get_field("alpha").to<float>() != 1.0f)
+                return;
+            auto scale = scores->get_operator().get_field("alpha").to<float>();
+
+            auto is_scaled = [&](instruction_ref i) {
+                return i == scores or contains(i->inputs(), scores);
+            };
+            std::vector<instruction_ref> mask;
+            auto x = softmax->inputs().front();
+            if(x->name() == "add")
+            {
+                auto args = x->inputs();
+                if(not is_scaled(args.front()))
+                    std::swap(args.front(), args.back());
+                mask.push_back(args.back());
+                x = args.front();
+            }
+            if(x != scores)
+            {
+                auto args = x->inputs();
+                auto s    = read_scalar<float>(args.front() == scores ? args.back() : args.front());
+                if(s.empty())
+                    return;
+                if(x->name() == "mul")
+                    scale *= s.front();
+                else
+                    scale /= s.front();
+            }
+            std::vector<instruction_ref> inputs = {
+                scores->inputs().front(), scores->inputs().back(), r.instructions.at("v")};
+            inputs.insert(inputs.end(), mask.begin(), mask.end());
+            inputs.push_back(this->insert_allocation(ins, ins->get_shape()));
+            modl->replace_instruction(ins, make_op("cpu::attention", {{"scale", scale}}), inputs);
+        });
+    }
+
     void init()
     {
+        output_buffers = modl->name() == "main" and pass->output_buffers;
         create_output_names();
         extend_dnnl_algos("dnnl::binary",
                           {
@@ -381,30 +387,37 @@ struct cpu_apply
                               {"tanh", "eltwise_tanh"},
                           });
 
-        extend_dnnl_algos("dnnl::reduction",
-                          {
-                              {"reduce_max", "reduction_max"},
-                              {"reduce_mean", "reduction_mean"},
-                              {"reduce_min", "reduction_min"},
-                              {"reduce_sum", "reduction_sum"},
-                          });
+        extend_reduce({
+            {"reduce_max", "reduction_max"},
+            {"reduce_mean", "reduction_mean"},
+            {"reduce_min", "reduction_min"},
+            {"reduce_prod", ""},
+            {"reduce_sum", "reduction_sum"},
+        });
 
         extend_op("concat", "dnnl::concat");
         extend_op("contiguous", "dnnl::reorder");
         extend_op("convolution", "dnnl::convolution");
         extend_op("deconvolution", "dnnl::deconvolution");
-        extend_op("dot", "dnnl::dot");
         extend_op("erf", "cpu::erf");
         extend_op("gather", "cpu::gather");
+        extend_op("im2col", "cpu::im2col");
         extend_op("logsoftmax", "dnnl::logsoftmax");
         extend_op("lrn", "dnnl::lrn");
         extend_op("softmax", "dnnl::softmax");
         extend_op("sub", "cpu::sub");
 
-        extend_op("im2col", "cpu::im2col", false);
+        extend_op("argmax", "cpu::argmax", false);
+        extend_op("argmin", "cpu::argmin", false);
         extend_op("leaky_relu", "cpu::leaky_relu", false);
         extend_op("pad", "cpu::pad", false);
         extend_op("rnn_var_sl_last_output", "cpu::rnn_var_sl_last_output", false);
+
+        // The permutation is given by the shape of the allocation
+        apply_map.emplace("layout", [=](instruction_ref ins) {
+            return replace(ins, make_op("dnnl::layout"));
+        });
+        apply_map.emplace("dot", [=](instruction_ref ins) { return apply_dot(ins); });
     }
 
     void apply()
@@ -418,7 +431,8 @@ struct cpu_apply
                             fuse_match(match::gelu_tanh(),
                                        make_op("dnnl::eltwise", {{"algo", "eltwise_gelu_tanh"}}),
                                        {"x"}),
-                            fuse_match(match::layernorm(), make_op("dnnl::layernorm"), {"x"}));
+                            fuse_match(match::layernorm(), make_op("dnnl::layernorm"), {"x"}),
+                            fuse_attention());
         // Apply these operators first so the inputs can be const folded
         for(auto it : iterator_for(*modl))
         {
@@ -451,6 +465,39 @@ struct cpu_apply
                        {ins->inputs().front()});
     }
 
+    // A dot that is only read by slices of its last axis, as left by the horizontal fusion of
+    // dots, writes its output with that axis outermost. Each slice is then a packed block of the
+    // output that the following ops can read in place, instead of a strided view to reorder.
+    instruction_ref apply_dot(instruction_ref ins) const
+    {
+        auto op      = make_op("dnnl::dot", ins->get_operator().to_value());
+        auto s       = ins->get_shape();
+        auto rank    = s.lens().size();
+        auto outputs = ins->outputs();
+        bool split   = outputs.size() > 1 and
+                     std::all_of(outputs.begin(), outputs.end(), [&](instruction_ref output) {
+                         if(output->name() != "slice")
+                             return false;
+                         auto axes = output->get_operator().get_field("axes").to_vector<int64_t>();
+                         return axes.size() == 1 and axes.front() == int64_t(rank - 1);
+                     });
+        if(not split)
+            return replace(ins, op);
+        std::vector<int64_t> permutation(rank);
+        permutation.front() = rank - 1;
+        std::iota(permutation.begin() + 1, permutation.end(), 0);
+        auto alloc_shape = shape::from_permutation(s.type(), s.lens(), permutation);
+        auto shapes      = to_shapes(ins->inputs());
+        shapes.push_back(alloc_shape);
+        // Fallback to a standard output when dnnl cant write this layout
+        auto r = try_compute_shape(op, shapes);
+        if(r.empty() or r.front() != alloc_shape)
+            return replace(ins, op);
+        auto inputs = ins->inputs();
+        inputs.push_back(insert_allocation(ins, alloc_shape));
+        return modl->replace_instruction(ins, op, inputs);
+    }
+
     instruction_ref apply_pooling(instruction_ref ins) const
     {
         auto&& op = ins->get_operator();
@@ -493,11 +540,19 @@ struct cpu_apply
 
     instruction_ref insert_allocation(instruction_ref ins, const shape& s) const
     {
+        if(output_buffers)
+        {
+            auto ins_alias = instruction::get_output_alias(ins);
+            if(last->name() == "@return" and contains(prog_output_names, ins_alias))
+                return modl->add_parameter(prog_output_names.at(ins_alias), s);
+            else if(ins == last)
+                return modl->add_parameter(modl->name() + ":#output_0", s);
+        }
         return modl->insert_instruction(ins, make_op("cpu::allocate", {{"shape", to_value(s)}}));
     }
 };
 
-void lowering::apply(module& m) const { cpu_apply{&m}.apply(); }
+void lowering::apply(module& m) const { cpu_apply{&m, this}.apply(); }
 
 } // namespace cpu
 } // namespace MIGRAPHX_INLINE_NS
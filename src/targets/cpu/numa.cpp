@@ -0,0 +1,230 @@
+#include <migraphx/cpu/numa.hpp>
+#include <migraphx/env.hpp>
+#include <migraphx/stringutils.hpp>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#ifdef __linux__
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace migraphx {
+inline namespace MIGRAPHX_INLINE_NS {
+namespace cpu {
+
+MIGRAPHX_DECLARE_ENV_VAR(MIGRAPHX_CPU_NUMA_NODE)
+
+// Allocations of at least this size are mapped directly, so they can use huge pages
+constexpr std::size_t huge_page_size = 2 * 1024 * 1024;
+// Nodes are passed to the kernel as a single word of bits
+constexpr int max_numa_nodes = 64;
+
+struct node_counters
+{
+    std::atomic<std::size_t> bytes{0};
+    std::atomic<std::size_t> peak_bytes{0};
+    std::atomic<std::size_t> allocations{0};
+
+    void add(std::size_t n)
+    {
+        auto total = bytes += n;
+        allocations++;
+        auto peak = peak_bytes.load();
+        while(peak < total and not peak_bytes.compare_exchange_weak(peak, total))
+            ;
+    }
+
+    void remove(std::size_t n)
+    {
+        bytes -= n;
+        allocations--;
+    }
+};
+
+static std::array<node_counters, max_numa_nodes>& get_node_counters()
+{
+    static std::array<node_counters, max_numa_nodes> result{};
+    return result;
+}
+
+static std::string read_sys_file(const std::string& path)
+{
+    std::ifstream is(path);
+    std::stringstream ss;
+    ss << is.rdbuf();
+    return trim(ss.str());
+}
+
+std::vector<std::size_t> parse_cpu_list(const std::string& s)
+{
+    std::vector<std::size_t> result;
+    for(auto&& range : split_string(s, ','))
+    {
+        if(trim(range).empty())
+            continue;
+        auto bounds = split_string(range, '-');
+        auto first  = std::stoul(bounds.front());
+        auto last   = std::stoul(bounds.back());
+        for(auto i = first; i <= last; i++)
+            result.push_back(i);
+    }
+    return result;
+}
+
+std::size_t get_numa_node_count()
+{
+    static const std::size_t result = [] {
+        auto nodes = parse_cpu_list(read_sys_file("/sys/devices/system/node/online"));
+        if(nodes.empty())
+            return std::size_t{1};
+        return std::min<std::size_t>(nodes.back() + 1, max_numa_nodes);
+    }();
+    return result;
+}
+
+const std::vector<std::size_t>& get_numa_node_cpus(int node)
+{
+    // The cpus of each node are only read once
+    static const std::vector<std::vector<std::size_t>> result = [] {
+        std::vector<std::vector<std::size_t>> cpus;
+        for(std::size_t i = 0; i < get_numa_node_count(); i++)
+            cpus.push_back(parse_cpu_list(read_sys_file("/sys/devices/system/node/node" +
+                                                        std::to_string(i) + "/cpulist")));
+        return cpus;
+    }();
+    static const std::vector<std::size_t> none;
+    if(node < 0 or node >= static_cast<int>(result.size()))
+        return none;
+    return result[node];
+}
+
+int get_default_numa_node()
+{
+    auto node = string_value_of(MIGRAPHX_CPU_NUMA_NODE{});
+    if(node.empty())
+        return -1;
+    return std::stoi(node);
+}
+
+#ifdef __linux__
+static std::shared_ptr<char> map_memory(std::size_t bytes, int node)
+{
+    auto page = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+    bytes     = (bytes + page - 1) / page * page;
+    void* p   = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if(p == MAP_FAILED)
+        throw std::bad_alloc();
+    madvise(p, bytes, MADV_HUGEPAGE);
+    if(node >= 0)
+    {
+        // Prefer the node, but allow falling back to the others when it is full
+        const int mpol_preferred = 1;
+        unsigned long mask       = 1UL << node;
+        syscall(SYS_mbind, p, bytes, mpol_preferred, &mask, max_numa_nodes + 1, 0);
+        get_node_counters()[node].add(bytes);
+    }
+    return {static_cast<char*>(p), [=](char* x) {
+                munmap(x, bytes);
+                if(node >= 0)
+                    get_node_counters()[node].remove(bytes);
+            }};
+}
+#endif
+
+std::shared_ptr<char> allocate_memory(std::size_t bytes, int node)
+{
+    if(node >= static_cast<int>(get_numa_node_count()))
+        node = -1;
+    bytes = std::max<std::size_t>(bytes, 1);
+#ifdef __linux__
+    if(bytes >= huge_page_size)
+        return map_memory(bytes, node);
+#endif
+    // Smaller memory is placed on the node of the thread that first writes it
+    bytes = (bytes + memory_alignment - 1) / memory_alignment * memory_alignment;
+    std::shared_ptr<char> result{static_cast<char*>(std::aligned_alloc(memory_alignment, bytes)),
+                                 [](char* x) { std::free(x); }};
+    if(result == nullptr)
+        throw std::bad_alloc();
+    return result;
+}
+
+std::vector<std::size_t> get_thread_cpus()
+{
+    std::vector<std::size_t> result;
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if(sched_getaffinity(0, sizeof(set), &set) != 0)
+        return result;
+    for(std::size_t cpu = 0; cpu < CPU_SETSIZE; cpu++)
+    {
+        if(CPU_ISSET(cpu, &set))
+            result.push_back(cpu);
+    }
+#endif
+    return result;
+}
+
+void set_thread_cpus(const std::vector<std::size_t>& cpus)
+{
+    if(cpus.empty())
+        return;
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for(auto cpu : cpus)
+    {
+        if(cpu < CPU_SETSIZE)
+            CPU_SET(cpu, &set);
+    }
+    sched_setaffinity(0, sizeof(set), &set);
+#endif
+}
+
+void bind_thread_to_numa_node(int node)
+{
+    thread_local int bound_node = -1;
+    if(node < 0 or node == bound_node)
+        return;
+    bound_node = node;
+    set_thread_cpus(get_numa_node_cpus(node));
+}
+
+numa_thread_binding::numa_thread_binding(int node)
+{
+    if(node < 0)
+        return;
+    previous = get_thread_cpus();
+    set_thread_cpus(get_numa_node_cpus(node));
+}
+
+numa_thread_binding::~numa_thread_binding() { set_thread_cpus(previous); }
+
+std::vector<numa_memory_stats> get_numa_memory_stats()
+{
+    std::vector<numa_memory_stats> result;
+    auto&& counters = get_node_counters();
+    for(std::size_t node = 0; node < get_numa_node_count(); node++)
+    {
+        numa_memory_stats stats;
+        stats.node        = node;
+        stats.bytes       = counters[node].bytes;
+        stats.peak_bytes  = counters[node].peak_bytes;
+        stats.allocations = counters[node].allocations;
+        result.push_back(stats);
+    }
+    return result;
+}
+
+} // namespace cpu
+} // namespace MIGRAPHX_INLINE_NS
+} // namespace migraphx
@@ -28,7 +28,10 @@ struct cpu_preallocate : auto_register_op<cpu_preallocate>
         return s;
     }
     argument compute(context&, const shape&, const std::vector<argument>&) const { return data; }
-    void finalize(context&, const shape&, const std::vector<shape>&) { data = argument(s); }
+    void finalize(context& ctx, const shape&, const std::vector<shape>&)
+    {
+        data = allocate_argument(s, ctx.numa_node);
+    }
     lifetime get_lifetime() const { return lifetime::global; }
 };
 
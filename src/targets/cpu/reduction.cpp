@@ -1,5 +1,15 @@
 #include <migraphx/config.hpp>
 #include <migraphx/cpu/dnnl.hpp>
+#include <migraphx/context.hpp>
+#include <migraphx/cpu/context.hpp>
+#include <migraphx/check_shapes.hpp>
+#include <migraphx/par_reduce.hpp>
+#include <migraphx/register_op.hpp>
+#include <migraphx/op/reduce_max.hpp>
+#include <migraphx/op/reduce_mean.hpp>
+#include <migraphx/op/reduce_min.hpp>
+#include <migraphx/op/reduce_prod.hpp>
+#include <migraphx/op/reduce_sum.hpp>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
@@ -41,6 +51,84 @@ struct dnnl_reduction : dnnl_op<dnnl_reduction, dnnl::reduction>
     }
 };
 
+template <class Op>
+struct cpu_reduce : auto_register_op<cpu_reduce<Op>>
+{
+    Op op;
+
+    template <class Self, class F>
+    static auto reflect(Self& self, F f)
+    {
+        return migraphx::reflect(self.op, f);
+    }
+
+    std::string name() const { return "cpu::" + op.name(); }
+
+    shape compute_shape(std::vector<shape> inputs) const
+    {
+        // Compensate for allocation
+        inputs.pop_back();
+        check_shapes{inputs, *this}.has(1);
+        return op.normalize_compute_shape(inputs);
+    }
+
+    argument
+    // cppcheck-suppress constParameter
+    compute(context& ctx, const shape& output_shape, const std::vector<argument>& args) const
+    {
+        const auto& input_shape = args.front().get_shape();
+        auto tuned_axes         = op.tune_axes(input_shape.lens().size());
+        std::vector<std::size_t> batch_lens(output_shape.lens().size(), 1);
+        op.tune_dims(tuned_axes, input_shape.lens(), batch_lens);
+        shape batch_shape{output_shape.type(), batch_lens};
+        auto layout = find_reduce_layout(input_shape, tuned_axes);
+        visit_all(args.back(), args.front())([&](auto output, auto input) {
+            if(not layout)
+            {
+                ctx.bulk_execute(output_shape.elements(), [&](auto start, auto end) {
+                    for(auto i = start; i < end; i++)
+                    {
+                        auto out_idx = output_shape.multi(i);
+                        op.reduce(input, batch_shape, tuned_axes, out_idx, output);
+                    }
+                });
+                return;
+            }
+            // Adjacent axes of a standard input are reduced in a single pass, reading the
+            // input in memory order
+            using accumulator   = accumulator_type<typename decltype(output)::value_type>;
+            auto out            = op.output(batch_shape);
+            const auto* in_data = input.data();
+            auto* out_data      = output.data();
+            par_reduce(
+                *layout,
+                ctx.bulk_threads(),
+                [&](std::size_t n, std::size_t min_grain, auto f) {
+                    ctx.bulk_execute(n, min_grain, f);
+                },
+                accumulator{op.init()},
+                [&](std::size_t i, std::size_t) {
+                    accumulator x = in_data[i];
+                    return accumulator{op.input()(x)};
+                },
+                [&](accumulator x, accumulator y) { return accumulator{op.op()(x, y)}; },
+                [&](std::size_t i, accumulator val) { out_data[i] = out(val); });
+        });
+        return args.back();
+    }
+
+    std::ptrdiff_t output_alias(const std::vector<shape>& shapes) const
+    {
+        return shapes.size() - 1;
+    }
+};
+
+template struct cpu_reduce<op::reduce_max>;
+template struct cpu_reduce<op::reduce_mean>;
+template struct cpu_reduce<op::reduce_min>;
+template struct cpu_reduce<op::reduce_prod>;
+template struct cpu_reduce<op::reduce_sum>;
+
 } // namespace cpu
 } // namespace MIGRAPHX_INLINE_NS
 } // namespace migraphx
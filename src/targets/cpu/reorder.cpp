@@ -5,15 +5,14 @@ namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
 namespace cpu {
 
-struct dnnl_reorder : dnnl_op<dnnl_reorder, dnnl::reorder>
+template <class Derived>
+struct dnnl_reorder_op : dnnl_op<Derived, dnnl::reorder>
 {
-    std::string name() const { return "dnnl::reorder"; }
-
     shape adjust_shape(const shape& x, int) const { return x; }
 
     shape compute_shape(const std::vector<shape>& inputs) const
     {
-        check_shapes{inputs, *this}.has(2);
+        check_shapes{inputs, static_cast<const Derived&>(*this)}.has(2);
         auto r = inputs.back();
         // Call to get_primitive to make sure an algo is available
         this->get_primitive(this->to_memory_desc(r, inputs));
@@ -37,6 +36,18 @@ struct dnnl_reorder : dnnl_op<dnnl_reorder, dnnl::reorder>
     }
 };
 
+struct dnnl_reorder : dnnl_reorder_op<dnnl_reorder>
+{
+    std::string name() const { return "dnnl::reorder"; }
+};
+
+// A reorder into a layout chosen by layout_nhwc, which is named differently so
+// that eliminate_contiguous does not remove it
+struct dnnl_layout : dnnl_reorder_op<dnnl_layout>
+{
+    std::string name() const { return "dnnl::layout"; }
+};
+
 } // namespace cpu
 } // namespace MIGRAPHX_INLINE_NS
 } // namespace migraphx
@@ -11,6 +11,8 @@
 #include <migraphx/eliminate_data_type.hpp>
 #include <migraphx/eliminate_identity.hpp>
 #include <migraphx/eliminate_pad.hpp>
+#include <migraphx/hoist_loop_invariants.hpp>
+#include <migraphx/layout_nhwc.hpp>
 #include <migraphx/memory_coloring.hpp>
 #include <migraphx/propagate_constant.hpp>
 #include <migraphx/register_target.hpp>
@@ -22,6 +24,7 @@
 #include <migraphx/memory_coloring.hpp>
 #include <migraphx/simplify_algebra.hpp>
 #include <migraphx/simplify_reshapes.hpp>
+#include <migraphx/sink_transpose.hpp>
 #include <migraphx/preallocate_param.hpp>
 #include <migraphx/cpu/fuse_ops.hpp>
 #include <migraphx/cpu/write_literals.hpp>
@@ -29,6 +32,7 @@
 #include <migraphx/cpu/target.hpp>
 #include <migraphx/cpu/context.hpp>
 #include <migraphx/cpu/lowering.hpp>
+#include <migraphx/cpu/numa.hpp>
 #include <migraphx/pass.hpp>
 #include <migraphx/generate.hpp>
 #include <migraphx/normalize_ops.hpp>
@@ -40,7 +44,7 @@ namespace cpu {
 std::string target::name() const { return "cpu"; }
 
 // cppcheck-suppress constParameter
-std::vector<pass> target::get_passes(migraphx::context& gctx, const compile_options&) const
+std::vector<pass> target::get_passes(migraphx::context& gctx, const compile_options& options) const
 {
     auto& ctx = any_cast<context>(gctx);
     std::set<shape::type_t> unsupported_types(shape::types().begin(), shape::types().end());
@@ -60,14 +64,20 @@ std::vector<pass> target::get_passes(migraphx::context& gctx, const compile_opti
             dead_code_elimination{},
             eliminate_common_subexpression{},
             dead_code_elimination{},
+            hoist_loop_invariants{},
+            dead_code_elimination{},
             simplify_algebra{},
             simplify_reshapes{},
+            sink_transpose{},
+            simplify_reshapes{},
             simplify_algebra{},
             auto_contiguous{},
             simplify_reshapes{},
+            layout_nhwc{},
+            dead_code_elimination{},
             propagate_constant{},
             dead_code_elimination{},
-            lowering{},
+            lowering{options.output_buffers},
             eliminate_contiguous{"dnnl::reorder"},
             dead_code_elimination{},
             adjust_allocation{cpu_allocation_model{}},
@@ -82,7 +92,46 @@ std::vector<pass> target::get_passes(migraphx::context& gctx, const compile_opti
             dead_code_elimination{}};
 }
 
-argument target::allocate(const shape& s) const { return fill_argument(s, 0); }
+argument target::allocate(const shape& s) const
+{
+    auto result = allocate_argument(s, numa_node);
+    std::fill(result.data(), result.data() + s.bytes(), 0);
+    return result;
+}
+
+std::vector<program> compile_numa_replicas(const program& p, const compile_options& options)
+{
+    std::vector<program> result;
+    for(int node = 0; node < static_cast<int>(get_numa_node_count()); node++)
+    {
+        target t;
+        t.numa_node = node;
+        result.push_back(p);
+        result.back().compile(t, options);
+    }
+    return result;
+}
+
+std::vector<migraphx::target> get_pipeline_targets(std::size_t stages)
+{
+    std::vector<migraphx::target> result;
+    auto nodes = get_numa_node_count();
+    for(std::size_t s = 0; s < stages; s++)
+    {
+        target t;
+        if(nodes > 1 and nodes >= stages)
+        {
+            t.numa_node = static_cast<int>(s);
+            t.threads   = get_numa_node_cpus(t.numa_node).size();
+        }
+        else
+        {
+            t.threads = std::max<std::size_t>(max_threads() / stages, 1);
+        }
+        result.push_back(t);
+    }
+    return result;
+}
 
 MIGRAPHX_REGISTER_TARGET(target);
 
@@ -1,7 +1,12 @@
 #include <migraphx/cpu/write_literals.hpp>
+#include <migraphx/cpu/context.hpp>
+#include <migraphx/cpu/numa.hpp>
 #include <migraphx/module.hpp>
 #include <migraphx/instruction.hpp>
 #include <migraphx/iterator_for.hpp>
+#include <migraphx/literal.hpp>
+#include <algorithm>
+#include <cstdint>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
@@ -9,7 +14,7 @@ namespace cpu {
 
 struct cpu_literal
 {
-    argument data;
+    literal data;
 
     template <class Self, class F>
     static auto reflect(Self& self, F f)
@@ -21,7 +26,22 @@ struct cpu_literal
 
     shape compute_shape(const std::vector<shape>&) const { return data.get_shape(); }
 
-    argument compute(const shape&, const std::vector<argument>&) const { return data; }
+    argument compute(const shape&, const std::vector<argument>&) const
+    {
+        return data.get_shared_argument();
+    }
+
+    // Move the data to aligned memory on the NUMA node of the context
+    void finalize(context& ctx, const shape&, const std::vector<shape>&)
+    {
+        const auto& s = data.get_shape();
+        auto aligned  = reinterpret_cast<std::uintptr_t>(data.data()) % memory_alignment == 0;
+        if(aligned and ctx.numa_node < 0)
+            return;
+        auto buffer = allocate_memory(s.bytes(), ctx.numa_node);
+        std::copy(data.data(), data.data() + s.bytes(), buffer.get());
+        data = literal{s, buffer};
+    }
 
     friend std::ostream& operator<<(std::ostream& os, const cpu_literal& x)
     {
@@ -36,7 +56,7 @@ void write_literals::apply(module& m) const
     {
         if(ins->name() != "@literal")
             continue;
-        m.replace_instruction(ins, cpu_literal{ins->get_literal().get_argument()});
+        m.replace_instruction(ins, cpu_literal{ins->get_literal()});
     }
 }
 
@@ -17,8 +17,7 @@ struct hip_stream_model
     std::size_t get_stream(migraphx::instruction_ref ins) const { return ins2stream.at(ins); }
     std::size_t get_event_id(migraphx::instruction_ref ins) const
     {
-        auto v = ins->get_operator().to_value();
-        return v["event"].to<std::size_t>();
+        return ins->get_operator().get_field("event").to<std::size_t>();
     }
     bool has_stream(migraphx::instruction_ref ins) const { return ins2stream.count(ins) > 0; }
     bool is_record(migraphx::instruction_ref ins) const
@@ -36,8 +35,7 @@ stream_model make_stream_model(const module& p)
     {
         if(ins->name() == "gpu::set_stream")
         {
-            auto v       = ins->get_operator().to_value();
-            stream       = v["stream"].to<std::size_t>();
+            stream       = ins->get_operator().get_field("stream").to<std::size_t>();
             m.max_stream = std::max(stream, m.max_stream);
         }
         if(ins->get_operator().is_context_free())
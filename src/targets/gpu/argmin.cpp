@@ -10,6 +10,8 @@ namespace gpu {
 shape hip_argmin::compute_shape(const std::vector<shape>& inputs) const
 {
     check_shapes{inputs, *this}.has(2).standard();
+    if(op.output_value)
+        MIGRAPHX_THROW("ARGMIN: output_value is not supported on gpu");
     return op.normalize_compute_shape({inputs.at(0)});
 }
 
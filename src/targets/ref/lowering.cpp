@@ -383,45 +383,37 @@ struct ref_im2col
         argument result{output_shape};
         auto input_shape   = args[0].get_shape();
         auto weights_shape = args[1].get_shape();
+        auto kdims         = op.kdims();
+        // output pixels are indexed by batch followed by the spatial output dims
+        std::vector<std::size_t> pixel_lens{input_shape.lens()[0]};
+        auto spatial_lens = op.output_spatial_lens(input_shape, weights_shape);
+        pixel_lens.insert(pixel_lens.end(), spatial_lens.begin(), spatial_lens.end());
+        // columns are indexed by channel followed by the kernel dims
+        std::vector<std::size_t> window_lens(weights_shape.lens().begin() + 1,
+                                             weights_shape.lens().end());
+        shape pixel_shape{shape::float_type, pixel_lens};
+        shape window_shape{shape::float_type, window_lens};
         visit_all(result, args[0])([&](auto col, auto input) {
-            const std::size_t& height   = input_shape.lens()[2];
-            const std::size_t& width    = input_shape.lens()[3];
-            const std::size_t& channels = weights_shape.lens()[1];
-            const std::size_t& kernel_h = weights_shape.lens()[2];
-            const std::size_t& kernel_w = weights_shape.lens()[3];
-            const std::size_t& pad_h    = op.padding[0];
-            const std::size_t& pad_w    = op.padding[1];
-            const std::size_t& stride_h = op.stride[0];
-            const std::size_t& stride_w = op.stride[1];
-
-            long kdiv2_h = long(kernel_h) / 2;
-            long kdiv2_w = long(kernel_w) / 2;
-            // calculate output sizes
-            const std::size_t col_height = (height - kernel_h + 2 * pad_h) / stride_h + 1;
-            const std::size_t col_width  = (width - kernel_w + 2 * pad_w) / stride_w + 1;
-            // account for padding for the starting position of the input pixels
-            long iinput = kdiv2_h - long(pad_h);
-            // loop over output pixels (ioutput, joutput)
-            for(std::size_t ioutput = 0; ioutput < col_height; ioutput++, iinput += stride_h)
-            {
-                long jinput = kdiv2_w - long(pad_w);
-                for(std::size_t joutput = 0; joutput < col_width; joutput++, jinput += stride_w)
-                {
-                    // compute linear index for output
-                    std::size_t ldx = ioutput * col_width + joutput;
-                    std::size_t p   = 0;
-                    dfor(channels,
-                         kernel_h,
-                         kernel_w)([&](std::size_t c, std::size_t koffset, std::size_t loffset) {
-                        auto idx    = iinput + long(koffset) - kdiv2_h;
-                        auto jdx    = jinput + long(loffset) - kdiv2_w;
-                        col(ldx, p) = ((idx >= 0) && (idx < height) && (jdx >= 0) && (jdx < width))
-                                          ? input(0, c, idx, jdx)
-                                          : 0;
-                        p++;
-                    });
-                }
-            }
+            shape_for_each(pixel_shape, [&](const auto& pixel_idx) {
+                auto ldx = pixel_shape.index(pixel_idx);
+                std::vector<std::size_t> idx(input_shape.lens().size());
+                idx[0] = pixel_idx[0];
+                shape_for_each(window_shape, [&](const auto& window_idx) {
+                    auto p         = window_shape.index(window_idx);
+                    bool in_bounds = true;
+                    idx[1]         = window_idx[0];
+                    for(std::size_t d = 0; d < kdims; d++)
+                    {
+                        auto x = std::ptrdiff_t(pixel_idx[d + 1] * op.stride[d] +
+                                                window_idx[d + 1] * op.dilation[d]) -
+                                 std::ptrdiff_t(op.padding[d]);
+                        in_bounds = in_bounds and x >= 0 and
+                                    x < std::ptrdiff_t(input_shape.lens()[d + 2]);
+                        idx[d + 2] = x;
+                    }
+                    col(ldx, p) = in_bounds ? input(idx.begin(), idx.end()) : 0;
+                });
+            });
         });
         return result;
     }
@@ -4,12 +4,15 @@
 #include <migraphx/errors.hpp>
 #include <migraphx/stringutils.hpp>
 #include <migraphx/value.hpp>
+#include <algorithm>
 #include <unordered_map>
 #include <utility>
 
 namespace migraphx {
 inline namespace MIGRAPHX_INLINE_NS {
 
+struct object_value_holder;
+
 struct value_base_impl : cloneable<value_base_impl>
 {
     virtual value::type_t get_type() { return value::null_type; }
@@ -17,7 +20,7 @@ struct value_base_impl : cloneable<value_base_impl>
     virtual const cpp_type* if_##vt() const { return nullptr; }
     MIGRAPHX_VISIT_VALUE_TYPES(MIGRAPHX_VALUE_GENERATE_BASE_FUNCTIONS)
     virtual std::vector<value>* if_array() { return nullptr; }
-    virtual std::unordered_map<std::string, std::size_t>* if_object() { return nullptr; }
+    virtual object_value_holder* if_object() { return nullptr; }
     virtual value_base_impl* if_value() const { return nullptr; }
     value_base_impl()                       = default;
     value_base_impl(const value_base_impl&) = default;
@@ -46,19 +49,66 @@ struct array_value_holder : value_base_impl::derive<array_value_holder>
 
 struct object_value_holder : value_base_impl::derive<object_value_holder>
 {
+    // Most objects are operator attributes with a handful of keys, where a
+    // linear search is cheaper than hashing and copying a lookup table, so
+    // the table is only built for larger objects
+    static constexpr std::size_t max_linear_size = 8;
+
     object_value_holder() {}
-    object_value_holder(std::vector<value> d, std::unordered_map<std::string, std::size_t> l)
-        : data(std::move(d)), lookup(std::move(l))
-    {
-    }
+    object_value_holder(std::vector<value> d) : data(std::move(d)) { build_lookup(); }
     virtual value::type_t get_type() override { return value::object_type; }
     virtual std::vector<value>* if_array() override { return &data; }
-    virtual std::unordered_map<std::string, std::size_t>* if_object() override { return &lookup; }
+    virtual object_value_holder* if_object() override { return this; }
+
+    // Returns the index of the key, or the size when it is missing. As with
+    // the lookup table, the last one wins when a key is repeated.
+    std::size_t find(const std::string& key) const
+    {
+        if(lookup.empty())
+        {
+            auto it = std::find_if(data.rbegin(), data.rend(), [&](const value& v) {
+                return v.get_key() == key;
+            });
+            return it == data.rend() ? data.size() : std::distance(it, data.rend()) - 1;
+        }
+        auto it = lookup.find(key);
+        if(it == lookup.end())
+            return data.size();
+        return it->second;
+    }
+
+    std::pair<std::size_t, bool> insert(value v)
+    {
+        auto i = find(v.get_key());
+        if(i != data.size())
+            return std::make_pair(i, false);
+        data.push_back(std::move(v));
+        if(not lookup.empty())
+            lookup.emplace(data.back().get_key(), i);
+        else
+            build_lookup();
+        return std::make_pair(i, true);
+    }
+
+    void build_lookup()
+    {
+        lookup.clear();
+        if(data.size() <= max_linear_size)
+            return;
+        std::size_t i = 0;
+        for(auto&& e : data)
+        {
+            lookup[e.get_key()] = i;
+            i++;
+        }
+    }
+
     std::vector<value> data;
     std::unordered_map<std::string, std::size_t> lookup;
 };
 
 value::value(const value& rhs) : x(rhs.x ? rhs.x->clone() : nullptr), key(rhs.key) {}
+value::value(value&& rhs) noexcept : x(std::move(rhs.x)), key(std::move(rhs.key)) {}
 value& value::operator=(value rhs)
 {
     std::swap(rhs.x, x);
@@ -68,7 +118,7 @@ value& value::operator=(value rhs)
 }
 
 void set_vector(std::shared_ptr<value_base_impl>& x,
-                const std::vector<value>& v,
+                std::vector<value> v,
                 bool array_on_empty = true)
 {
     if(v.empty())
@@ -80,20 +130,9 @@ void set_vector(std::shared_ptr<value_base_impl>& x,
         return;
     }
     if(v.front().get_key().empty())
-    {
-        x = std::make_shared<array_value_holder>(v);
-    }
+        x = std::make_shared<array_value_holder>(std::move(v));
     else
-    {
-        std::unordered_map<std::string, std::size_t> lookup;
-        std::size_t i = 0;
-        for(auto&& e : v)
-        {
-            lookup[e.get_key()] = i;
-            i++;
-        }
-        x = std::make_shared<object_value_holder>(v, lookup);
-    }
+        x = std::make_shared<object_value_holder>(std::move(v));
 }
 
 value::value(const std::initializer_list<value>& i) : x(nullptr)
@@ -113,6 +152,11 @@ value::value(const std::vector<value>& v, bool array_on_empty) : x(nullptr)
     set_vector(x, v, array_on_empty);
 }
 
+value::value(std::vector<value>&& v, bool array_on_empty) : x(nullptr)
+{
+    set_vector(x, std::move(v), array_on_empty);
+}
+
 value::value(const std::unordered_map<std::string, value>& m)
     : value(std::vector<value>(m.begin(), m.end()), false)
 {
@@ -124,6 +168,12 @@ value::value(const std::string& pkey, const std::vector<value>& v, bool array_on
     set_vector(x, v, array_on_empty);
 }
 
+value::value(const std::string& pkey, std::vector<value>&& v, bool array_on_empty)
+    : x(nullptr), key(pkey)
+{
+    set_vector(x, std::move(v), array_on_empty);
+}
+
 value::value(const std::string& pkey, const std::unordered_map<std::string, value>& m)
     : value(pkey, std::vector<value>(m.begin(), m.end()), false)
 {
@@ -138,6 +188,8 @@ value::value(const std::string& pkey, const value& rhs)
 {
 }
 
+value::value(const std::string& pkey, value&& rhs) : x(std::move(rhs.x)), key(pkey) {}
+
 value::value(const char* i) : value(std::string(i)) {}
 
 #define MIGRAPHX_VALUE_GENERATE_DEFINE_METHODS(vt, cpp_type)                           \
@@ -229,13 +281,10 @@ value* find_impl(const std::shared_ptr<value_base_impl>& x, const std::string& k
     auto* a = if_array_impl(x);
     if(a == nullptr)
         return nullptr;
-    auto* lookup = x->if_object();
-    if(lookup == nullptr)
+    auto* obj = x->if_object();
+    if(obj == nullptr)
         return nullptr;
-    auto it = lookup->find(key);
-    if(it == lookup->end())
-        return a->data() + a->size();
-    return std::addressof((*a)[it->second]);
+    return a->data() + obj->find(key);
 }
 
 value* value::find(const std::string& pkey) { return find_impl(x, pkey); }
@@ -350,7 +399,12 @@ const value& value::operator[](std::size_t i) const
 }
 value& value::operator[](const std::string& pkey) { return *emplace(pkey, nullptr).first; }
 
-void value::clear() { get_array_throw(x).clear(); }
+void value::clear()
+{
+    get_array_throw(x).clear();
+    if(auto* obj = x->if_object())
+        obj->lookup.clear();
+}
 void value::resize(std::size_t n)
 {
     if(not is_array())
@@ -364,51 +418,69 @@ void value::resize(std::size_t n, const value& v)
     get_array_impl(x).resize(n, v);
 }
 
-std::pair<value*, bool> value::insert(const value& v)
+std::pair<value*, bool> value::insert(const value& v) { return insert(value(v)); }
+std::pair<value*, bool> value::insert(value&& v)
 {
     if(v.key.empty())
     {
         if(!x)
             x = std::make_shared<array_value_holder>();
-        get_array_impl(x).push_back(v);
+        get_array_impl(x).push_back(std::move(v));
         assert(this->if_array());
         return std::make_pair(&back(), true);
     }
     else
     {
-        if(!x)
+        // An empty array has no keys yet so it can become an object
+        if(!x or (is_array() and empty()))
             x = std::make_shared<object_value_holder>();
-        auto p = x->if_object()->emplace(v.key, get_array_impl(x).size());
-        if(p.second)
-            get_array_impl(x).push_back(v);
+        auto* obj = x->if_object();
+        if(obj == nullptr)
+            MIGRAPHX_THROW("Expected an object");
+        auto p = obj->insert(std::move(v));
         assert(this->if_object());
-        return std::make_pair(&get_array_impl(x)[p.first->second], p.second);
+        return std::make_pair(&obj->data[p.first], p.second);
     }
 }
-value* value::insert(const value* pos, const value& v)
+value* value::insert(const value* pos, const value& v) { return insert(pos, value(v)); }
+value* value::insert(const value* pos, value&& v)
 {
     assert(v.key.empty());
     if(!x)
         x = std::make_shared<array_value_holder>();
     auto&& a = get_array_impl(x);
-    auto it  = a.insert(a.begin() + (pos - begin()), v);
+    auto it  = a.insert(a.begin() + (pos - begin()), std::move(v));
     return std::addressof(*it);
 }
 
-value value::without_key() const
+value value::without_key() const&
 {
     value result = *this;
     result.key   = "";
     return result;
 }
 
-value value::with_key(const std::string& pkey) const
+value value::without_key() &&
+{
+    value result = std::move(*this);
+    result.key   = "";
+    return result;
+}
+
+value value::with_key(const std::string& pkey) const&
 {
     value result = *this;
     result.key   = pkey;
     return result;
 }
 
+value value::with_key(const std::string& pkey) &&
+{
+    value result = std::move(*this);
+    result.key   = pkey;
+    return result;
+}
+
 template <class F, class T, class U, class Common = typename std::common_type<T, U>::type>
 auto compare_common_impl(
     rank<1>, F f, const std::string& keyx, const T& x, const std::string& keyy, const U& y)
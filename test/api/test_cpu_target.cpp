@@ -0,0 +1,33 @@
+#include <algorithm>
+#include <string>
+#include <migraphx/migraphx.h>
+#include <migraphx/migraphx.hpp>
+#include "test.hpp"
+
+TEST_CASE(output_buffers)
+{
+    auto p = migraphx::parse_onnx("conv_relu_maxpool_test.onnx");
+    migraphx_compile_options options;
+    options.offload_copy   = false;
+    options.fast_math      = true;
+    options.output_buffers = true;
+    p.compile(migraphx::target("cpu"), options);
+    auto param_shapes = p.get_parameter_shapes();
+    auto names        = param_shapes.names();
+    CHECK(std::find(names.begin(), names.end(), std::string("main:#output_0")) != names.end());
+
+    auto output = migraphx::argument::generate(param_shapes["main:#output_0"]);
+    migraphx::program_parameters pp;
+    for(auto&& name : names)
+    {
+        if(std::string(name) == "main:#output_0")
+            pp.add(name, output);
+        else
+            pp.add(name, migraphx::argument::generate(param_shapes[name]));
+    }
+    auto outputs = p.eval(pp);
+    CHECK(outputs.size() == 1);
+    CHECK(outputs.front().data() == output.data());
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -0,0 +1,126 @@
+#include <migraphx/batch_runner.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/ref/target.hpp>
+#include <numeric>
+#include <vector>
+#include "test.hpp"
+
+static migraphx::program create_program(std::size_t batch)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    auto x   = mm->add_parameter("x", {migraphx::shape::float_type, {batch, 3}});
+    auto y   = mm->add_parameter("y", {migraphx::shape::float_type, {batch, 3}});
+    mm->add_instruction(migraphx::make_op("add"), x, y);
+    p.compile(migraphx::ref::target{});
+    return p;
+}
+
+// Reads the rows of the input into every batched parameter
+static auto read_rows(const std::vector<float>& input, std::size_t& pos, std::size_t& reads)
+{
+    return [&](migraphx::parameter_map& batch) {
+        reads++;
+        std::size_t n = 0;
+        for(auto&& b : batch)
+        {
+            auto* data = reinterpret_cast<float*>(b.second.data());
+            auto rows  = b.second.get_shape().lens().front();
+            n          = std::min(rows, (input.size() - pos) / 3);
+            std::copy(input.begin() + pos, input.begin() + pos + n * 3, data);
+        }
+        pos += n * 3;
+        return n;
+    };
+}
+
+TEST_CASE(run_batches_partial)
+{
+    auto p = create_program(4);
+    std::vector<float> input(10 * 3);
+    std::iota(input.begin(), input.end(), 0);
+    std::size_t pos   = 0;
+    std::size_t reads = 0;
+    std::vector<float> result;
+    std::vector<std::size_t> rows;
+    auto n = migraphx::run_batches(
+        p, read_rows(input, pos, reads), [&](const std::vector<migraphx::argument>& outputs) {
+            EXPECT(outputs.size() == 1);
+            rows.push_back(outputs.front().get_shape().lens().front());
+            outputs.front().visit([&](auto v) { result.insert(result.end(), v.begin(), v.end()); });
+        });
+    EXPECT(n == 10);
+    EXPECT(rows == std::vector<std::size_t>{4, 4, 2});
+    // The partial batch ends the input without another read
+    EXPECT(reads == 3);
+    std::vector<float> gold(input.size());
+    std::transform(input.begin(), input.end(), gold.begin(), [](auto x) { return 2 * x; });
+    EXPECT(result == gold);
+}
+
+TEST_CASE(run_batches_exact)
+{
+    auto p = create_program(5);
+    std::vector<float> input(10 * 3, 1);
+    std::size_t pos   = 0;
+    std::size_t reads = 0;
+    std::vector<std::size_t> rows;
+    auto n = migraphx::run_batches(
+        p, read_rows(input, pos, reads), [&](const std::vector<migraphx::argument>& outputs) {
+            rows.push_back(outputs.front().get_shape().lens().front());
+        });
+    EXPECT(n == 10);
+    EXPECT(rows == std::vector<std::size_t>{5, 5});
+    EXPECT(reads == 3);
+}
+
+TEST_CASE(run_batches_fixed)
+{
+    auto p = create_program(4);
+    std::vector<float> y(4 * 3, 1);
+    migraphx::parameter_map fixed;
+    fixed["y"] = migraphx::argument{migraphx::shape{migraphx::shape::float_type, {4, 3}}, y.data()};
+    std::vector<float> input(6 * 3, 2);
+    std::size_t pos   = 0;
+    std::size_t reads = 0;
+    std::vector<float> result;
+    auto n = migraphx::run_batches(
+        p,
+        [&](migraphx::parameter_map& batch) {
+            EXPECT(batch.size() == 1);
+            EXPECT(batch.count("x") == 1);
+            return read_rows(input, pos, reads)(batch);
+        },
+        [&](const std::vector<migraphx::argument>& outputs) {
+            outputs.front().visit([&](auto v) { result.insert(result.end(), v.begin(), v.end()); });
+        },
+        fixed);
+    EXPECT(n == 6);
+    EXPECT(result == std::vector<float>(6 * 3, 3));
+}
+
+TEST_CASE(run_batches_empty)
+{
+    auto p = create_program(4);
+    bool written = false;
+    auto n       = migraphx::run_batches(
+        p,
+        [](migraphx::parameter_map&) { return std::size_t{0}; },
+        [&](const std::vector<migraphx::argument>&) { written = true; });
+    EXPECT(n == 0);
+    EXPECT(not written);
+}
+
+TEST_CASE(run_batches_too_many_rows)
+{
+    auto p = create_program(4);
+    EXPECT(test::throws([&] {
+        migraphx::run_batches(
+            p,
+            [](migraphx::parameter_map&) { return std::size_t{5}; },
+            [](const std::vector<migraphx::argument>&) {});
+    }));
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
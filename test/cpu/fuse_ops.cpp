@@ -0,0 +1,90 @@
+#include <migraphx/cpu/target.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/instruction.hpp>
+#include <test.hpp>
+#include <algorithm>
+#include <cmath>
+
+static std::size_t count_ops(const migraphx::module& m, const std::string& name)
+{
+    return std::count_if(
+        m.begin(), m.end(), [&](const migraphx::instruction& ins) { return ins.name() == name; });
+}
+
+static std::vector<std::string> post_op_algos(const migraphx::module& m, const std::string& name)
+{
+    std::vector<std::string> result;
+    auto ins = std::find_if(
+        m.begin(), m.end(), [&](const migraphx::instruction& x) { return x.name() == name; });
+    if(ins == m.end())
+        return result;
+    for(const auto& po : ins->get_operator().get_field("post_ops"))
+        result.push_back(po.at("algo").to<std::string>());
+    return result;
+}
+
+TEST_CASE(conv_bias_add_relu)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    auto input = mm->add_parameter("x", migraphx::shape{migraphx::shape::float_type, {4, 3, 3, 3}});
+    auto weights =
+        mm->add_parameter("w", migraphx::shape{migraphx::shape::float_type, {4, 3, 3, 3}});
+    auto residual =
+        mm->add_parameter("r", migraphx::shape{migraphx::shape::float_type, {4, 4, 1, 1}});
+    auto bias =
+        mm->add_literal(migraphx::generate_literal({migraphx::shape::float_type, {4}}, 1));
+    auto conv       = mm->add_instruction(migraphx::make_op("convolution"), input, weights);
+    auto bcast_bias = mm->add_instruction(
+        migraphx::make_op("broadcast", {{"axis", 1}, {"dims", conv->get_shape().lens()}}), bias);
+    auto bias_add = mm->add_instruction(migraphx::make_op("add"), conv, bcast_bias);
+    auto add      = mm->add_instruction(migraphx::make_op("add"), residual, bias_add);
+    mm->add_instruction(migraphx::make_op("relu"), add);
+    p.compile(migraphx::cpu::target{});
+
+    // The bias, the residual and the activation are all post ops of the convolution
+    EXPECT(count_ops(*mm, "dnnl::convolution") == 1);
+    EXPECT(count_ops(*mm, "dnnl::binary") == 0);
+    EXPECT(count_ops(*mm, "dnnl::eltwise") == 0);
+    auto algos = post_op_algos(*mm, "dnnl::convolution");
+    EXPECT(algos == std::vector<std::string>{"binary_add", "binary_add", "eltwise_relu"});
+}
+
+TEST_CASE(gemm_add_gelu)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    std::vector<std::size_t> lens{2, 8, 16};
+    auto x = mm->add_parameter("x", migraphx::shape{migraphx::shape::float_type, {2, 8, 4}});
+    auto w =
+        mm->add_literal(migraphx::generate_literal({migraphx::shape::float_type, {4, 16}}, 1));
+    auto bias = mm->add_literal(migraphx::generate_literal({migraphx::shape::float_type, {16}}, 2));
+    auto wb =
+        mm->add_instruction(migraphx::make_op("multibroadcast", {{"output_lens", {2, 4, 16}}}), w);
+    auto dot = mm->add_instruction(migraphx::make_op("dot"), x, wb);
+    auto bias_mbcast =
+        mm->add_instruction(migraphx::make_op("multibroadcast", {{"output_lens", lens}}), bias);
+    auto add = mm->add_instruction(migraphx::make_op("add"), dot, bias_mbcast);
+    auto mbcast = [&](float f) {
+        return mm->add_instruction(migraphx::make_op("multibroadcast", {{"output_lens", lens}}),
+                                   mm->add_literal(f));
+    };
+    auto mul_half = mm->add_instruction(migraphx::make_op("mul"), add, mbcast(0.5f));
+    auto div      = mm->add_instruction(
+        migraphx::make_op("div"), add, mbcast(static_cast<float>(M_SQRT2)));
+    auto erf     = mm->add_instruction(migraphx::make_op("erf"), div);
+    auto add_one = mm->add_instruction(migraphx::make_op("add"), erf, mbcast(1.0f));
+    mm->add_instruction(migraphx::make_op("mul"), mul_half, add_one);
+    p.compile(migraphx::cpu::target{});
+
+    // The bias and the gelu are post ops of the dot
+    EXPECT(count_ops(*mm, "dnnl::dot") == 1);
+    EXPECT(count_ops(*mm, "dnnl::binary") == 0);
+    EXPECT(count_ops(*mm, "dnnl::eltwise") == 0);
+    auto algos = post_op_algos(*mm, "dnnl::dot");
+    EXPECT(algos == std::vector<std::string>{"binary_add", "eltwise_gelu_erf"});
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
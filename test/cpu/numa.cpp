@@ -0,0 +1,149 @@
+#include <migraphx/cpu/numa.hpp>
+#include <migraphx/cpu/context.hpp>
+#include <migraphx/cpu/target.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/generate.hpp>
+#include <test.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+
+// Allocations of at least this size are mapped directly
+const std::size_t huge_page_size = 2 * 1024 * 1024;
+
+bool is_aligned(const std::shared_ptr<char>& p)
+{
+    return reinterpret_cast<std::uintptr_t>(p.get()) % migraphx::cpu::memory_alignment == 0;
+}
+
+TEST_CASE(parse_cpu_list)
+{
+    using v = std::vector<std::size_t>;
+    EXPECT(migraphx::cpu::parse_cpu_list("0-3,8,10-11") == v{0, 1, 2, 3, 8, 10, 11});
+    EXPECT(migraphx::cpu::parse_cpu_list("5") == v{5});
+    EXPECT(migraphx::cpu::parse_cpu_list("2-2") == v{2});
+    EXPECT(migraphx::cpu::parse_cpu_list("").empty());
+    EXPECT(migraphx::cpu::parse_cpu_list("0,,1") == v{0, 1});
+}
+
+TEST_CASE(allocate_aligned)
+{
+    std::vector<std::size_t> sizes = {0, 1, 63, 65, 4097, huge_page_size - 1, huge_page_size + 1};
+    for(auto bytes : sizes)
+    {
+        auto p = migraphx::cpu::allocate_memory(bytes);
+        EXPECT(bool{p});
+        EXPECT(is_aligned(p));
+        // The memory can be written all the way to the end
+        std::fill(p.get(), p.get() + bytes, 1);
+    }
+}
+
+TEST_CASE(allocate_node_stats)
+{
+    auto before = migraphx::cpu::get_numa_memory_stats();
+    EXPECT(before.size() == migraphx::cpu::get_numa_node_count());
+    {
+        auto p = migraphx::cpu::allocate_memory(huge_page_size, 0);
+        EXPECT(is_aligned(p));
+        auto during = migraphx::cpu::get_numa_memory_stats().front();
+        EXPECT(during.node == 0);
+        EXPECT(during.allocations == before.front().allocations + 1);
+        EXPECT(during.bytes >= before.front().bytes + huge_page_size);
+        EXPECT(during.peak_bytes >= during.bytes);
+    }
+    auto after = migraphx::cpu::get_numa_memory_stats().front();
+    EXPECT(after.allocations == before.front().allocations);
+    EXPECT(after.bytes == before.front().bytes);
+    EXPECT(after.peak_bytes >= before.front().bytes + huge_page_size);
+}
+
+TEST_CASE(allocate_small_stats)
+{
+    // Small memory is not mapped on the node, so it is not counted
+    auto before = migraphx::cpu::get_numa_memory_stats().front();
+    auto p      = migraphx::cpu::allocate_memory(1000, 0);
+    EXPECT(is_aligned(p));
+    std::fill(p.get(), p.get() + 1000, 1);
+    auto during = migraphx::cpu::get_numa_memory_stats().front();
+    EXPECT(during.allocations == before.allocations);
+    EXPECT(during.bytes == before.bytes);
+}
+
+TEST_CASE(allocate_huge_stats)
+{
+    // Memory that is not on a node is not counted, even when it is mapped
+    auto before = migraphx::cpu::get_numa_memory_stats();
+    {
+        auto p     = migraphx::cpu::allocate_memory(huge_page_size);
+        auto other = migraphx::cpu::allocate_memory(100, migraphx::cpu::get_numa_node_count());
+        EXPECT(is_aligned(p));
+        EXPECT(is_aligned(other));
+        auto during = migraphx::cpu::get_numa_memory_stats();
+        for(std::size_t i = 0; i < during.size(); i++)
+        {
+            EXPECT(during[i].allocations == before[i].allocations);
+            EXPECT(during[i].bytes == before[i].bytes);
+        }
+    }
+}
+
+TEST_CASE(binding_restores_cpus)
+{
+    auto cpus = migraphx::cpu::get_thread_cpus();
+    {
+        migraphx::cpu::numa_thread_binding binding{0};
+    }
+    EXPECT(migraphx::cpu::get_thread_cpus() == cpus);
+    {
+        migraphx::cpu::numa_thread_binding binding{-1};
+        EXPECT(migraphx::cpu::get_thread_cpus() == cpus);
+    }
+    migraphx::cpu::set_thread_cpus({});
+    EXPECT(migraphx::cpu::get_thread_cpus() == cpus);
+}
+
+TEST_CASE(node_cpus)
+{
+    for(int node = 0; node < static_cast<int>(migraphx::cpu::get_numa_node_count()); node++)
+    {
+        const auto& cpus = migraphx::cpu::get_numa_node_cpus(node);
+        EXPECT(std::is_sorted(cpus.begin(), cpus.end()));
+        // The cpus are only read once
+        EXPECT(&migraphx::cpu::get_numa_node_cpus(node) == &cpus);
+    }
+    EXPECT(migraphx::cpu::get_numa_node_cpus(-1).empty());
+    EXPECT(migraphx::cpu::get_numa_node_cpus(migraphx::cpu::get_numa_node_count()).empty());
+}
+
+TEST_CASE(eval_restores_caller_cpus)
+{
+    auto cpus = migraphx::cpu::get_thread_cpus();
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape s{migraphx::shape::float_type, {64}};
+    auto x = mm->add_parameter("x", s);
+    mm->add_instruction(migraphx::make_op("add"), x, x);
+    migraphx::cpu::target t;
+    t.numa_node = 0;
+    p.compile(t);
+    p.eval({{"x", migraphx::generate_argument(s)}});
+    EXPECT(migraphx::cpu::get_thread_cpus() == cpus);
+}
+
+TEST_CASE(bulk_execute_keeps_caller_cpus)
+{
+    auto cpus = migraphx::cpu::get_thread_cpus();
+    migraphx::cpu::context ctx;
+    ctx.numa_node = 0;
+    std::atomic<std::size_t> total{0};
+    ctx.bulk_execute(1024, 1, [&](auto start, auto end) { total += end - start; });
+    EXPECT(total == 1024);
+    // A single thread runs on the caller
+    ctx.bulk_execute(16, 16, [&](auto start, auto end) { total += end - start; });
+    EXPECT(total == 1040);
+    EXPECT(migraphx::cpu::get_thread_cpus() == cpus);
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
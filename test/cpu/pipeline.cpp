@@ -0,0 +1,94 @@
+#include <migraphx/cpu/target.hpp>
+#include <migraphx/cpu/numa.hpp>
+#include <migraphx/pipeline.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/verify_args.hpp>
+#include <test.hpp>
+#include <thread>
+#include <vector>
+
+static migraphx::program create_program()
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape s{migraphx::shape::float_type, {4, 8}};
+    auto x  = mm->add_parameter("x", s);
+    auto w1 = mm->add_literal(migraphx::generate_literal({migraphx::shape::float_type, {8, 8}}, 1));
+    auto w2 = mm->add_literal(migraphx::generate_literal({migraphx::shape::float_type, {8, 8}}, 2));
+    auto d1 = mm->add_instruction(migraphx::make_op("dot"), x, w1);
+    auto r1 = mm->add_instruction(migraphx::make_op("relu"), d1);
+    auto d2 = mm->add_instruction(migraphx::make_op("dot"), r1, w2);
+    auto a  = mm->add_instruction(migraphx::make_op("add"), d2, x);
+    mm->add_return({a});
+    return p;
+}
+
+TEST_CASE(pipeline_targets)
+{
+    auto nodes = migraphx::cpu::get_numa_node_count();
+    for(std::size_t stages : {1, 2, 3})
+    {
+        auto targets = migraphx::cpu::get_pipeline_targets(stages);
+        EXPECT(targets.size() == stages);
+        std::size_t threads = 0;
+        for(std::size_t s = 0; s < targets.size(); s++)
+        {
+            const auto* t = targets[s].any_cast<migraphx::cpu::target>();
+            EXPECT(t);
+            EXPECT(t->threads > 0);
+            threads += t->threads;
+            if(nodes > 1 and nodes >= stages)
+                EXPECT(t->numa_node == static_cast<int>(s));
+        }
+        // The stages don't start more threads than there are between them
+        if(nodes == 1)
+            EXPECT(threads <= std::max(migraphx::cpu::max_threads(), stages));
+    }
+}
+
+TEST_CASE(limit_threads)
+{
+    // Each thread has its own limit, so it is checked on a thread of its own
+    std::size_t limited = 0;
+    std::thread t([&] {
+        migraphx::cpu::context ctx;
+        ctx.threads = 1;
+        ctx.limit_threads();
+        limited = migraphx::cpu::max_threads();
+    });
+    t.join();
+    EXPECT(limited == 1);
+}
+
+TEST_CASE(pipeline_run)
+{
+    auto p = create_program();
+    migraphx::pipeline pl{p, migraphx::cpu::get_pipeline_targets(2)};
+    // The pipeline should give the same results as the whole program
+    auto gold_p = p;
+    gold_p.compile(migraphx::cpu::target{});
+    std::vector<migraphx::argument> inputs;
+    for(std::size_t i = 0; i < 5; i++)
+        inputs.push_back(migraphx::generate_argument(p.get_parameter_shape("x"), i));
+
+    std::size_t read    = 0;
+    std::size_t written = 0;
+    auto n              = pl.run(
+        [&](migraphx::parameter_map& params) {
+            if(read == inputs.size())
+                return false;
+            params["x"] = inputs[read++];
+            return true;
+        },
+        [&](const std::vector<migraphx::argument>& outputs) {
+            auto gold = gold_p.eval({{"x", inputs[written++]}});
+            EXPECT(outputs.size() == 1);
+            EXPECT(migraphx::verify_args("pipeline", gold.front(), outputs.front()));
+        });
+    EXPECT(n == inputs.size());
+    EXPECT(written == inputs.size());
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
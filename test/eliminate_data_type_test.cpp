@@ -4,6 +4,7 @@
 #include <migraphx/pass_manager.hpp>
 #include <basic_ops.hpp>
 #include <migraphx/make_op.hpp>
+#include <migraphx/program.hpp>
 
 #include <test.hpp>
 
@@ -68,4 +69,35 @@ TEST_CASE(quant)
     EXPECT(mm1 == mm2);
 }
 
+TEST_CASE(control_flow)
+{
+    migraphx::shape ts{migraphx::shape::int64_type};
+    migraphx::shape cs{migraphx::shape::bool_type};
+    migraphx::shape s{migraphx::shape::float_type, {2}};
+    migraphx::program p1;
+    {
+        auto* mm  = p1.get_main_module();
+        auto trip = mm->add_parameter("trip", ts);
+        auto cond = mm->add_parameter("cond", cs);
+        auto a    = mm->add_parameter("a", s);
+
+        auto* body = p1.create_module("body");
+        body->add_parameter("#loop_iter", ts);
+        auto bcond = body->add_parameter("#loop_cond", cs);
+        auto ba    = body->add_parameter("#loop_dep0", s);
+        auto add   = body->add_instruction(migraphx::make_op("add"), ba, ba);
+        body->add_return({bcond, add});
+
+        auto loop = mm->add_instruction(
+            migraphx::make_op("loop", {{"max_iterations", 4}}), {trip, cond, a}, {body});
+        auto r = mm->add_instruction(migraphx::make_op("get_tuple_elem", {{"index", 0}}), loop);
+        mm->add_return({r});
+    }
+    // The loop keeps its trip count, condition and body
+    migraphx::program p2 = p1;
+    run_pass(*p1.get_main_module(), {migraphx::shape::int64_type, migraphx::shape::bool_type});
+    EXPECT(p1 == p2);
+    EXPECT(bool{p1.validate() == p1.get_main_module()->end()});
+}
+
 int main(int argc, const char* argv[]) { test::run(argc, argv); }
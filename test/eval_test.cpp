@@ -475,6 +475,44 @@ TEST_CASE(eval_context3)
     EXPECT(not is_shared(t.ctx, p.get_context()));
 }
 
+struct eval_count_target
+{
+    struct context
+    {
+        std::shared_ptr<int> begins = std::make_shared<int>(0);
+        std::shared_ptr<int> ends   = std::make_shared<int>(0);
+        void begin_eval() const { (*begins)++; }
+        void end_eval() const { (*ends)++; }
+        void finish() const {}
+    };
+    context ctx{};
+    std::string name() const { return "eval_count"; }
+    std::vector<migraphx::pass> get_passes(migraphx::context&,
+                                           const migraphx::compile_options&) const
+    {
+        return {};
+    }
+    migraphx::context get_context() const { return ctx; }
+};
+
+TEST_CASE(eval_context_begin_end)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    auto x   = mm->add_parameter("x", {migraphx::shape::int32_type});
+    auto two = mm->add_literal(2);
+    mm->add_instruction(sum_op{}, x, two);
+    eval_count_target t{};
+    p.compile(t);
+    p.eval({{"x", migraphx::literal{1}.get_argument()}});
+    EXPECT(*t.ctx.begins == 1);
+    EXPECT(*t.ctx.ends == 1);
+    // The evaluation is ended when it throws
+    EXPECT(test::throws([&] { p.eval({}); }));
+    EXPECT(*t.ctx.begins == 2);
+    EXPECT(*t.ctx.ends == 2);
+}
+
 struct cout_redirect
 {
     cout_redirect()                     = delete;
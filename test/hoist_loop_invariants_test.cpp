@@ -0,0 +1,121 @@
+#include <migraphx/dead_code_elimination.hpp>
+#include <migraphx/hoist_loop_invariants.hpp>
+#include <migraphx/pass_manager.hpp>
+#include <migraphx/instruction.hpp>
+#include <basic_ops.hpp>
+#include <migraphx/operators.hpp>
+#include <migraphx/make_op.hpp>
+
+#include <test.hpp>
+
+void run_pass(migraphx::program& p)
+{
+    migraphx::run_passes(p,
+                         {migraphx::hoist_loop_invariants{}, migraphx::dead_code_elimination{}});
+}
+
+TEST_CASE(hoist_invariants)
+{
+    migraphx::shape ts{migraphx::shape::int64_type};
+    migraphx::shape cs{migraphx::shape::bool_type};
+    migraphx::shape s{migraphx::shape::float_type, {2, 2}};
+    migraphx::shape xs{migraphx::shape::float_type, {2}};
+    std::vector<float> wdata = {1, 2, 3, 4};
+
+    migraphx::program p1;
+    {
+        auto* mm  = p1.get_main_module();
+        auto trip = mm->add_parameter("trip", ts);
+        auto cond = mm->add_parameter("cond", cs);
+        auto a    = mm->add_parameter("a", s);
+        auto x    = mm->add_parameter("x", xs);
+
+        auto* body = p1.create_module("body");
+        body->add_parameter("#loop_iter", ts);
+        auto bcond = body->add_parameter("#loop_cond", cs);
+        auto ba    = body->add_parameter("#loop_dep0", s);
+        auto w     = body->add_literal(migraphx::literal{s, wdata});
+        auto wt    = body->add_instruction(migraphx::make_op("transpose", {{"dims", {1, 0}}}), w);
+        auto bx    = body->add_instruction(
+            migraphx::make_op("multibroadcast", {{"output_lens", {2, 2}}}), x);
+        auto dot   = body->add_instruction(migraphx::make_op("dot"), ba, wt);
+        auto add   = body->add_instruction(migraphx::make_op("add"), dot, bx);
+        body->add_return({bcond, add});
+
+        auto loop = mm->add_instruction(
+            migraphx::make_op("loop", {{"max_iterations", 4}}), {trip, cond, a}, {body});
+
+        auto r = mm->add_instruction(migraphx::make_op("get_tuple_elem", {{"index", 0}}), loop);
+        mm->add_return({r});
+    }
+    run_pass(p1);
+
+    migraphx::program p2;
+    {
+        auto* mm  = p2.get_main_module();
+        auto trip = mm->add_parameter("trip", ts);
+        auto cond = mm->add_parameter("cond", cs);
+        auto a    = mm->add_parameter("a", s);
+        auto x    = mm->add_parameter("x", xs);
+        auto w    = mm->add_literal(migraphx::literal{s, wdata});
+        auto wt   = mm->add_instruction(migraphx::make_op("transpose", {{"dims", {1, 0}}}), w);
+        auto bx   = mm->add_instruction(
+            migraphx::make_op("multibroadcast", {{"output_lens", {2, 2}}}), x);
+
+        // The unused iteration number is removed from the body
+        auto* body = p2.create_module("body");
+        auto bcond = body->add_parameter("#loop_cond", cs);
+        auto ba    = body->add_parameter("#loop_dep0", s);
+        auto dot   = body->add_instruction(migraphx::make_op("dot"), ba, wt);
+        auto add   = body->add_instruction(migraphx::make_op("add"), dot, bx);
+        body->add_return({bcond, add});
+
+        auto loop = mm->add_instruction(
+            migraphx::make_op("loop", {{"max_iterations", 4}}), {trip, cond, a}, {body});
+
+        auto r = mm->add_instruction(migraphx::make_op("get_tuple_elem", {{"index", 0}}), loop);
+        mm->add_return({r});
+    }
+
+    EXPECT(p1 == p2);
+}
+
+TEST_CASE(keep_variants)
+{
+    auto create_program = [] {
+        migraphx::shape ts{migraphx::shape::int64_type};
+        migraphx::shape cs{migraphx::shape::bool_type};
+        migraphx::shape s{migraphx::shape::float_type, {2, 2}};
+
+        migraphx::program p;
+        auto* mm  = p.get_main_module();
+        auto trip = mm->add_parameter("trip", ts);
+        auto cond = mm->add_parameter("cond", cs);
+        auto a    = mm->add_parameter("a", s);
+
+        auto* body = p.create_module("body");
+        auto iter  = body->add_parameter("#loop_iter", ts);
+        auto bcond = body->add_parameter("#loop_cond", cs);
+        auto ba    = body->add_parameter("#loop_dep0", s);
+        auto fi    = body->add_instruction(
+            migraphx::make_op("convert", {{"target_type", migraphx::shape::float_type}}), iter);
+        auto bi    = body->add_instruction(
+            migraphx::make_op("multibroadcast", {{"output_lens", {2, 2}}}), fi);
+        auto t     = body->add_instruction(migraphx::make_op("transpose", {{"dims", {1, 0}}}), ba);
+        auto add   = body->add_instruction(migraphx::make_op("add"), t, bi);
+        body->add_return({bcond, add});
+
+        auto loop = mm->add_instruction(
+            migraphx::make_op("loop", {{"max_iterations", 4}}), {trip, cond, a}, {body});
+
+        auto r = mm->add_instruction(migraphx::make_op("get_tuple_elem", {{"index", 0}}), loop);
+        mm->add_return({r});
+        return p;
+    };
+
+    auto p = create_program();
+    run_pass(p);
+    EXPECT(p == create_program());
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -0,0 +1,154 @@
+#include <migraphx/layout_nhwc.hpp>
+#include <migraphx/dead_code_elimination.hpp>
+#include <migraphx/pass_manager.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/ref/target.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/verify.hpp>
+
+#include <test.hpp>
+
+void run_pass(migraphx::module& m)
+{
+    migraphx::run_passes(m, {migraphx::layout_nhwc{}, migraphx::dead_code_elimination{}});
+}
+
+migraphx::operation layout(std::vector<int64_t> permutation = {0, 2, 3, 1})
+{
+    return migraphx::make_op("layout", {{"permutation", permutation}});
+}
+
+migraphx::operation pooling()
+{
+    return migraphx::make_op("pooling", {{"lengths", {2, 2}}, {"stride", {2, 2}}});
+}
+
+TEST_CASE(conv_relu_conv)
+{
+    migraphx::shape xs{migraphx::shape::float_type, {1, 3, 8, 8}};
+    migraphx::shape w1s{migraphx::shape::float_type, {4, 3, 3, 3}};
+    migraphx::shape w2s{migraphx::shape::float_type, {2, 4, 3, 3}};
+    migraphx::module m1;
+    {
+        auto x     = m1.add_parameter("x", xs);
+        auto w1    = m1.add_parameter("w1", w1s);
+        auto w2    = m1.add_parameter("w2", w2s);
+        auto conv1 = m1.add_instruction(migraphx::make_op("convolution"), x, w1);
+        auto relu  = m1.add_instruction(migraphx::make_op("relu"), conv1);
+        auto conv2 = m1.add_instruction(migraphx::make_op("convolution"), relu, w2);
+        m1.add_return({conv2});
+    }
+    run_pass(m1);
+
+    migraphx::module m2;
+    {
+        auto x     = m2.add_parameter("x", xs);
+        auto w1    = m2.add_parameter("w1", w1s);
+        auto w2    = m2.add_parameter("w2", w2s);
+        auto lx    = m2.add_instruction(layout(), x);
+        auto conv1 = m2.add_instruction(migraphx::make_op("convolution"), lx, w1);
+        auto relu  = m2.add_instruction(migraphx::make_op("relu"), conv1);
+        auto conv2 = m2.add_instruction(migraphx::make_op("convolution"), relu, w2);
+        auto c     = m2.add_instruction(migraphx::make_op("contiguous"), conv2);
+        m2.add_return({c});
+    }
+    EXPECT(m1 == m2);
+}
+
+TEST_CASE(conv_pooling_conv)
+{
+    migraphx::shape xs{migraphx::shape::float_type, {1, 3, 8, 8}};
+    migraphx::shape w1s{migraphx::shape::float_type, {4, 3, 1, 1}};
+    migraphx::shape w2s{migraphx::shape::float_type, {2, 4, 1, 1}};
+    migraphx::module m1;
+    {
+        auto x     = m1.add_parameter("x", xs);
+        auto w1    = m1.add_parameter("w1", w1s);
+        auto w2    = m1.add_parameter("w2", w2s);
+        auto conv1 = m1.add_instruction(migraphx::make_op("convolution"), x, w1);
+        auto pool  = m1.add_instruction(pooling(), conv1);
+        auto conv2 = m1.add_instruction(migraphx::make_op("convolution"), pool, w2);
+        m1.add_return({conv2});
+    }
+    run_pass(m1);
+
+    migraphx::module m2;
+    {
+        auto x     = m2.add_parameter("x", xs);
+        auto w1    = m2.add_parameter("w1", w1s);
+        auto w2    = m2.add_parameter("w2", w2s);
+        auto lx    = m2.add_instruction(layout(), x);
+        auto conv1 = m2.add_instruction(migraphx::make_op("convolution"), lx, w1);
+        auto pool  = m2.add_instruction(pooling(), conv1);
+        auto conv2 = m2.add_instruction(migraphx::make_op("convolution"), pool, w2);
+        auto c     = m2.add_instruction(migraphx::make_op("contiguous"), conv2);
+        m2.add_return({c});
+    }
+    EXPECT(m1 == m2);
+}
+
+TEST_CASE(conv_reshape)
+{
+    migraphx::shape xs{migraphx::shape::float_type, {1, 3, 8, 8}};
+    migraphx::shape ws{migraphx::shape::float_type, {4, 3, 1, 1}};
+    migraphx::module m1;
+    {
+        auto x    = m1.add_parameter("x", xs);
+        auto w    = m1.add_parameter("w", ws);
+        auto conv = m1.add_instruction(migraphx::make_op("convolution"), x, w);
+        auto r    = m1.add_instruction(migraphx::make_op("reshape", {{"dims", {4, 64}}}), conv);
+        m1.add_return({r});
+    }
+    run_pass(m1);
+
+    migraphx::module m2;
+    {
+        auto x    = m2.add_parameter("x", xs);
+        auto w    = m2.add_parameter("w", ws);
+        auto lx   = m2.add_instruction(layout(), x);
+        auto conv = m2.add_instruction(migraphx::make_op("convolution"), lx, w);
+        auto c    = m2.add_instruction(migraphx::make_op("contiguous"), conv);
+        auto r    = m2.add_instruction(migraphx::make_op("reshape", {{"dims", {4, 64}}}), c);
+        m2.add_return({r});
+    }
+    EXPECT(m1 == m2);
+}
+
+TEST_CASE(conv_add_relu_eval)
+{
+    migraphx::shape xs{migraphx::shape::float_type, {2, 3, 6, 6}};
+    migraphx::shape ws{migraphx::shape::float_type, {3, 3, 3, 3}};
+    migraphx::program p1;
+    {
+        auto* mm   = p1.get_main_module();
+        auto x     = mm->add_parameter("x", xs);
+        auto w     = mm->add_literal(migraphx::generate_literal(ws, 1));
+        auto conv1 =
+            mm->add_instruction(migraphx::make_op("convolution", {{"padding", {1, 1}}}), x, w);
+        auto add   = mm->add_instruction(migraphx::make_op("add"), conv1, x);
+        auto relu  = mm->add_instruction(migraphx::make_op("relu"), add);
+        auto pool  = mm->add_instruction(pooling(), relu);
+        auto conv2 = mm->add_instruction(migraphx::make_op("convolution"), pool, w);
+        mm->add_instruction(migraphx::make_op("relu"), conv2);
+    }
+    auto p2 = p1;
+    run_pass(*p2.get_main_module());
+    EXPECT(p1 != p2);
+
+    migraphx::parameter_map params;
+    params["x"] = migraphx::generate_argument(xs);
+    p1.compile(migraphx::ref::target{});
+    p2.compile(migraphx::ref::target{});
+    auto result1 = p1.eval(params).back();
+    auto result2 = p2.eval(params).back();
+    EXPECT(result2.get_shape().standard());
+    std::vector<float> results_vector1;
+    std::vector<float> results_vector2;
+    result1.visit([&](auto output) { results_vector1.assign(output.begin(), output.end()); });
+    result2.visit([&](auto output) { results_vector2.assign(output.begin(), output.end()); });
+    EXPECT(migraphx::verify_range(results_vector1, results_vector2));
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -1,6 +1,8 @@
 
 #include <migraphx/literal.hpp>
 #include <migraphx/serialize.hpp>
+#include <migraphx/module.hpp>
+#include <migraphx/instruction.hpp>
 #include <sstream>
 #include <string>
 #include "test.hpp"
@@ -135,4 +137,40 @@ TEST_CASE(value_literal)
     EXPECT(l4 == l2);
 }
 
+TEST_CASE(literal_intern)
+{
+    migraphx::shape s{migraphx::shape::float_type, {64}};
+    std::vector<float> data(s.elements(), 1.5f);
+    migraphx::literal l1{s, data};
+    migraphx::literal l2{s, data};
+    EXPECT(l1.data() != l2.data());
+    auto bytes = migraphx::literal_store_bytes();
+    {
+        auto i1 = l1.intern();
+        auto i2 = l2.intern();
+        EXPECT(i1 == l1);
+        EXPECT(i1.data() == i2.data());
+        EXPECT(migraphx::literal_store_bytes() == bytes + s.bytes());
+
+        data.back() = 2.5f;
+        auto i3     = migraphx::literal{s, data}.intern();
+        EXPECT(i3 != i1);
+        EXPECT(i3.data() != i1.data());
+    }
+    EXPECT(migraphx::literal_store_bytes() == bytes);
+}
+
+TEST_CASE(literal_intern_modules)
+{
+    migraphx::shape s{migraphx::shape::int32_type, {2, 3}};
+    migraphx::module m1;
+    migraphx::module m2;
+    auto l1 = m1.add_literal(migraphx::literal{s, {1, 2, 3, 4, 5, 6}});
+    auto l2 = m2.add_literal(migraphx::literal{s, {1, 2, 3, 4, 5, 6}});
+    EXPECT(l1->get_literal().data() == l2->get_literal().data());
+
+    auto l3 = migraphx::from_value<migraphx::literal>(migraphx::to_value(l1->get_literal()));
+    EXPECT(l3.data() == l1->get_literal().data());
+}
+
 int main(int argc, const char* argv[]) { test::run(argc, argv); }
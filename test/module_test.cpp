@@ -253,4 +253,21 @@ TEST_CASE(submodule_copy)
     EXPECT(mm.get_sub_modules() == mm2.get_sub_modules());
 }
 
+TEST_CASE(parameter_names_after_finalize)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape s{migraphx::shape::float_type, {2}};
+    auto x = mm->add_parameter("x", s);
+    auto y = mm->add_parameter("y", s);
+    mm->add_instruction(migraphx::make_op("add"), x, y);
+    p.compile(migraphx::ref::target());
+    EXPECT(mm->get_parameter_names() == std::vector<std::string>{"x", "y"});
+
+    auto z = mm->add_parameter("z", s);
+    EXPECT(mm->get_parameter_names() == std::vector<std::string>{"x", "y", "z"});
+    mm->remove_instruction(z);
+    EXPECT(mm->get_parameter_names() == std::vector<std::string>{"x", "y"});
+}
+
 int main(int argc, const char* argv[]) { test::run(argc, argv); }
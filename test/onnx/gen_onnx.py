@@ -2297,6 +2297,54 @@ def logsoftmax_nonstd_input_test():
     return ([node0, node1], [x], [z])
 
 
+@onnx_test
+def loop_test():
+    iter_in = helper.make_tensor_value_info('iter', TensorProto.INT64, [])
+    cond_in = helper.make_tensor_value_info('cond_in', TensorProto.BOOL, [])
+    a_in = helper.make_tensor_value_info('a_in', TensorProto.FLOAT, [2])
+    cond_out = helper.make_tensor_value_info('cond_out', TensorProto.BOOL, [])
+    a_out = helper.make_tensor_value_info('a_out', TensorProto.FLOAT, [2])
+    scan_out = helper.make_tensor_value_info('scan_out', TensorProto.FLOAT,
+                                             [2])
+    two = helper.make_tensor(name='two',
+                             data_type=TensorProto.INT64,
+                             dims=[],
+                             vals=[2])
+
+    add_node = onnx.helper.make_node('Add',
+                                     inputs=['a_in', 'x'],
+                                     outputs=['a_out'])
+    less_node = onnx.helper.make_node('Less',
+                                      inputs=['iter', 'two'],
+                                      outputs=['cond_out'])
+    identity_node = onnx.helper.make_node('Identity',
+                                          inputs=['a_out'],
+                                          outputs=['scan_out'])
+
+    body = onnx.helper.make_graph([add_node, less_node, identity_node],
+                                  'body', [iter_in, cond_in, a_in],
+                                  [cond_out, a_out, scan_out], [two])
+
+    trip = helper.make_tensor(name='trip',
+                              data_type=TensorProto.INT64,
+                              dims=[],
+                              vals=[4])
+    cond = helper.make_tensor_value_info('cond', TensorProto.BOOL, [])
+    a = helper.make_tensor_value_info('a', TensorProto.FLOAT, [2])
+    x = helper.make_tensor_value_info('x', TensorProto.FLOAT, [2])
+    a_final = helper.make_tensor_value_info('a_final', TensorProto.FLOAT,
+                                            [2])
+    a_scan = helper.make_tensor_value_info('a_scan', TensorProto.FLOAT,
+                                           [4, 2])
+
+    node = onnx.helper.make_node('Loop',
+                                 inputs=['trip', 'cond', 'a'],
+                                 outputs=['a_final', 'a_scan'],
+                                 body=body)
+
+    return ([node], [cond, a, x], [a_final, a_scan], [trip])
+
+
 @onnx_test
 def lrn_test():
     x = helper.make_tensor_value_info('0', TensorProto.FLOAT, [1, 28, 24, 24])
@@ -2510,6 +2558,31 @@ def not_bool_test():
     return ([node], [x], [y])
 
 
+@onnx_test
+def nms_test():
+    b = helper.make_tensor_value_info('boxes', TensorProto.FLOAT, [1, 6, 4])
+    s = helper.make_tensor_value_info('scores', TensorProto.FLOAT, [1, 1, 6])
+    mo = helper.make_tensor_value_info('max_output_boxes_per_class',
+                                       TensorProto.INT64, [1])
+    iou = helper.make_tensor_value_info('iou_threshold', TensorProto.FLOAT,
+                                        [1])
+    st = helper.make_tensor_value_info('score_threshold', TensorProto.FLOAT,
+                                       [1])
+    out = helper.make_tensor_value_info('selected_indices', TensorProto.INT64,
+                                        [6, 3])
+
+    node = onnx.helper.make_node('NonMaxSuppression',
+                                 inputs=[
+                                     'boxes', 'scores',
+                                     'max_output_boxes_per_class',
+                                     'iou_threshold', 'score_threshold'
+                                 ],
+                                 outputs=['selected_indices'],
+                                 center_point_box=1)
+
+    return ([node], [b, s, mo, iou, st], [out])
+
+
 @onnx_test
 def no_pad_test():
     x = helper.make_tensor_value_info('0', TensorProto.FLOAT, [2, 2])
@@ -2555,6 +2628,18 @@ def nonzero_int_test():
     return ([node], [], [y], [data])
 
 
+@onnx_test
+def nonzero_dynamic_test():
+    x = helper.make_tensor_value_info('data', TensorProto.BOOL, [2, 2])
+    y = helper.make_tensor_value_info('indices', TensorProto.INT64, [2, 4])
+
+    node = onnx.helper.make_node('NonZero',
+                                 inputs=['data'],
+                                 outputs=['indices'])
+
+    return ([node], [x], [y])
+
+
 @onnx_test
 def onehot_test():
     axis_value = 0
@@ -3356,6 +3441,73 @@ def resize_upsample_pc_test():
     return ([node], [X], [Y], [scale_tensor])
 
 
+@onnx_test
+def scan_test():
+    sum_in = helper.make_tensor_value_info('sum_in', TensorProto.FLOAT, [2])
+    x_in = helper.make_tensor_value_info('x_in', TensorProto.FLOAT, [2])
+    sum_out = helper.make_tensor_value_info('sum_out', TensorProto.FLOAT, [2])
+    scan_out = helper.make_tensor_value_info('scan_out', TensorProto.FLOAT,
+                                             [2])
+
+    add_node = onnx.helper.make_node('Add',
+                                     inputs=['sum_in', 'x_in'],
+                                     outputs=['sum_out'])
+    identity_node = onnx.helper.make_node('Identity',
+                                          inputs=['sum_out'],
+                                          outputs=['scan_out'])
+
+    body = onnx.helper.make_graph([add_node, identity_node], 'body',
+                                  [sum_in, x_in], [sum_out, scan_out])
+
+    init = helper.make_tensor_value_info('init', TensorProto.FLOAT, [2])
+    xs = helper.make_tensor_value_info('xs', TensorProto.FLOAT, [3, 2])
+    final = helper.make_tensor_value_info('final', TensorProto.FLOAT, [2])
+    scans = helper.make_tensor_value_info('scans', TensorProto.FLOAT, [3, 2])
+
+    node = onnx.helper.make_node('Scan',
+                                 inputs=['init', 'xs'],
+                                 outputs=['final', 'scans'],
+                                 num_scan_inputs=1,
+                                 body=body)
+
+    return ([node], [init, xs], [final, scans])
+
+
+@onnx_test
+def scan_reverse_test():
+    sum_in = helper.make_tensor_value_info('sum_in', TensorProto.FLOAT, [2])
+    x_in = helper.make_tensor_value_info('x_in', TensorProto.FLOAT, [2])
+    sum_out = helper.make_tensor_value_info('sum_out', TensorProto.FLOAT, [2])
+    scan_out = helper.make_tensor_value_info('scan_out', TensorProto.FLOAT,
+                                             [2])
+
+    add_node = onnx.helper.make_node('Add',
+                                     inputs=['sum_in', 'x_in'],
+                                     outputs=['sum_out'])
+    identity_node = onnx.helper.make_node('Identity',
+                                          inputs=['sum_out'],
+                                          outputs=['scan_out'])
+
+    body = onnx.helper.make_graph([add_node, identity_node], 'body',
+                                  [sum_in, x_in], [sum_out, scan_out])
+
+    init = helper.make_tensor_value_info('init', TensorProto.FLOAT, [2])
+    xs = helper.make_tensor_value_info('xs', TensorProto.FLOAT, [2, 3])
+    final = helper.make_tensor_value_info('final', TensorProto.FLOAT, [2])
+    scans = helper.make_tensor_value_info('scans', TensorProto.FLOAT, [2, 3])
+
+    node = onnx.helper.make_node('Scan',
+                                 inputs=['init', 'xs'],
+                                 outputs=['final', 'scans'],
+                                 num_scan_inputs=1,
+                                 scan_input_axes=[1],
+                                 scan_input_directions=[1],
+                                 scan_output_axes=[1],
+                                 body=body)
+
+    return ([node], [init, xs], [final, scans])
+
+
 @onnx_test
 def selu_test():
     x = helper.make_tensor_value_info('x', TensorProto.DOUBLE, [2, 3])
@@ -4057,6 +4209,44 @@ def tile_test_3x2():
             [helper.make_tensor('y', TensorProto.INT64, [2], [3, 2])])
 
 
+@onnx_test
+def topk_no_k_test():
+    x = helper.make_tensor_value_info('data', TensorProto.FLOAT, [2, 5, 3, 2])
+    val = helper.make_tensor_value_info('val', TensorProto.FLOAT,
+                                        [2, 2, 3, 2])
+    ind = helper.make_tensor_value_info('indices', TensorProto.INT64,
+                                        [2, 2, 3, 2])
+
+    node = onnx.helper.make_node('TopK',
+                                 inputs=['data'],
+                                 outputs=['val', 'indices'],
+                                 axis=1)
+
+    return ([node], [x], [val, ind])
+
+
+@onnx_test
+def topk_test():
+    x = helper.make_tensor_value_info('data', TensorProto.FLOAT, [2, 5, 3, 2])
+    val = helper.make_tensor_value_info('val', TensorProto.FLOAT,
+                                        [2, 2, 3, 2])
+    ind = helper.make_tensor_value_info('indices', TensorProto.INT64,
+                                        [2, 2, 3, 2])
+    k = np.array([2])
+    k_tensor = helper.make_tensor(name='k',
+                                  data_type=TensorProto.INT64,
+                                  dims=k.shape,
+                                  vals=k.astype(np.int64))
+
+    node = onnx.helper.make_node('TopK',
+                                 inputs=['data', 'k'],
+                                 outputs=['val', 'indices'],
+                                 axis=1,
+                                 largest=0)
+
+    return ([node], [x], [val, ind], [k_tensor])
+
+
 @onnx_test
 def transpose_test():
     x = helper.make_tensor_value_info('0', TensorProto.FLOAT, [1, 2, 2, 3])
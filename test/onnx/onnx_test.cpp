@@ -1919,6 +1919,40 @@ TEST_CASE(logsoftmax_nonstd_input_test)
     EXPECT(p == prog);
 }
 
+TEST_CASE(loop_test)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape ts{migraphx::shape::int64_type};
+    migraphx::shape cs{migraphx::shape::bool_type};
+    migraphx::shape s{migraphx::shape::float_type, {2}};
+    auto trip = mm->add_literal(migraphx::literal{ts, {4}});
+    auto cond = mm->add_parameter("cond", cs);
+    auto a    = mm->add_parameter("a", s);
+    auto x    = mm->add_parameter("x", s);
+
+    auto* body = p.create_module("Loop_4_loop");
+    auto iter  = body->add_parameter("#loop_iter", ts);
+    body->add_parameter("#loop_cond", cs);
+    auto ba   = body->add_parameter("#loop_dep0", s);
+    auto two  = body->add_literal(migraphx::literal{ts, {2}});
+    auto sum  = body->add_instruction(migraphx::make_op("add"), ba, x);
+    auto less = body->add_instruction(migraphx::make_op("less"), iter, two);
+    auto next = body->add_instruction(
+        migraphx::make_op("convert", {{"target_type", migraphx::shape::bool_type}}), less);
+    auto id   = body->add_instruction(migraphx::make_op("identity"), sum);
+    body->add_return({next, sum, id});
+
+    auto loop = mm->add_instruction(
+        migraphx::make_op("loop", {{"max_iterations", 4}}), {trip, cond, a}, {body});
+    auto r0   = mm->add_instruction(migraphx::make_op("get_tuple_elem", {{"index", 0}}), loop);
+    auto r1   = mm->add_instruction(migraphx::make_op("get_tuple_elem", {{"index", 1}}), loop);
+    mm->add_return({r0, r1});
+
+    auto prog = migraphx::parse_onnx("loop_test.onnx");
+    EXPECT(p == prog);
+}
+
 TEST_CASE(lrn_test)
 {
     migraphx::program p;
@@ -2134,6 +2168,34 @@ TEST_CASE(neg_test)
     EXPECT(p == prog);
 }
 
+TEST_CASE(nms_test)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape sb{migraphx::shape::float_type, {1, 6, 4}};
+    auto b = mm->add_parameter("boxes", sb);
+
+    migraphx::shape ss{migraphx::shape::float_type, {1, 1, 6}};
+    auto s = mm->add_parameter("scores", ss);
+
+    migraphx::shape smo{migraphx::shape::int64_type, {1}};
+    auto mo = mm->add_parameter("max_output_boxes_per_class", smo);
+
+    migraphx::shape siou{migraphx::shape::float_type, {1}};
+    auto iou = mm->add_parameter("iou_threshold", siou);
+
+    migraphx::shape sst{migraphx::shape::float_type, {1}};
+    auto st = mm->add_parameter("score_threshold", sst);
+
+    auto ret = mm->add_instruction(
+        migraphx::make_op("nonmaxsuppression", {{"center_point_box", 1}}), b, s, mo, iou, st);
+    mm->add_return({ret});
+
+    auto prog = migraphx::parse_onnx("nms_test.onnx");
+
+    EXPECT(p == prog);
+}
+
 TEST_CASE(nonzero_test)
 {
     migraphx::program p;
@@ -2168,6 +2230,19 @@ TEST_CASE(nonzero_int_test)
     EXPECT(p == prog);
 }
 
+TEST_CASE(nonzero_dynamic_test)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape s{migraphx::shape::bool_type, {2, 2}};
+    auto data = mm->add_parameter("data", s);
+    auto r    = mm->add_instruction(migraphx::make_op("nonzero"), data);
+    mm->add_return({r});
+
+    auto prog = migraphx::parse_onnx("nonzero_dynamic_test.onnx");
+    EXPECT(p == prog);
+}
+
 TEST_CASE(not_test)
 {
     migraphx::program p;
@@ -3162,6 +3237,38 @@ TEST_CASE(round_test)
     EXPECT(p == prog);
 }
 
+TEST_CASE(scan_test)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape ts{migraphx::shape::int64_type};
+    migraphx::shape cs{migraphx::shape::bool_type};
+    migraphx::shape s{migraphx::shape::float_type, {2}};
+    auto init = mm->add_parameter("init", s);
+    auto xs   = mm->add_parameter("xs", {migraphx::shape::float_type, {3, 2}});
+
+    auto* body = p.create_module("Scan_2_scan");
+    auto iter  = body->add_parameter("#loop_iter", ts);
+    auto bcond = body->add_parameter("#loop_cond", cs);
+    auto sum   = body->add_parameter("#loop_dep0", s);
+    body->add_literal(migraphx::literal{ts, {2}});
+    auto x   = body->add_instruction(migraphx::make_op("gather", {{"axis", 0}}), xs, iter);
+    auto add = body->add_instruction(migraphx::make_op("add"), sum, x);
+    auto id  = body->add_instruction(migraphx::make_op("identity"), add);
+    body->add_return({bcond, add, id});
+
+    auto trip = mm->add_literal(migraphx::literal{ts, {3}});
+    auto cond = mm->add_literal(migraphx::literal{cs, {true}});
+    auto loop = mm->add_instruction(
+        migraphx::make_op("loop", {{"max_iterations", 3}}), {trip, cond, init}, {body});
+    auto r0   = mm->add_instruction(migraphx::make_op("get_tuple_elem", {{"index", 0}}), loop);
+    auto r1   = mm->add_instruction(migraphx::make_op("get_tuple_elem", {{"index", 1}}), loop);
+    mm->add_return({r0, r1});
+
+    auto prog = migraphx::parse_onnx("scan_test.onnx");
+    EXPECT(p == prog);
+}
+
 TEST_CASE(selu_test)
 {
     migraphx::program p;
@@ -3662,6 +3769,29 @@ TEST_CASE(tile_test_3x2)
     EXPECT(p == prog);
 }
 
+TEST_CASE(topk_no_k_test)
+{
+    EXPECT(test::throws([&] { migraphx::parse_onnx("topk_no_k_test.onnx"); }));
+}
+
+TEST_CASE(topk_test)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    mm->add_literal(migraphx::literal{migraphx::shape{migraphx::shape::int64_type, {1}}, {2}});
+    migraphx::shape s{migraphx::shape::float_type, {2, 5, 3, 2}};
+    auto data = mm->add_parameter("data", s);
+    auto out  = mm->add_instruction(
+        migraphx::make_op("topk", {{"k", 2}, {"axis", 1}, {"largest", 0}}), data);
+    auto val = mm->add_instruction(migraphx::make_op("get_tuple_elem", {{"index", 0}}), out);
+    auto ind = mm->add_instruction(migraphx::make_op("get_tuple_elem", {{"index", 1}}), out);
+    mm->add_return({val, ind});
+
+    auto prog = migraphx::parse_onnx("topk_test.onnx");
+
+    EXPECT(p == prog);
+}
+
 TEST_CASE(transpose_test)
 {
     migraphx::program p;
@@ -290,6 +290,82 @@ TEST_CASE(lessorequal_test)
     EXPECT(migraphx::verify_range(result_vector, gold));
 }
 
+TEST_CASE(loop_test)
+{
+    auto run_prog = [](bool cond) {
+        migraphx::program p = migraphx::parse_onnx("loop_test.onnx");
+        p.compile(migraphx::ref::target{});
+        migraphx::shape s{migraphx::shape::float_type, {2}};
+        std::vector<char> cond_data = {static_cast<char>(cond)};
+        std::vector<float> a_data   = {0, 10};
+        std::vector<float> x_data   = {1, 2};
+
+        migraphx::parameter_map pp;
+        pp["cond"] = migraphx::argument({migraphx::shape::bool_type}, cond_data.data());
+        pp["a"]    = migraphx::argument(s, a_data.data());
+        pp["x"]    = migraphx::argument(s, x_data.data());
+
+        auto results = p.eval(pp);
+        std::vector<std::vector<float>> result_vectors(results.size());
+        for(std::size_t i = 0; i < results.size(); i++)
+            results[i].visit(
+                [&](auto output) { result_vectors[i].assign(output.begin(), output.end()); });
+        return result_vectors;
+    };
+
+    // The body stops the loop after three of the four iterations
+    {
+        auto result_vectors           = run_prog(true);
+        std::vector<float> gold_final = {3, 16};
+        std::vector<float> gold_scan  = {1, 12, 2, 14, 3, 16, 0, 0};
+        EXPECT(migraphx::verify_range(result_vectors[0], gold_final));
+        EXPECT(migraphx::verify_range(result_vectors[1], gold_scan));
+    }
+
+    // The loop never runs
+    {
+        auto result_vectors           = run_prog(false);
+        std::vector<float> gold_final = {0, 10};
+        std::vector<float> gold_scan(8, 0);
+        EXPECT(migraphx::verify_range(result_vectors[0], gold_final));
+        EXPECT(migraphx::verify_range(result_vectors[1], gold_scan));
+    }
+}
+
+TEST_CASE(nms_test)
+{
+    migraphx::program p = migraphx::parse_onnx("nms_test.onnx");
+    p.compile(migraphx::ref::target{});
+
+    migraphx::shape boxes_s{migraphx::shape::float_type, {1, 6, 4}};
+    std::vector<float> boxes_vec = {0.5, 0.5,  1.0, 1.0, 0.5, 0.6,  1.0, 1.0, 0.5, 0.4,   1.0, 1.0,
+                                    0.5, 10.5, 1.0, 1.0, 0.5, 10.6, 1.0, 1.0, 0.5, 100.5, 1.0, 1.0};
+
+    migraphx::shape scores_s{migraphx::shape::float_type, {1, 1, 6}};
+    std::vector<float> scores_vec = {0.9, 0.75, 0.6, 0.95, 0.5, 0.3};
+
+    migraphx::shape max_out_s{migraphx::shape::int64_type, {1}};
+    std::vector<int64_t> max_out_vec = {3};
+
+    migraphx::shape threshold_s{migraphx::shape::float_type, {1}};
+    std::vector<float> iou_threshold_vec   = {0.5};
+    std::vector<float> score_threshold_vec = {0.0};
+
+    migraphx::parameter_map pp;
+    pp["boxes"]                      = migraphx::argument(boxes_s, boxes_vec.data());
+    pp["scores"]                     = migraphx::argument(scores_s, scores_vec.data());
+    pp["max_output_boxes_per_class"] = migraphx::argument(max_out_s, max_out_vec.data());
+    pp["iou_threshold"]              = migraphx::argument(threshold_s, iou_threshold_vec.data());
+    pp["score_threshold"]            = migraphx::argument(threshold_s, score_threshold_vec.data());
+
+    auto result = p.eval(pp).back();
+    std::vector<int64_t> result_vector;
+    result.visit([&](auto output) { result_vector.assign(output.begin(), output.end()); });
+
+    std::vector<int64_t> gold = {0, 0, 3, 0, 0, 0, 0, 0, 5, -1, -1, -1, -1, -1, -1, -1, -1, -1};
+    EXPECT(migraphx::verify_range(result_vector, gold));
+}
+
 TEST_CASE(resize_downsample_f_test)
 {
     migraphx::program p = migraphx::parse_onnx("resize_downsample_f_test.onnx");
@@ -388,6 +464,34 @@ TEST_CASE(resize_upsample_pf_test)
     EXPECT(migraphx::verify_range(result_vector, gold));
 }
 
+TEST_CASE(scan_reverse_test)
+{
+    migraphx::program p = migraphx::parse_onnx("scan_reverse_test.onnx");
+    p.compile(migraphx::ref::target{});
+
+    migraphx::shape s{migraphx::shape::float_type, {2}};
+    migraphx::shape xs{migraphx::shape::float_type, {2, 3}};
+    std::vector<float> init_data = {0, 0};
+    std::vector<float> xs_data   = {1, 2, 3, 4, 5, 6};
+
+    migraphx::parameter_map pp;
+    pp["init"] = migraphx::argument(s, init_data.data());
+    pp["xs"]   = migraphx::argument(xs, xs_data.data());
+
+    auto results = p.eval(pp);
+    std::vector<float> final_vector;
+    std::vector<float> scan_vector;
+    results[0].visit([&](auto output) { final_vector.assign(output.begin(), output.end()); });
+    results[1].visit([&](auto output) { scan_vector.assign(output.begin(), output.end()); });
+
+    // The columns of xs are summed from the last one, and the running sums are
+    // stacked along the second axis
+    std::vector<float> gold_final = {6, 15};
+    std::vector<float> gold_scan  = {3, 5, 6, 6, 11, 15};
+    EXPECT(migraphx::verify_range(final_vector, gold_final));
+    EXPECT(migraphx::verify_range(scan_vector, gold_scan));
+}
+
 TEST_CASE(selu_test)
 {
     migraphx::program p = migraphx::parse_onnx("selu_test.onnx");
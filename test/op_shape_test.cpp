@@ -105,6 +105,22 @@ TEST_CASE(broadcast)
     }
 }
 
+TEST_CASE(cache_append_shape)
+{
+    migraphx::shape cache{migraphx::shape::float_type, {2, 4, 16, 8}};
+    migraphx::shape update{migraphx::shape::float_type, {2, 4, 1, 8}};
+    migraphx::shape pos{migraphx::shape::int64_type, {1}};
+    auto op = migraphx::make_op("cache_append", {{"axis", 2}});
+    expect_shape(cache, op, cache, update, pos);
+    expect_shape(cache, migraphx::make_op("cache_append", {{"axis", -2}}), cache, update, pos);
+    expect_shape(cache, op, cache, cache, pos);
+    throws_shape(op, cache, update);
+    throws_shape(op, cache, migraphx::shape{migraphx::shape::float_type, {2, 4, 17, 8}}, pos);
+    throws_shape(op, cache, migraphx::shape{migraphx::shape::float_type, {2, 3, 1, 8}}, pos);
+    throws_shape(op, cache, migraphx::shape{migraphx::shape::half_type, {2, 4, 1, 8}}, pos);
+    throws_shape(op, cache, update, migraphx::shape{migraphx::shape::int64_type, {2}});
+}
+
 TEST_CASE(convolution_shape)
 {
     migraphx::shape output{migraphx::shape::float_type, {4, 4, 1, 1}};
@@ -607,6 +623,34 @@ TEST_CASE(gru)
     }
 }
 
+TEST_CASE(im2col_shape)
+{
+    migraphx::shape input{migraphx::shape::float_type, {1, 3, 4, 4}};
+    migraphx::shape weights{migraphx::shape::float_type, {2, 3, 3, 3}};
+    expect_shape(migraphx::shape{migraphx::shape::float_type, {4, 27}},
+                 migraphx::make_op("im2col"),
+                 input,
+                 weights);
+
+    migraphx::shape input_batch{migraphx::shape::float_type, {2, 3, 4, 4}};
+    expect_shape(migraphx::shape{migraphx::shape::float_type, {32, 27}},
+                 migraphx::make_op("im2col", {{"padding", {1, 1}}}),
+                 input_batch,
+                 weights);
+
+    migraphx::shape input_3d{migraphx::shape::float_type, {2, 3, 4, 4, 4}};
+    migraphx::shape weights_3d{migraphx::shape::float_type, {2, 3, 3, 3, 3}};
+    expect_shape(
+        migraphx::shape{migraphx::shape::float_type, {16, 81}},
+        migraphx::make_op("im2col",
+                          {{"padding", {0, 0, 0}}, {"stride", {1, 1, 1}}, {"dilation", {1, 1, 1}}}),
+        input_3d,
+        weights_3d);
+
+    throws_shape(migraphx::make_op("im2col"), input_3d, weights_3d);
+    throws_shape(migraphx::make_op("im2col"), input);
+}
+
 TEST_CASE(inconsistent_attr_shape)
 {
     migraphx::shape input{migraphx::shape::float_type, {4, 3, 3, 3}};
@@ -654,6 +698,16 @@ void test_softmax_variations()
         throws_shape(T{axis}, input);
     }
 }
+TEST_CASE(layout_shape)
+{
+    migraphx::shape input{migraphx::shape::float_type, {2, 3, 4, 5}};
+    migraphx::shape nhwc{migraphx::shape::float_type, {2, 3, 4, 5}, {60, 1, 15, 3}};
+    expect_shape(nhwc, migraphx::make_op("layout", {{"permutation", {0, 2, 3, 1}}}), input);
+    expect_shape(input, migraphx::make_op("layout", {{"permutation", {0, 1, 2, 3}}}), nhwc);
+    throws_shape(migraphx::make_op("layout", {{"permutation", {0, 2, 1}}}), input);
+    throws_shape(migraphx::make_op("layout", {{"permutation", {0, 2, 2, 1}}}), input);
+}
+
 TEST_CASE(logsoftmax) { test_softmax_variations<migraphx::op::logsoftmax>(); }
 
 TEST_CASE(lstm)
@@ -1020,6 +1074,34 @@ TEST_CASE(multibroadcast)
     }
 }
 
+TEST_CASE(nms_shape)
+{
+    migraphx::shape boxes_s{migraphx::shape::float_type, {2, 6, 4}};
+    migraphx::shape scores_s{migraphx::shape::float_type, {2, 3, 6}};
+    migraphx::shape max_out_s{migraphx::shape::int64_type, {1}};
+    migraphx::shape threshold_s{migraphx::shape::float_type, {1}};
+    expect_shape(migraphx::shape{migraphx::shape::int64_type, {36, 3}},
+                 migraphx::make_op("nonmaxsuppression"),
+                 boxes_s,
+                 scores_s,
+                 max_out_s,
+                 threshold_s,
+                 threshold_s);
+
+    migraphx::shape scores_bad{migraphx::shape::float_type, {2, 3, 5}};
+    throws_shape(migraphx::make_op("nonmaxsuppression"), boxes_s, scores_bad);
+
+    migraphx::shape max_out_bad{migraphx::shape::int64_type, {2}};
+    throws_shape(migraphx::make_op("nonmaxsuppression"), boxes_s, scores_s, max_out_bad);
+}
+
+TEST_CASE(nonzero_shape)
+{
+    migraphx::shape input{migraphx::shape::float_type, {2, 3, 4}};
+    expect_shape(
+        migraphx::shape{migraphx::shape::int64_type, {3, 24}}, migraphx::make_op("nonzero"), input);
+}
+
 TEST_CASE(pooling_shape)
 {
     migraphx::shape output{migraphx::shape::float_type, {4, 3, 1, 1}};
@@ -1443,6 +1525,15 @@ TEST_CASE(test_argmax)
         migraphx::shape input{migraphx::shape::float_type, {2, 3, 4, 5}};
         throws_shape(migraphx::make_op("argmax", {{"axis", 4}}), input);
     }
+
+    {
+        migraphx::shape input{migraphx::shape::half_type, {2, 3, 4, 5}};
+        migraphx::shape indices{migraphx::shape::int64_type, {2, 3, 4, 1}};
+        migraphx::shape values{migraphx::shape::half_type, {2, 3, 4, 1}};
+        expect_shape(migraphx::shape({indices, values}),
+                     migraphx::make_op("argmax", {{"axis", 3}, {"output_value", true}}),
+                     input);
+    }
 }
 
 TEST_CASE(test_argmin)
@@ -1554,6 +1645,16 @@ TEST_CASE(test_unsqueeze_scalar_tensor2)
     throws_shape(migraphx::make_op("unsqueeze", {{"axes", {-2}}}), s);
 }
 
+TEST_CASE(topk_shape)
+{
+    migraphx::shape input{migraphx::shape::float_type, {2, 5, 3}};
+    migraphx::shape s{migraphx::shape::float_type, {2, 2, 3}};
+    migraphx::shape si{migraphx::shape::int64_type, {2, 2, 3}};
+    expect_shape(
+        migraphx::shape({s, si}), migraphx::make_op("topk", {{"k", 2}, {"axis", 1}}), input);
+    throws_shape(migraphx::make_op("topk", {{"k", 6}, {"axis", 1}}), input);
+}
+
 TEST_CASE(transpose_shape)
 {
     migraphx::shape input{migraphx::shape::float_type, {2, 2}};
@@ -231,6 +231,23 @@ TEST_CASE(check_from_value2)
     EXPECT(op1 == op2);
 }
 
+TEST_CASE(check_get_field)
+{
+    migraphx::operation op = simple_operation{3};
+    EXPECT(op.has_field("data"));
+    EXPECT(not op.has_field("???"));
+    EXPECT(op.get_field("data").to<int>() == 3);
+    EXPECT(op.get_field("data").get_key().empty());
+    EXPECT(test::throws([&] { op.get_field("???"); }));
+}
+
+TEST_CASE(check_get_field_empty)
+{
+    migraphx::operation op = simple_operation_no_print{};
+    EXPECT(not op.has_field("data"));
+    EXPECT(test::throws([&] { op.get_field("data"); }));
+}
+
 TEST_CASE(compile)
 {
     migraphx::operation op = compilable_op{};
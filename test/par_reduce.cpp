@@ -0,0 +1,172 @@
+#include <migraphx/par_reduce.hpp>
+#include <functional>
+#include <numeric>
+#include "test.hpp"
+
+migraphx::shape make_shape(std::vector<std::size_t> lens)
+{
+    return {migraphx::shape::float_type, std::move(lens)};
+}
+
+bool has_layout(const migraphx::optional<migraphx::reduce_layout>& layout,
+                std::size_t outer,
+                std::size_t reduce,
+                std::size_t inner)
+{
+    return layout and layout->outer == outer and layout->reduce == reduce and
+           layout->inner == inner;
+}
+
+migraphx::reduce_layout make_layout(std::size_t outer, std::size_t reduce, std::size_t inner)
+{
+    migraphx::reduce_layout l;
+    l.outer  = outer;
+    l.reduce = reduce;
+    l.inner  = inner;
+    return l;
+}
+
+// Runs the work one element at a time, as if each went to another thread
+void execute(std::size_t n, std::size_t, const std::function<void(std::size_t, std::size_t)>& f)
+{
+    for(std::size_t i = 0; i < n; i++)
+        f(i, i + 1);
+}
+
+std::vector<double>
+reduce_sum(const migraphx::reduce_layout& l, const std::vector<double>& x, std::size_t nthreads = 4)
+{
+    std::vector<double> result(l.outputs());
+    migraphx::par_reduce(
+        l,
+        nthreads,
+        &execute,
+        0.0,
+        [&](std::size_t i, std::size_t) { return x[i]; },
+        [](double a, double b) { return a + b; },
+        [&](std::size_t i, double acc) { result[i] = acc; });
+    return result;
+}
+
+std::vector<double> naive_sum(const migraphx::reduce_layout& l, const std::vector<double>& x)
+{
+    std::vector<double> result(l.outputs(), 0);
+    for(std::size_t o = 0; o < l.outer; o++)
+        for(std::size_t k = 0; k < l.reduce; k++)
+            for(std::size_t j = 0; j < l.inner; j++)
+                result[o * l.inner + j] += x[(o * l.reduce + k) * l.inner + j];
+    return result;
+}
+
+std::vector<double> make_data(std::size_t n)
+{
+    std::vector<double> result(n);
+    std::iota(result.begin(), result.end(), 0);
+    std::transform(result.begin(), result.end(), result.begin(), [](auto x) {
+        return static_cast<double>(static_cast<int>(x) % 13);
+    });
+    return result;
+}
+
+TEST_CASE(layout_innermost)
+{
+    auto layout = migraphx::find_reduce_layout(make_shape({2, 3, 4, 5}), {2, 3});
+    EXPECT(has_layout(layout, 6, 20, 1));
+}
+
+TEST_CASE(layout_outermost)
+{
+    auto layout = migraphx::find_reduce_layout(make_shape({2, 3, 4, 5}), {0});
+    EXPECT(has_layout(layout, 1, 2, 60));
+}
+
+TEST_CASE(layout_middle)
+{
+    auto layout = migraphx::find_reduce_layout(make_shape({2, 3, 4, 5}), {1, 2});
+    EXPECT(has_layout(layout, 2, 12, 5));
+}
+
+TEST_CASE(layout_all)
+{
+    auto layout = migraphx::find_reduce_layout(make_shape({2, 3, 4, 5}), {0, 1, 2, 3});
+    EXPECT(has_layout(layout, 1, 120, 1));
+}
+
+TEST_CASE(layout_unit_dim)
+{
+    auto layout = migraphx::find_reduce_layout(make_shape({2, 3, 1, 5}), {1, 3});
+    EXPECT(has_layout(layout, 2, 15, 1));
+}
+
+TEST_CASE(layout_split_axes)
+{
+    auto layout = migraphx::find_reduce_layout(make_shape({2, 3, 4, 5}), {0, 2});
+    EXPECT(not layout);
+}
+
+TEST_CASE(layout_transposed)
+{
+    migraphx::shape s{migraphx::shape::float_type, {2, 3}, {1, 2}};
+    auto layout = migraphx::find_reduce_layout(s, {1});
+    EXPECT(not layout);
+}
+
+TEST_CASE(reduce_contiguous)
+{
+    auto layout = make_layout(5, 37, 1);
+    auto x      = make_data(5 * 37);
+    EXPECT(reduce_sum(layout, x) == naive_sum(layout, x));
+}
+
+TEST_CASE(reduce_strided)
+{
+    auto layout = make_layout(3, 7, 150);
+    auto x      = make_data(3 * 7 * 150);
+    EXPECT(reduce_sum(layout, x) == naive_sum(layout, x));
+}
+
+TEST_CASE(reduce_long_contiguous)
+{
+    auto layout = make_layout(1, 100003, 1);
+    auto x      = make_data(100003);
+    EXPECT(reduce_sum(layout, x) == naive_sum(layout, x));
+}
+
+TEST_CASE(reduce_long_strided)
+{
+    auto layout = make_layout(1, 50001, 3);
+    auto x      = make_data(50001 * 3);
+    EXPECT(reduce_sum(layout, x) == naive_sum(layout, x));
+}
+
+TEST_CASE(reduce_long_single_thread)
+{
+    auto layout = make_layout(1, 100003, 1);
+    auto x      = make_data(100003);
+    EXPECT(reduce_sum(layout, x, 1) == naive_sum(layout, x));
+}
+
+TEST_CASE(reduce_no_outputs)
+{
+    for(auto layout : {make_layout(0, 5, 3), make_layout(2, 5, 0)})
+    {
+        bool called = false;
+        migraphx::par_reduce(
+            layout,
+            4,
+            [&](std::size_t, std::size_t, auto) { called = true; },
+            0.0,
+            [](std::size_t, std::size_t) { return 1.0; },
+            [](double a, double b) { return a + b; },
+            [&](std::size_t, double) { called = true; });
+        EXPECT(not called);
+    }
+}
+
+TEST_CASE(reduce_empty_axis)
+{
+    auto layout = make_layout(2, 0, 3);
+    EXPECT(reduce_sum(layout, {}) == std::vector<double>(6, 0));
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
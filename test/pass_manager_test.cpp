@@ -0,0 +1,196 @@
+#include <migraphx/pass_manager.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/errors.hpp>
+#include <migraphx/dead_code_elimination.hpp>
+#include <migraphx/propagate_constant.hpp>
+#include <migraphx/simplify_algebra.hpp>
+#include <migraphx/float_equal.hpp>
+#include <migraphx/ref/target.hpp>
+#include <sstream>
+#include "test.hpp"
+
+static migraphx::program create_program()
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape s{migraphx::shape::float_type, {2, 3}};
+    auto x    = mm->add_parameter("x", s);
+    auto one  = mm->add_literal(migraphx::literal{s, std::vector<float>(6, 1)});
+    auto two  = mm->add_literal(migraphx::literal{s, std::vector<float>(6, 2)});
+    auto sum  = mm->add_instruction(migraphx::make_op("add"), one, two);
+    auto add1 = mm->add_instruction(migraphx::make_op("add"), x, one);
+    auto add2 = mm->add_instruction(migraphx::make_op("add"), add1, two);
+    mm->add_instruction(migraphx::make_op("mul"), add2, sum);
+    return p;
+}
+
+static const migraphx::pass_stats& get_stats(const migraphx::pass_statistics& stats,
+                                             const std::string& name)
+{
+    const auto& s = stats.get_stats();
+    return *std::find_if(s.begin(), s.end(), [&](const auto& x) { return x.pass == name; });
+}
+
+TEST_CASE(pass_stats_module)
+{
+    auto p   = create_program();
+    auto* mm = p.get_main_module();
+    migraphx::pass_statistics stats;
+    migraphx::run_passes(*mm,
+                         {migraphx::simplify_algebra{},
+                          migraphx::dead_code_elimination{},
+                          migraphx::propagate_constant{},
+                          migraphx::dead_code_elimination{}},
+                         migraphx::tracer{},
+                         &stats);
+    EXPECT(stats.get_stats().size() == 3);
+
+    // (x + 1) + 2 is rewritten as x + (1 + 2)
+    const auto& algebra = get_stats(stats, "simplify_algebra");
+    EXPECT(algebra.module == "main");
+    EXPECT(algebra.runs == 1);
+    EXPECT(algebra.matches > 0);
+
+    const auto& dce = get_stats(stats, "dead_code_elimination");
+    EXPECT(dce.runs == 2);
+    EXPECT(dce.instructions < 0);
+
+    const auto& pc = get_stats(stats, "propagate_constant");
+    EXPECT(pc.matches == 0);
+    EXPECT(pc.literal_bytes > 0);
+}
+
+TEST_CASE(pass_stats_compile)
+{
+    auto p = create_program();
+    migraphx::pass_statistics stats;
+    migraphx::compile_options options;
+    options.pass_stats = &stats;
+    p.compile(migraphx::ref::target{}, options);
+    EXPECT(not stats.get_stats().empty());
+    EXPECT(std::any_of(stats.get_stats().begin(), stats.get_stats().end(), [](const auto& s) {
+        return s.module == "@program";
+    }));
+
+    auto totals = stats.get_pass_totals();
+    EXPECT(totals.size() <= stats.get_stats().size());
+    EXPECT(std::all_of(totals.begin(), totals.end(), [](const auto& s) { return s.runs > 0; }));
+
+    auto v = stats.to_value();
+    EXPECT(v.contains("total_ms"));
+    EXPECT(v.at("passes").size() == totals.size());
+    EXPECT(v.at("modules").size() == stats.get_stats().size());
+
+    std::stringstream ss;
+    stats.print(ss);
+    EXPECT(ss.str().find("Total passes time") != std::string::npos);
+}
+
+TEST_CASE(pass_stats_add)
+{
+    migraphx::pass_statistics stats;
+    stats.add({"a", "main", 1, 2.0, -3, 4, 5});
+    stats.add({"b", "main", 1, 1.0, 0, 0, 0});
+    stats.add({"a", "main", 1, 2.0, -3, 4, 5});
+    stats.add({"a", "sub", 1, 1.0, 1, 0, 0});
+    EXPECT(stats.get_stats().size() == 3);
+    const auto& a = stats.get_stats().front();
+    EXPECT(a.runs == 2);
+    EXPECT(a.instructions == -6);
+    EXPECT(a.literal_bytes == 8);
+    EXPECT(a.matches == 10);
+    auto totals = stats.get_pass_totals();
+    EXPECT(totals.size() == 2);
+    EXPECT(totals.front().runs == 3);
+    EXPECT(totals.front().instructions == -5);
+    EXPECT(migraphx::float_equal(stats.total_ms(), 6.0));
+}
+
+// The branches use their own parameters, or the parameter of the main module
+static migraphx::program create_if_program(bool use_main)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape cond_s{migraphx::shape::bool_type};
+    migraphx::shape s{migraphx::shape::float_type, {2, 3}};
+    auto cond      = mm->add_parameter("cond", cond_s);
+    auto x         = mm->add_parameter("x", s);
+    auto add_block = [&](const std::string& name, float a, float b) {
+        auto* smod = p.create_module(name);
+        auto sx    = use_main ? x : smod->add_parameter("x", s);
+        auto la    = smod->add_literal(migraphx::literal{s, std::vector<float>(6, a)});
+        auto lb    = smod->add_literal(migraphx::literal{s, std::vector<float>(6, b)});
+        auto add1  = smod->add_instruction(migraphx::make_op("add"), sx, la);
+        auto add2  = smod->add_instruction(migraphx::make_op("add"), add1, lb);
+        auto sum   = smod->add_instruction(migraphx::make_op("add"), la, lb);
+        smod->add_return({smod->add_instruction(migraphx::make_op("mul"), add2, sum)});
+        return smod;
+    };
+    auto* then_mod = add_block("then", 1, 2);
+    auto* else_mod = add_block("else", 3, 4);
+    auto ret = mm->add_instruction(migraphx::make_op("if"), {cond}, {then_mod, else_mod});
+    auto r   = mm->add_instruction(migraphx::make_op("get_tuple_elem", {{"index", 0}}), ret);
+    mm->add_return({r});
+    return p;
+}
+
+static std::vector<std::string> get_names(const migraphx::pass_statistics& stats)
+{
+    std::vector<std::string> result;
+    for(const auto& s : stats.get_stats())
+        result.push_back(s.pass + ":" + s.module);
+    return result;
+}
+
+TEST_CASE(pass_parallel_modules)
+{
+    std::vector<migraphx::pass> passes = {migraphx::simplify_algebra{},
+                                          migraphx::dead_code_elimination{},
+                                          migraphx::propagate_constant{},
+                                          migraphx::dead_code_elimination{}};
+    for(bool use_main : {false, true})
+    {
+        auto p1 = create_if_program(use_main);
+        migraphx::pass_statistics stats1;
+        migraphx::run_passes(p1, passes, migraphx::tracer{}, &stats1);
+
+        auto p2 = create_if_program(use_main);
+        migraphx::pass_statistics stats2;
+        migraphx::run_passes(p2, passes, migraphx::tracer{}, &stats2, true);
+        EXPECT(p1 == p2);
+
+        auto p3 = create_if_program(use_main);
+        migraphx::pass_statistics stats3;
+        migraphx::run_passes(p3, passes, migraphx::tracer{}, &stats3, true);
+        EXPECT(get_names(stats2) == get_names(stats3));
+
+        auto names1 = get_names(stats1);
+        auto names2 = get_names(stats2);
+        std::sort(names1.begin(), names1.end());
+        std::sort(names2.begin(), names2.end());
+        EXPECT(names1 == names2);
+    }
+}
+
+struct throw_pass
+{
+    std::string name() const { return "throw_pass"; }
+    void apply(migraphx::module& m) const
+    {
+        if(m.name() != "main")
+            MIGRAPHX_THROW("Failed on " + m.name());
+    }
+};
+
+TEST_CASE(pass_parallel_error)
+{
+    // The error of the module that would run first is the one thrown
+    auto p = create_if_program(false);
+    EXPECT(test::throws<migraphx::exception>(
+        [&] { migraphx::run_passes(p, {throw_pass{}}, migraphx::tracer{}, nullptr, true); },
+        "Failed on else"));
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -0,0 +1,130 @@
+#include <migraphx/pipeline.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/ref/target.hpp>
+#include <migraphx/stringutils.hpp>
+#include <sstream>
+#include <vector>
+#include "test.hpp"
+
+static migraphx::program create_program()
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape s{migraphx::shape::float_type, {4, 8}};
+    auto x  = mm->add_parameter("x", s);
+    auto w1 = mm->add_literal(migraphx::generate_literal({migraphx::shape::float_type, {8, 8}}, 1));
+    auto w2 = mm->add_literal(migraphx::generate_literal({migraphx::shape::float_type, {8, 8}}, 2));
+    auto d1 = mm->add_instruction(migraphx::make_op("dot"), x, w1);
+    auto r1 = mm->add_instruction(migraphx::make_op("relu"), d1);
+    auto d2 = mm->add_instruction(migraphx::make_op("dot"), r1, w2);
+    // x is used again by the last stage
+    auto a  = mm->add_instruction(migraphx::make_op("add"), d2, x);
+    auto r2 = mm->add_instruction(migraphx::make_op("tanh"), a);
+    auto d3 = mm->add_instruction(migraphx::make_op("dot"), r2, w1);
+    mm->add_return({d3, r1});
+    return p;
+}
+
+static std::vector<migraphx::target> ref_targets(std::size_t n)
+{
+    return std::vector<migraphx::target>(n, migraphx::ref::target{});
+}
+
+static void run_pipeline(std::size_t stages, std::size_t batches)
+{
+    auto p = create_program();
+    migraphx::pipeline pl{p, ref_targets(stages)};
+    EXPECT(pl.size() == stages);
+
+    auto gold_p = p;
+    gold_p.compile(migraphx::ref::target{});
+    std::vector<migraphx::argument> inputs;
+    for(std::size_t i = 0; i < batches; i++)
+        inputs.push_back(migraphx::generate_argument(p.get_parameter_shape("x"), i));
+
+    std::size_t read    = 0;
+    std::size_t written = 0;
+    auto n              = pl.run(
+        [&](migraphx::parameter_map& params) {
+            if(read == inputs.size())
+                return false;
+            params["x"] = inputs[read++];
+            return true;
+        },
+        [&](const std::vector<migraphx::argument>& outputs) {
+            auto gold = gold_p.eval({{"x", inputs[written++]}});
+            EXPECT(outputs.size() == 2);
+            EXPECT(outputs == gold);
+        });
+    EXPECT(n == batches);
+    EXPECT(written == batches);
+
+    auto stats = pl.get_stats();
+    EXPECT(stats.size() == stages);
+    EXPECT(std::all_of(stats.begin(), stats.end(), [&](const auto& s) {
+        return s.runs == batches and s.instructions > 0 and s.utilization() <= 1;
+    }));
+}
+
+TEST_CASE(pipeline_one_stage) { run_pipeline(1, 5); }
+
+TEST_CASE(pipeline_two_stages) { run_pipeline(2, 7); }
+
+TEST_CASE(pipeline_three_stages) { run_pipeline(3, 9); }
+
+TEST_CASE(pipeline_more_stages_than_instructions)
+{
+    auto p = create_program();
+    migraphx::pipeline pl{p, ref_targets(20)};
+    EXPECT(pl.size() == 6);
+}
+
+TEST_CASE(pipeline_balanced)
+{
+    // The dots cost the most, so each stage should get one of them
+    auto p = create_program();
+    migraphx::pipeline pl{p, ref_targets(3)};
+    for(std::size_t s = 0; s < pl.size(); s++)
+    {
+        const auto* mm = pl.get_stage(s).get_main_module();
+        EXPECT(std::count_if(mm->begin(), mm->end(), [](const auto& ins) {
+                   return migraphx::ends_with(ins.name(), "dot");
+               }) == 1);
+    }
+}
+
+TEST_CASE(pipeline_error)
+{
+    auto p = create_program();
+    migraphx::pipeline pl{p, ref_targets(2)};
+    std::size_t read = 0;
+    EXPECT(test::throws([&] {
+        pl.run(
+            [&](migraphx::parameter_map& params) {
+                if(read++ == 3)
+                    throw std::runtime_error("Read failed");
+                params["x"] = migraphx::generate_argument(p.get_parameter_shape("x"));
+                return true;
+            },
+            [](const std::vector<migraphx::argument>&) {});
+    }));
+    // A missing parameter fails in the first stage
+    EXPECT(test::throws([&] {
+        pl.run([](migraphx::parameter_map&) { return true; },
+               [](const std::vector<migraphx::argument>&) {});
+    }));
+}
+
+TEST_CASE(pipeline_print_stats)
+{
+    auto p = create_program();
+    migraphx::pipeline pl{p, ref_targets(2)};
+    std::stringstream ss;
+    pl.print_stats(ss);
+    EXPECT(ss.str().find("Stage 1") != std::string::npos);
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -173,4 +173,85 @@ TEST_CASE(program_copy)
     }
 }
 
+migraphx::program create_cache_program()
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+
+    migraphx::shape s{migraphx::shape::float_type, {1, 4}};
+    auto cache = mm->add_parameter("cache", s);
+    auto x     = mm->add_parameter("x", {migraphx::shape::float_type, {1, 1}});
+    auto pos   = mm->add_parameter("pos", {migraphx::shape::int64_type, {1}});
+    mm->add_instruction(migraphx::make_op("cache_append", {{"axis", 1}}), cache, x, pos);
+    p.add_state("cache");
+
+    return p;
+}
+
+std::vector<float> append_cache(const migraphx::program& p, float x, int64_t pos)
+{
+    migraphx::parameter_map params;
+    params["x"]   = migraphx::argument{{migraphx::shape::float_type, {1, 1}}, &x};
+    params["pos"] = migraphx::argument{{migraphx::shape::int64_type, {1}}, &pos};
+    auto result   = p.eval(params).back();
+    std::vector<float> v;
+    result.visit([&](auto output) { v.assign(output.begin(), output.end()); });
+    return v;
+}
+
+std::vector<float> read_state(const migraphx::program& p, const std::string& name)
+{
+    std::vector<float> v;
+    p.get_state(name).visit([&](auto output) { v.assign(output.begin(), output.end()); });
+    return v;
+}
+
+TEST_CASE(program_state)
+{
+    auto p = create_cache_program();
+    p.compile(migraphx::ref::target{});
+    EXPECT(p.get_state_names() == std::vector<std::string>{"cache"});
+    EXPECT(read_state(p, "cache") == std::vector<float>{0, 0, 0, 0});
+
+    EXPECT(append_cache(p, 1, 0) == std::vector<float>{1, 0, 0, 0});
+    EXPECT(append_cache(p, 2, 1) == std::vector<float>{1, 2, 0, 0});
+    EXPECT(read_state(p, "cache") == std::vector<float>{1, 2, 0, 0});
+    EXPECT(test::throws([&] { append_cache(p, 3, 4); }));
+
+    p.reset_states();
+    EXPECT(read_state(p, "cache") == std::vector<float>{0, 0, 0, 0});
+
+    std::vector<float> data = {4, 3, 2, 1};
+    p.set_state("cache", migraphx::argument{{migraphx::shape::float_type, {1, 4}}, data.data()});
+    EXPECT(append_cache(p, 5, 3) == std::vector<float>{4, 3, 2, 5});
+    EXPECT(test::throws([&] { p.set_state("cache", migraphx::argument{}); }));
+}
+
+TEST_CASE(program_state_copy)
+{
+    auto p1 = create_cache_program();
+    append_cache(p1, 1, 0);
+    auto p2 = p1;
+    append_cache(p2, 2, 1);
+    EXPECT(read_state(p1, "cache") == std::vector<float>{1, 0, 0, 0});
+    EXPECT(read_state(p2, "cache") == std::vector<float>{1, 2, 0, 0});
+}
+
+TEST_CASE(program_state_value)
+{
+    auto p1 = create_cache_program();
+    append_cache(p1, 1, 0);
+    migraphx::program p2;
+    p2.from_value(p1.to_value());
+    EXPECT(p2.get_state_names() == std::vector<std::string>{"cache"});
+    EXPECT(read_state(p2, "cache") == std::vector<float>{0, 0, 0, 0});
+}
+
+TEST_CASE(program_state_missing)
+{
+    migraphx::program p;
+    EXPECT(test::throws([&] { p.add_state("x"); }));
+    EXPECT(test::throws([&] { p.get_state("x"); }));
+}
+
 int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -20,6 +20,60 @@ def test_conv_relu():
     print(r)
 
 
+def test_run_async():
+    p = migraphx.parse_onnx("conv_relu_maxpool_test.onnx")
+    p.compile(migraphx.get_target("ref"))
+    params = {}
+    for key, value in p.get_parameter_shapes().items():
+        params[key] = migraphx.generate_argument(value)
+
+    r1 = p.run(params)[-1]
+    f = p.run_async(params)
+    r2 = f.result()[-1]
+    assert f.done()
+    assert r1 == r2
+
+    pm = migraphx.parameters(params)
+    assert len(pm) == len(params)
+    r3 = p.run(pm)[-1]
+    assert r1 == r3
+    r4 = p.run_async(pm).result()[-1]
+    assert r1 == r4
+
+
+def test_run_outputs():
+    p = migraphx.parse_onnx("conv_relu_maxpool_test.onnx")
+    p.compile(migraphx.get_target("ref"))
+    params = {}
+    for key, value in p.get_parameter_shapes().items():
+        params[key] = migraphx.generate_argument(value)
+
+    r1 = p.run(params)[-1]
+    outputs = [
+        migraphx.generate_argument(s, 1) for s in p.get_output_shapes()
+    ]
+    r2 = p.run(params, outputs=outputs)[-1]
+    assert r1 == r2
+    assert r1 == outputs[-1]
+
+
+def test_run_results():
+    p = migraphx.parse_onnx("conv_relu_maxpool_test.onnx")
+    p.compile(migraphx.get_target("ref"))
+    params1 = {}
+    params2 = {}
+    for key, value in p.get_parameter_shapes().items():
+        params1[key] = migraphx.generate_argument(value, 1)
+        params2[key] = migraphx.generate_argument(value, 2)
+
+    # The results of a run are not changed by the runs after it
+    r1 = p.run(params1)[-1]
+    gold = r1.tolist()
+    r2 = p.run_async(params2).result()[-1]
+    assert r1.tolist() == gold
+    assert r1 != r2
+
+
 def create_buffer(t, data, shape):
     a = array.array(t, data)
     if sys.version_info >= (3, 0):
@@ -61,6 +115,9 @@ def test_module():
 
 
 test_conv_relu()
+test_run_async()
+test_run_outputs()
+test_run_results()
 test_module()
 if sys.version_info >= (3, 0):
     test_add_scalar()
@@ -212,6 +212,55 @@ TEST_CASE(argmax_test_neg_2)
     EXPECT(migraphx::verify_range(result_vec, res_gold));
 }
 
+TEST_CASE(argmax_test_long_axis)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape data_shape{migraphx::shape::float_type, {2, 50000}};
+    std::vector<float> data(data_shape.elements(), 0);
+    // The max of each row appears twice, and the first one is expected
+    data[31234] = 3;
+    data[40001] = 3;
+    data[50007] = 5;
+    data[99999] = 5;
+    auto dl = mm->add_literal(migraphx::literal{data_shape, data});
+    mm->add_instruction(migraphx::make_op("argmax", {{"axis", 1}}), dl);
+    p.compile(migraphx::ref::target{});
+    auto result = p.eval({}).back();
+    std::vector<int64_t> result_vec;
+    result.visit([&](auto output) { result_vec.assign(output.begin(), output.end()); });
+    std::vector<int64_t> res_gold = {31234, 7};
+
+    EXPECT(migraphx::verify_range(result_vec, res_gold));
+}
+
+TEST_CASE(argmax_test_value)
+{
+    migraphx::program p;
+    auto* mm                = p.get_main_module();
+    std::vector<float> data = {1.2255,  1.6834,  -2.0305, -0.3221, 0.4701,  0.2583, 0.7545, 2.5758,
+                               -1.6849, 0.0928,  0.9022,  -0.8765, -0.4090, 0.9301, 2.0724, -1.5706,
+                               0.4867,  -0.1493, 0.6957,  -0.2179, 0.7142,  0.7177, 0.0183, 1.3497};
+    std::vector<int64_t> indices_gold = {1, 3, 2, 2, 2, 3};
+    std::vector<float> values_gold    = {1.6834, 2.5758, 0.9022, 2.0724, 0.6957, 1.3497};
+    migraphx::shape data_shape{migraphx::shape::float_type, {2, 3, 4}};
+    auto dl = mm->add_literal(migraphx::literal{data_shape, data});
+    auto r  = mm->add_instruction(
+        migraphx::make_op("argmax", {{"axis", 2}, {"output_value", true}}), dl);
+    auto indices = mm->add_instruction(migraphx::make_op("get_tuple_elem", {{"index", 0}}), r);
+    auto values  = mm->add_instruction(migraphx::make_op("get_tuple_elem", {{"index", 1}}), r);
+    mm->add_return({indices, values});
+    p.compile(migraphx::ref::target{});
+    auto results = p.eval({});
+    std::vector<int64_t> indices_vec;
+    results[0].visit([&](auto output) { indices_vec.assign(output.begin(), output.end()); });
+    std::vector<float> values_vec;
+    results[1].visit([&](auto output) { values_vec.assign(output.begin(), output.end()); });
+
+    EXPECT(migraphx::verify_range(indices_vec, indices_gold));
+    EXPECT(migraphx::verify_range(values_vec, values_gold));
+}
+
 TEST_CASE(argmin_test_0)
 {
     migraphx::program p;
@@ -1870,6 +1919,50 @@ TEST_CASE(if_pl_test)
     }
 }
 
+TEST_CASE(if_shared_module_test)
+{
+    // The same submodule is run by two instructions in one evaluation
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape cond_s{migraphx::shape::bool_type};
+    migraphx::shape s{migraphx::shape::float_type, {3}};
+    auto cond = mm->add_parameter("cond", cond_s);
+    auto x    = mm->add_parameter("x", s);
+    auto y    = mm->add_parameter("y", s);
+
+    auto* smod = p.create_module("If_0_if");
+    auto sx    = smod->add_parameter("x", s);
+    auto sa    = smod->add_instruction(migraphx::make_op("add"), sx, sx);
+    smod->add_return({sa});
+
+    auto if1 = mm->add_instruction(migraphx::make_op("if"), {cond, x}, {smod, smod});
+    auto r1  = mm->add_instruction(migraphx::make_op("get_tuple_elem", {{"index", 0}}), if1);
+    auto if2 = mm->add_instruction(migraphx::make_op("if"), {cond, y}, {smod, smod});
+    auto r2  = mm->add_instruction(migraphx::make_op("get_tuple_elem", {{"index", 0}}), if2);
+    mm->add_return({r1, r2});
+    p.compile(migraphx::ref::target());
+
+    auto run_prog = [&](bool c, float a, float b) {
+        std::vector<char> c_data = {static_cast<char>(c)};
+        std::vector<float> data_x(s.elements(), a);
+        std::vector<float> data_y(s.elements(), b);
+        migraphx::parameter_map m;
+        m["cond"] = migraphx::argument(cond_s, c_data.data());
+        m["x"]    = migraphx::argument(s, data_x.data());
+        m["y"]    = migraphx::argument(s, data_y.data());
+        auto res  = p.eval(m);
+        std::vector<float> ret;
+        for(const auto& r : res)
+            r.visit([&](auto v) { ret.insert(ret.end(), v.begin(), v.end()); });
+        return ret;
+    };
+
+    std::vector<float> gold1 = {2, 2, 2, 6, 6, 6};
+    EXPECT(run_prog(true, 1, 3) == gold1);
+    std::vector<float> gold2 = {10, 10, 10, 4, 4, 4};
+    EXPECT(run_prog(false, 5, 2) == gold2);
+}
+
 TEST_CASE(im2col_3x3_no_pad_identity_test)
 {
     std::size_t f[2]    = {3, 3};
@@ -2050,6 +2143,70 @@ TEST_CASE(im2col_3x3_with_padding_test)
     EXPECT(migraphx::verify_range(results_vector, correct));
 }
 
+TEST_CASE(im2col_3x3_batch_padding_test)
+{
+    std::size_t f[2]    = {3, 3};
+    std::size_t size[2] = {2, 2};
+    std::vector<std::size_t> padding{1, 1};
+    std::vector<std::size_t> stride{1, 1};
+    std::vector<std::size_t> dilation{1, 1};
+    std::size_t channels = 1;
+    std::size_t batch    = 2;
+
+    std::vector<int32_t> weights(channels * f[0] * f[1]);
+    std::vector<int32_t> input(batch * channels * size[0] * size[1]);
+    std::iota(input.begin(), input.end(), 0);
+
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape s_image{migraphx::shape::int32_type, {batch, channels, size[0], size[1]}};
+    migraphx::shape s_weights{migraphx::shape::int32_type, {1, channels, f[0], f[1]}};
+    auto l_image   = mm->add_literal(migraphx::literal{s_image, input});
+    auto l_weights = mm->add_literal(migraphx::literal{s_weights, weights});
+    mm->add_instruction(
+        migraphx::make_op("im2col",
+                          {{"padding", padding}, {"stride", stride}, {"dilation", dilation}}),
+        l_image,
+        l_weights);
+    p.compile(migraphx::ref::target{});
+    auto result = p.eval({}).back();
+
+    std::vector<int> correct = {0, 0, 0, 0, 0, 1, 0, 2, 3, 0, 0, 0, 0, 1, 0, 2, 3, 0,
+                                0, 0, 1, 0, 2, 3, 0, 0, 0, 0, 1, 0, 2, 3, 0, 0, 0, 0,
+                                0, 0, 0, 0, 4, 5, 0, 6, 7, 0, 0, 0, 4, 5, 0, 6, 7, 0,
+                                0, 4, 5, 0, 6, 7, 0, 0, 0, 4, 5, 0, 6, 7, 0, 0, 0, 0};
+
+    std::vector<float> results_vector;
+    result.visit([&](auto output) { results_vector.assign(output.begin(), output.end()); });
+    EXPECT(migraphx::verify_range(results_vector, correct));
+}
+
+TEST_CASE(im2col_1d_dilation_test)
+{
+    std::vector<int32_t> weights(2 * 2);
+    std::vector<int32_t> input(2 * 5);
+    std::iota(input.begin(), input.end(), 1);
+
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape s_image{migraphx::shape::int32_type, {1, 2, 5}};
+    migraphx::shape s_weights{migraphx::shape::int32_type, {1, 2, 2}};
+    auto l_image   = mm->add_literal(migraphx::literal{s_image, input});
+    auto l_weights = mm->add_literal(migraphx::literal{s_weights, weights});
+    mm->add_instruction(
+        migraphx::make_op("im2col", {{"padding", {1}}, {"stride", {2}}, {"dilation", {2}}}),
+        l_image,
+        l_weights);
+    p.compile(migraphx::ref::target{});
+    auto result = p.eval({}).back();
+
+    std::vector<int> correct = {0, 2, 0, 7, 2, 4, 7, 9, 4, 0, 9, 0};
+
+    std::vector<float> results_vector;
+    result.visit([&](auto output) { results_vector.assign(output.begin(), output.end()); });
+    EXPECT(migraphx::verify_range(results_vector, correct));
+}
+
 TEST_CASE(imagescaler_test)
 {
     migraphx::program p;
@@ -2389,6 +2546,127 @@ TEST_CASE(logsoftmax_test_axis_3)
     EXPECT(migraphx::verify_range(results_vector, s));
 }
 
+TEST_CASE(loop_test)
+{
+    auto create_program = [](int64_t max_iterations) {
+        migraphx::program p;
+        auto* mm = p.get_main_module();
+        migraphx::shape ts{migraphx::shape::int64_type};
+        migraphx::shape cs{migraphx::shape::bool_type};
+        migraphx::shape s{migraphx::shape::float_type, {2}};
+        auto trip = mm->add_parameter("trip", ts);
+        auto cond = mm->add_parameter("cond", cs);
+        auto a    = mm->add_parameter("a", s);
+        auto x    = mm->add_parameter("x", s);
+
+        // Accumulate x into a, stopping after the iteration where iter reaches 2
+        auto* body = p.create_module("Loop_0_loop");
+        auto iter  = body->add_parameter("#loop_iter", ts);
+        body->add_parameter("#loop_cond", cs);
+        auto ba   = body->add_parameter("#loop_dep0", s);
+        auto two  = body->add_literal(migraphx::literal{ts, {2}});
+        auto next = body->add_instruction(migraphx::make_op("less"), iter, two);
+        auto sum  = body->add_instruction(migraphx::make_op("add"), ba, x);
+        body->add_return({next, sum, sum});
+
+        auto loop = mm->add_instruction(
+            migraphx::make_op("loop", {{"max_iterations", max_iterations}}),
+            {trip, cond, a},
+            {body});
+
+        auto r0 = mm->add_instruction(migraphx::make_op("get_tuple_elem", {{"index", 0}}), loop);
+        auto r1 = mm->add_instruction(migraphx::make_op("get_tuple_elem", {{"index", 1}}), loop);
+        mm->add_return({r0, r1});
+        return p;
+    };
+
+    auto run_prog = [&](int64_t max_iterations, int64_t trip, bool cond) {
+        auto p = create_program(max_iterations);
+        p.compile(migraphx::ref::target());
+        migraphx::shape s{migraphx::shape::float_type, {2}};
+        std::vector<char> c_data  = {static_cast<char>(cond)};
+        std::vector<float> data_a = {0, 10};
+        std::vector<float> data_x = {1, 2};
+        migraphx::parameter_map m;
+        m["trip"] = migraphx::argument(migraphx::shape{migraphx::shape::int64_type}, &trip);
+        m["cond"] = migraphx::argument(migraphx::shape{migraphx::shape::bool_type}, c_data.data());
+        m["a"]    = migraphx::argument(s, data_a.data());
+        m["x"]    = migraphx::argument(s, data_x.data());
+        auto res  = p.eval(m);
+        std::vector<std::vector<float>> ret(res.size());
+        for(std::size_t i = 0; i < res.size(); i++)
+            res[i].visit([&](auto v) { ret[i].assign(v.begin(), v.end()); });
+        return ret;
+    };
+
+    // Stopped by the trip count, the last scan row is left as zeros
+    {
+        auto ret = run_prog(4, 2, true);
+        EXPECT(ret[0] == std::vector<float>{2, 14});
+        EXPECT(ret[1] == std::vector<float>{1, 12, 2, 14, 0, 0, 0, 0});
+    }
+
+    // Stopped by the condition returned from the body
+    {
+        auto ret = run_prog(5, 10, true);
+        EXPECT(ret[0] == std::vector<float>{3, 16});
+        EXPECT(ret[1] == std::vector<float>{1, 12, 2, 14, 3, 16, 0, 0, 0, 0});
+    }
+
+    // Never runs
+    {
+        auto ret = run_prog(2, 10, false);
+        EXPECT(ret[0] == std::vector<float>{0, 10});
+        EXPECT(ret[1] == std::vector<float>{0, 0, 0, 0});
+    }
+
+    // Stopped by the condition at exactly max_iterations
+    {
+        auto ret = run_prog(3, std::numeric_limits<int64_t>::max(), true);
+        EXPECT(ret[0] == std::vector<float>{3, 16});
+    }
+
+    // The loop would run past max_iterations, so it throws instead of stopping early
+    EXPECT(test::throws([&] { run_prog(2, 10, true); }));
+    EXPECT(test::throws([&] { run_prog(2, std::numeric_limits<int64_t>::max(), true); }));
+}
+
+TEST_CASE(loop_swap_test)
+{
+    // Each iteration swaps the two loop carried dependencies
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape ts{migraphx::shape::int64_type};
+    migraphx::shape cs{migraphx::shape::bool_type};
+    migraphx::shape s{migraphx::shape::float_type, {3}};
+    auto trip = mm->add_literal(migraphx::literal{ts, {3}});
+    auto cond = mm->add_literal(migraphx::literal{cs, {true}});
+    auto a    = mm->add_literal(migraphx::literal{s, {1, 2, 3}});
+    auto b    = mm->add_literal(migraphx::literal{s, {4, 5, 6}});
+
+    auto* body = p.create_module("Loop_0_loop");
+    body->add_parameter("#loop_iter", ts);
+    auto bcond = body->add_parameter("#loop_cond", cs);
+    auto ba    = body->add_parameter("#loop_dep0", s);
+    auto bb    = body->add_parameter("#loop_dep1", s);
+    body->add_return({bcond, bb, ba});
+
+    auto loop = mm->add_instruction(
+        migraphx::make_op("loop", {{"max_iterations", 3}}), {trip, cond, a, b}, {body});
+    auto r0   = mm->add_instruction(migraphx::make_op("get_tuple_elem", {{"index", 0}}), loop);
+    auto r1   = mm->add_instruction(migraphx::make_op("get_tuple_elem", {{"index", 1}}), loop);
+    mm->add_return({r0, r1});
+    p.compile(migraphx::ref::target());
+
+    auto res = p.eval({});
+    std::vector<float> ret0;
+    std::vector<float> ret1;
+    res[0].visit([&](auto v) { ret0.assign(v.begin(), v.end()); });
+    res[1].visit([&](auto v) { ret1.assign(v.begin(), v.end()); });
+    EXPECT(ret0 == std::vector<float>{4, 5, 6});
+    EXPECT(ret1 == std::vector<float>{1, 2, 3});
+}
+
 TEST_CASE(lrn_test)
 {
     migraphx::program p;
@@ -2655,6 +2933,103 @@ TEST_CASE(neg_test)
     EXPECT(migraphx::verify_range(result_vector, gold));
 }
 
+TEST_CASE(nms_test)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape boxes_s{migraphx::shape::float_type, {1, 6, 4}};
+    migraphx::shape scores_s{migraphx::shape::float_type, {1, 1, 6}};
+    auto boxes_l  = mm->add_parameter("boxes", boxes_s);
+    auto scores_l = mm->add_parameter("scores", scores_s);
+    auto max_out_l =
+        mm->add_literal(migraphx::literal{migraphx::shape{migraphx::shape::int64_type}, {3}});
+    auto iou_threshold =
+        mm->add_literal(migraphx::literal{migraphx::shape{migraphx::shape::float_type}, {0.5f}});
+    auto score_threshold =
+        mm->add_literal(migraphx::literal{migraphx::shape{migraphx::shape::float_type}, {0.0f}});
+    auto r = mm->add_instruction(migraphx::make_op("nonmaxsuppression"),
+                                 boxes_l,
+                                 scores_l,
+                                 max_out_l,
+                                 iou_threshold,
+                                 score_threshold);
+    mm->add_return({r});
+    p.compile(migraphx::ref::target{});
+
+    // The corners of the second and third boxes are given in the other order
+    std::vector<float> boxes_vec  = {0.0, 0.0,  1.0, 1.0,  0.0, 0.1,   1.0, 1.1,
+                                    1.0, 0.9,  0.0, -0.1, 0.0, 10.0,  1.0, 11.0,
+                                    0.0, 10.1, 1.0, 11.1, 0.0, 100.0, 1.0, 101.0};
+    std::vector<float> scores_vec = {0.9, 0.75, 0.6, 0.95, 0.5, 0.3};
+
+    migraphx::parameter_map params;
+    params["boxes"]  = migraphx::argument(boxes_s, boxes_vec.data());
+    params["scores"] = migraphx::argument(scores_s, scores_vec.data());
+    auto result      = p.eval(params).back();
+    std::vector<int64_t> result_vector;
+    result.visit([&](auto output) { result_vector.assign(output.begin(), output.end()); });
+    std::vector<int64_t> gold = {0, 0, 3, 0, 0, 0, 0, 0, 5, -1, -1, -1, -1, -1, -1, -1, -1, -1};
+    EXPECT(migraphx::verify_range(result_vector, gold));
+}
+
+TEST_CASE(nms_classes_test)
+{
+    // Each class of each batch keeps its own boxes, above the score threshold
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape boxes_s{migraphx::shape::float_type, {2, 3, 4}};
+    migraphx::shape scores_s{migraphx::shape::float_type, {2, 2, 3}};
+    std::vector<float> boxes_vec  = {0.5, 0.5, 1.0, 1.0, 0.5, 0.6, 1.0, 1.0, 0.5, 5.0, 1.0, 1.0,
+                                    0.5, 0.5, 1.0, 1.0, 0.5, 0.6, 1.0, 1.0, 0.5, 5.0, 1.0, 1.0};
+    std::vector<float> scores_vec = {0.9, 0.8, 0.7, 0.1, 0.2, 0.3, 0.2, 0.9, 0.8, 0.7, 0.3, 0.6};
+    auto boxes_l  = mm->add_literal(migraphx::literal(boxes_s, boxes_vec));
+    auto scores_l = mm->add_literal(migraphx::literal(scores_s, scores_vec));
+    auto max_out_l =
+        mm->add_literal(migraphx::literal{migraphx::shape{migraphx::shape::int64_type}, {2}});
+    auto iou_threshold =
+        mm->add_literal(migraphx::literal{migraphx::shape{migraphx::shape::float_type}, {0.5f}});
+    auto score_threshold =
+        mm->add_literal(migraphx::literal{migraphx::shape{migraphx::shape::float_type}, {0.4f}});
+    auto r = mm->add_instruction(migraphx::make_op("nonmaxsuppression", {{"center_point_box", 1}}),
+                                 boxes_l,
+                                 scores_l,
+                                 max_out_l,
+                                 iou_threshold,
+                                 score_threshold);
+    mm->add_return({r});
+    p.compile(migraphx::ref::target{});
+
+    auto result = p.eval({}).back();
+    std::vector<int64_t> result_vector;
+    result.visit([&](auto output) { result_vector.assign(output.begin(), output.end()); });
+    std::vector<int64_t> gold(12 * 3, -1);
+    std::vector<int64_t> selected = {0, 0, 0, 0, 0, 2, 1, 0, 1, 1, 0, 2, 1, 1, 0, 1, 1, 2};
+    std::copy(selected.begin(), selected.end(), gold.begin());
+    EXPECT(migraphx::verify_range(result_vector, gold));
+}
+
+TEST_CASE(nonzero_test)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape s{migraphx::shape::float_type, {2, 2, 3}};
+    auto x = mm->add_parameter("x", s);
+    auto r = mm->add_instruction(migraphx::make_op("nonzero"), x);
+    mm->add_return({r});
+    p.compile(migraphx::ref::target{});
+
+    std::vector<float> data = {
+        1.0f, 1.3f, 0.0f, -1.2f, 0.0f, -100.f, 200.f, 0.0f, 0.1f, 0.2f, 0.0f, 0.5f};
+    migraphx::parameter_map params;
+    params["x"] = migraphx::argument(s, data.data());
+    auto result = p.eval(params).back();
+    std::vector<int64_t> result_vector;
+    result.visit([&](auto output) { result_vector.assign(output.begin(), output.end()); });
+    std::vector<int64_t> gold = {0, 0, 0, 0, 1, 1, 1, 1, -1, -1, -1, -1, 0, 0, 1, 1, 0, 0,
+                                 1, 1, -1, -1, -1, -1, 0, 1, 0, 2, 0, 2, 0, 2, -1, -1, -1, -1};
+    EXPECT(migraphx::verify_range(result_vector, gold));
+}
+
 TEST_CASE(not_test)
 {
     // int32
@@ -3575,6 +3950,47 @@ TEST_CASE(reduce_sum_axis2)
     EXPECT(results_vector == gold);
 }
 
+TEST_CASE(reduce_sum_long_axis)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape s{migraphx::shape::float_type, {2, 30000}};
+    std::vector<float> data(s.elements());
+    std::iota(data.begin(), data.end(), 0);
+    std::transform(data.begin(), data.end(), data.begin(), [](auto x) {
+        return static_cast<int>(x) % 11;
+    });
+    auto l0 = mm->add_literal(migraphx::literal{s, data});
+    mm->add_instruction(migraphx::make_op("reduce_sum", {{"axes", {1}}}), l0);
+    p.compile(migraphx::ref::target{});
+    auto result = p.eval({}).back();
+    std::vector<float> results_vector;
+    result.visit([&](auto output) { results_vector.assign(output.begin(), output.end()); });
+    std::vector<float> gold{std::accumulate(data.begin(), data.begin() + 30000, 0.0f),
+                            std::accumulate(data.begin() + 30000, data.end(), 0.0f)};
+    EXPECT(results_vector == gold);
+}
+
+TEST_CASE(reduce_sum_long_outer_axis)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape s{migraphx::shape::int32_type, {30000, 2, 3}};
+    std::vector<int> data(s.elements());
+    std::iota(data.begin(), data.end(), 0);
+    std::transform(data.begin(), data.end(), data.begin(), [](auto x) { return x % 100; });
+    auto l0 = mm->add_literal(migraphx::literal{s, data});
+    mm->add_instruction(migraphx::make_op("reduce_sum", {{"axes", {0, 1}}}), l0);
+    p.compile(migraphx::ref::target{});
+    auto result = p.eval({}).back();
+    std::vector<int> results_vector;
+    result.visit([&](auto output) { results_vector.assign(output.begin(), output.end()); });
+    std::vector<int> gold(3, 0);
+    for(std::size_t i = 0; i < data.size(); i++)
+        gold[i % 3] += data[i];
+    EXPECT(results_vector == gold);
+}
+
 TEST_CASE(relu_test)
 {
     migraphx::program p;
@@ -4076,6 +4492,58 @@ TEST_CASE(tanh_test)
     EXPECT(migraphx::verify_range(results_vector, gold));
 }
 
+TEST_CASE(topk_test)
+{
+    auto create_program = [](int64_t k, int64_t axis, bool largest) {
+        migraphx::program p;
+        auto* mm = p.get_main_module();
+        migraphx::shape s{migraphx::shape::float_type, {3, 5}};
+        auto data = mm->add_parameter("data", s);
+        auto r    = mm->add_instruction(
+            migraphx::make_op("topk", {{"k", k}, {"axis", axis}, {"largest", largest}}), data);
+        auto r0 = mm->add_instruction(migraphx::make_op("get_tuple_elem", {{"index", 0}}), r);
+        auto r1 = mm->add_instruction(migraphx::make_op("get_tuple_elem", {{"index", 1}}), r);
+        mm->add_return({r0, r1});
+        p.compile(migraphx::ref::target{});
+
+        return p;
+    };
+
+    auto run_program = [&](int64_t k, int64_t axis, bool largest) {
+        auto p = create_program(k, axis, largest);
+        std::vector<float> data = {
+            2.1, 2.3, 2.0, 2.5, 1.9, 3.3, 0.2, 4.5, 0.1, 0.8, 1.0, 4.5, 2.1, 0.1, 1.5};
+        migraphx::shape s{migraphx::shape::float_type, {3, 5}};
+        migraphx::parameter_map pp;
+        pp["data"] = migraphx::argument(s, data.data());
+        auto rets  = p.eval(pp);
+        std::vector<float> ret_val;
+        rets.front().visit([&](auto v) { ret_val.assign(v.begin(), v.end()); });
+        std::vector<int64_t> ret_ind;
+        rets.back().visit([&](auto v) { ret_ind.assign(v.begin(), v.end()); });
+
+        return std::make_pair(ret_val, ret_ind);
+    };
+
+    // largest
+    {
+        auto results                = run_program(4, 1, true);
+        std::vector<float> gold_val = {2.5, 2.3, 2.1, 2.0, 4.5, 3.3, 0.8, 0.2, 4.5, 2.1, 1.5, 1.0};
+        EXPECT(results.first == gold_val);
+        std::vector<int64_t> gold_ind = {3, 1, 0, 2, 2, 0, 4, 1, 1, 2, 4, 0};
+        EXPECT(results.second == gold_ind);
+    }
+
+    // smallest, with equal values ordered by their index
+    {
+        auto results                = run_program(2, 0, false);
+        std::vector<float> gold_val = {1.0, 0.2, 2.0, 0.1, 0.8, 2.1, 2.3, 2.1, 0.1, 1.5};
+        EXPECT(results.first == gold_val);
+        std::vector<int64_t> gold_ind = {2, 1, 0, 1, 1, 0, 0, 2, 2, 2};
+        EXPECT(results.second == gold_ind);
+    }
+}
+
 TEST_CASE(transpose_test)
 {
     migraphx::shape a_shape{migraphx::shape::float_type, {1, 2, 2, 3}};
@@ -3,8 +3,11 @@
 #include <migraphx/load_save.hpp>
 #include "test.hpp"
 #include <migraphx/make_op.hpp>
+#include <migraphx/register_op.hpp>
+#include <migraphx/serialize.hpp>
 
 #include <cstdio>
+#include <sstream>
 
 migraphx::program create_program()
 {
@@ -56,6 +59,40 @@ TEST_CASE(as_file)
     EXPECT(p1.sort() == p2.sort());
 }
 
+TEST_CASE(as_msgpack_stream)
+{
+    migraphx::file_options options;
+    options.format       = "msgpack";
+    migraphx::program p1 = create_program();
+    std::stringstream ss;
+    migraphx::save(p1, ss, options);
+    migraphx::program p2 = migraphx::load(ss, options);
+    EXPECT(p1.sort() == p2.sort());
+}
+
+TEST_CASE(as_json_stream)
+{
+    migraphx::file_options options;
+    options.format       = "json";
+    migraphx::program p1 = create_program();
+    std::stringstream ss;
+    migraphx::save(p1, ss, options);
+    migraphx::program p2 = migraphx::load(ss, options);
+    EXPECT(p1.sort() == p2.sort());
+}
+
+TEST_CASE(stream_matches_buffer)
+{
+    migraphx::program p1     = create_program();
+    std::vector<char> buffer = migraphx::save_buffer(p1);
+    std::stringstream ss;
+    migraphx::save(p1, ss);
+    std::string s = ss.str();
+    EXPECT(std::vector<char>(s.begin(), s.end()) == buffer);
+    migraphx::program p2 = migraphx::load_buffer(s.data(), s.size());
+    EXPECT(p1.sort() == p2.sort());
+}
+
 TEST_CASE(compiled)
 {
     migraphx::program p1 = create_program();
@@ -72,6 +109,9 @@ TEST_CASE(unknown_format)
 
     EXPECT(test::throws([&] { migraphx::save_buffer(create_program(), options); }));
     EXPECT(test::throws([&] { migraphx::load_buffer(std::vector<char>{}, options); }));
+    std::stringstream ss;
+    EXPECT(test::throws([&] { migraphx::save(create_program(), ss, options); }));
+    EXPECT(test::throws([&] { migraphx::load(ss, options); }));
 }
 
 TEST_CASE(program_with_module)
@@ -115,4 +155,116 @@ TEST_CASE(program_with_module)
     EXPECT(p1.sort() == p2.sort());
 }
 
+TEST_CASE(program_with_module_stream)
+{
+    migraphx::program p;
+    auto* mm = p.get_main_module();
+    migraphx::shape sd{migraphx::shape::float_type, {2, 3}};
+    auto x = mm->add_parameter("x", sd);
+
+    std::vector<float> one(sd.elements(), 1);
+    std::vector<float> two(sd.elements(), 2);
+
+    auto* then_smod = p.create_module("then_smod");
+    auto l1         = then_smod->add_literal(migraphx::literal{sd, one});
+    auto r1         = then_smod->add_instruction(migraphx::make_op("add"), x, l1);
+    then_smod->add_return({r1});
+
+    auto* else_smod = p.create_module("else_smod");
+    auto l2         = else_smod->add_literal(migraphx::literal{sd, two});
+    auto r2         = else_smod->add_instruction(migraphx::make_op("mul"), x, l2);
+    else_smod->add_return({r2});
+
+    migraphx::shape s_cond{migraphx::shape::bool_type, {1}};
+    auto cond = mm->add_parameter("cond", s_cond);
+    auto ret  = mm->add_instruction(migraphx::make_op("if"), {cond}, {then_smod, else_smod});
+    mm->add_return({ret});
+
+    for(std::string format : {"msgpack", "json"})
+    {
+        migraphx::file_options options;
+        options.format       = format;
+        migraphx::program p1 = p;
+        std::stringstream ss;
+        migraphx::save(p1, ss, options);
+        migraphx::program p2 = migraphx::load(ss, options);
+        EXPECT(p1.sort() == p2.sort());
+    }
+}
+
+// Holds its data in a field, like the literals of a compiled program
+struct literal_op : migraphx::auto_register_op<literal_op>
+{
+    migraphx::literal data;
+
+    template <class Self, class F>
+    static auto reflect(Self& self, F f)
+    {
+        return migraphx::pack(f(self.data, "data"));
+    }
+
+    std::string name() const { return "test::literal_op"; }
+    migraphx::shape compute_shape(const std::vector<migraphx::shape>&) const
+    {
+        return data.get_shape();
+    }
+    migraphx::argument compute(const migraphx::shape&, const std::vector<migraphx::argument>&) const
+    {
+        return data.get_argument();
+    }
+};
+
+TEST_CASE(operator_literal_table)
+{
+    migraphx::shape s{migraphx::shape::float_type, {3}};
+    migraphx::operation op = literal_op{{}, migraphx::literal{s, std::vector<float>{1, 2, 3}}};
+    // Without a table the data is kept in the value
+    EXPECT(op.to_value().at("data").contains("data"));
+
+    std::vector<migraphx::literal> literals;
+    auto v = op.to_value(literals);
+    EXPECT(literals.size() == 1);
+    EXPECT(v.at("data").at("@literal").to<std::size_t>() == 0);
+    EXPECT(op.to_value().at("data").contains("data"));
+
+    auto op2 = migraphx::make_op("test::literal_op");
+    op2.from_value(v, literals);
+    EXPECT(op2 == op);
+    EXPECT(test::throws([&] { op2.from_value(v, {}); }));
+    EXPECT(test::throws([&] { op2.from_value(v); }));
+}
+
+TEST_CASE(operator_literal_stream)
+{
+    migraphx::program p1;
+    auto* mm = p1.get_main_module();
+    migraphx::shape s{migraphx::shape::float_type, {2, 3}};
+    auto x  = mm->add_parameter("x", s);
+    auto l  = mm->add_literal(migraphx::literal{s, std::vector<float>(6, 1)});
+    auto op = mm->add_instruction(
+        literal_op{{}, migraphx::literal{s, std::vector<float>{1, 2, 3, 4, 5, 6}}});
+    auto add = mm->add_instruction(migraphx::make_op("add"), x, l);
+    mm->add_return({mm->add_instruction(migraphx::make_op("mul"), add, op)});
+
+    // The data of the operator goes in the table with the literals
+    std::vector<migraphx::literal> literals;
+    auto v = p1.to_value(literals);
+    EXPECT(literals.size() == 2);
+    EXPECT(not v.at("modules").at("main").at("nodes")[2].at("operator").at("data").contains(
+        "data"));
+    migraphx::program p2;
+    p2.from_value(v, literals);
+    EXPECT(p1.sort() == p2.sort());
+
+    for(std::string format : {"msgpack", "json"})
+    {
+        migraphx::file_options options;
+        options.format = format;
+        std::stringstream ss;
+        migraphx::save(p1, ss, options);
+        migraphx::program p3 = migraphx::load(ss, options);
+        EXPECT(p1.sort() == p3.sort());
+    }
+}
+
 int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -1435,6 +1435,44 @@ TEST_CASE(simplify_dot_horiz_same_constant)
     EXPECT(m1.sort() == m2.sort());
 }
 
+TEST_CASE(simplify_dot_horiz_non_constant)
+{
+    auto s = migraphx::shape{migraphx::shape::int32_type, {3, 2, 2}};
+    migraphx::module m1;
+    {
+        auto input = m1.add_parameter("input", s);
+        auto w     = m1.add_parameter("w", s);
+        auto a     = m1.add_literal(migraphx::generate_literal(s, 0));
+        auto b     = m1.add_literal(migraphx::generate_literal(s, 1));
+        auto x     = m1.add_instruction(migraphx::make_op("dot"), input, a);
+        auto y     = m1.add_instruction(migraphx::make_op("dot"), input, b);
+        auto z     = m1.add_instruction(migraphx::make_op("dot"), input, w);
+        auto sum1  = m1.add_instruction(migraphx::make_op("add"), x, y);
+        auto sum2  = m1.add_instruction(migraphx::make_op("add"), sum1, z);
+        m1.add_instruction(pass_op{}, sum2);
+    }
+    run_pass(m1);
+
+    migraphx::module m2;
+    {
+        auto input  = m2.add_parameter("input", s);
+        auto w      = m2.add_parameter("w", s);
+        auto a      = m2.add_literal(migraphx::generate_literal(s, 0));
+        auto b      = m2.add_literal(migraphx::generate_literal(s, 1));
+        auto concat = m2.add_instruction(migraphx::make_op("concat", {{"axis", 2}}), a, b);
+        auto dot    = m2.add_instruction(migraphx::make_op("dot"), input, concat);
+        auto x      = m2.add_instruction(
+            migraphx::make_op("slice", {{"axes", {2}}, {"starts", {0}}, {"ends", {2}}}), dot);
+        auto y = m2.add_instruction(
+            migraphx::make_op("slice", {{"axes", {2}}, {"starts", {2}}, {"ends", {4}}}), dot);
+        auto z    = m2.add_instruction(migraphx::make_op("dot"), input, w);
+        auto sum1 = m2.add_instruction(migraphx::make_op("add"), x, y);
+        auto sum2 = m2.add_instruction(migraphx::make_op("add"), sum1, z);
+        m2.add_instruction(pass_op{}, sum2);
+    }
+    EXPECT(m1.sort() == m2.sort());
+}
+
 TEST_CASE(simplify_dot_horiz_flipped)
 {
     auto s = migraphx::shape{migraphx::shape::int32_type, {3, 2, 2}};
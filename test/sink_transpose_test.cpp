@@ -0,0 +1,228 @@
+#include <migraphx/sink_transpose.hpp>
+#include <migraphx/dead_code_elimination.hpp>
+#include <migraphx/pass_manager.hpp>
+#include <migraphx/program.hpp>
+#include <migraphx/ref/target.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/instruction.hpp>
+#include <migraphx/make_op.hpp>
+#include <migraphx/verify.hpp>
+
+#include <test.hpp>
+
+void run_pass(migraphx::module& m)
+{
+    migraphx::run_passes(m, {migraphx::sink_transpose{}, migraphx::dead_code_elimination{}});
+}
+
+migraphx::operation to_nhwc() { return migraphx::make_op("transpose", {{"dims", {0, 2, 3, 1}}}); }
+
+migraphx::operation to_nchw() { return migraphx::make_op("transpose", {{"dims", {0, 3, 1, 2}}}); }
+
+TEST_CASE(relu_add_cancel)
+{
+    migraphx::shape xs{migraphx::shape::float_type, {1, 3, 4, 4}};
+    migraphx::shape bs{migraphx::shape::float_type, {3}};
+    migraphx::module m1;
+    {
+        auto x    = m1.add_parameter("x", xs);
+        auto b    = m1.add_parameter("b", bs);
+        auto t    = m1.add_instruction(to_nhwc(), x);
+        auto relu = m1.add_instruction(migraphx::make_op("relu"), t);
+        auto bb   = m1.add_instruction(
+            migraphx::make_op("multibroadcast", {{"output_lens", {1, 4, 4, 3}}}), b);
+        auto add = m1.add_instruction(migraphx::make_op("add"), relu, bb);
+        auto r   = m1.add_instruction(to_nchw(), add);
+        m1.add_return({r});
+    }
+    run_pass(m1);
+
+    migraphx::module m2;
+    {
+        auto x    = m2.add_parameter("x", xs);
+        auto b    = m2.add_parameter("b", bs);
+        auto relu = m2.add_instruction(migraphx::make_op("relu"), x);
+        auto bb   = m2.add_instruction(
+            migraphx::make_op("multibroadcast", {{"output_lens", {1, 4, 4, 3}}}), b);
+        auto bt  = m2.add_instruction(to_nchw(), bb);
+        auto add = m2.add_instruction(migraphx::make_op("add"), relu, bt);
+        m2.add_return({add});
+    }
+    EXPECT(m1.sort() == m2.sort());
+}
+
+TEST_CASE(reduce_slice_concat_cancel)
+{
+    migraphx::shape xs{migraphx::shape::float_type, {2, 3, 4, 5}};
+    migraphx::module m1;
+    {
+        auto x      = m1.add_parameter("x", xs);
+        auto y      = m1.add_parameter("y", xs);
+        auto tx     = m1.add_instruction(to_nhwc(), x);
+        auto ty     = m1.add_instruction(to_nhwc(), y);
+        auto concat = m1.add_instruction(migraphx::make_op("concat", {{"axis", -1}}), tx, ty);
+        auto slice  = m1.add_instruction(
+            migraphx::make_op("slice", {{"axes", {3}}, {"starts", {1}}, {"ends", {5}}}), concat);
+        auto reduce =
+            m1.add_instruction(migraphx::make_op("reduce_mean", {{"axes", {1, 2}}}), slice);
+        auto r = m1.add_instruction(to_nchw(), reduce);
+        m1.add_return({r});
+    }
+    run_pass(m1);
+
+    migraphx::module m2;
+    {
+        auto x      = m2.add_parameter("x", xs);
+        auto y      = m2.add_parameter("y", xs);
+        auto concat = m2.add_instruction(migraphx::make_op("concat", {{"axis", 1}}), x, y);
+        auto slice  = m2.add_instruction(
+            migraphx::make_op("slice", {{"axes", {1}}, {"starts", {1}}, {"ends", {5}}}), concat);
+        auto reduce =
+            m2.add_instruction(migraphx::make_op("reduce_mean", {{"axes", {2, 3}}}), slice);
+        m2.add_return({reduce});
+    }
+    EXPECT(m1.sort() == m2.sort());
+}
+
+TEST_CASE(stop_at_convolution)
+{
+    migraphx::shape xs{migraphx::shape::float_type, {1, 3, 4, 4}};
+    migraphx::shape ws{migraphx::shape::float_type, {4, 4, 1, 1}};
+    migraphx::module m1;
+    {
+        auto x    = m1.add_parameter("x", xs);
+        auto w    = m1.add_parameter("w", ws);
+        auto t    = m1.add_instruction(migraphx::make_op("transpose", {{"dims", {0, 2, 1, 3}}}), x);
+        auto relu = m1.add_instruction(migraphx::make_op("relu"), t);
+        auto conv = m1.add_instruction(migraphx::make_op("convolution"), relu, w);
+        m1.add_return({conv});
+    }
+    run_pass(m1);
+
+    migraphx::module m2;
+    {
+        auto x    = m2.add_parameter("x", xs);
+        auto w    = m2.add_parameter("w", ws);
+        auto relu = m2.add_instruction(migraphx::make_op("relu"), x);
+        auto t =
+            m2.add_instruction(migraphx::make_op("transpose", {{"dims", {0, 2, 1, 3}}}), relu);
+        auto conv = m2.add_instruction(migraphx::make_op("convolution"), t, w);
+        m2.add_return({conv});
+    }
+    EXPECT(m1.sort() == m2.sort());
+}
+
+TEST_CASE(stop_at_contiguous)
+{
+    migraphx::shape xs{migraphx::shape::float_type, {1, 3, 4, 4}};
+    migraphx::module m1;
+    {
+        auto x    = m1.add_parameter("x", xs);
+        auto t    = m1.add_instruction(to_nhwc(), x);
+        auto c    = m1.add_instruction(migraphx::make_op("contiguous"), t);
+        auto r    = m1.add_instruction(migraphx::make_op("reshape", {{"dims", {1, 48}}}), c);
+        auto relu = m1.add_instruction(migraphx::make_op("relu"), r);
+        m1.add_return({relu});
+    }
+    migraphx::module m2 = m1;
+    run_pass(m1);
+    EXPECT(m1 == m2);
+}
+
+TEST_CASE(stop_at_layout)
+{
+    migraphx::shape xs{migraphx::shape::float_type, {1, 3, 4, 4}};
+    migraphx::module m1;
+    {
+        auto x = m1.add_parameter("x", xs);
+        auto t = m1.add_instruction(to_nhwc(), x);
+        auto l = m1.add_instruction(
+            migraphx::make_op("layout", {{"permutation", {0, 1, 2, 3}}}), t);
+        auto r = m1.add_instruction(to_nchw(), l);
+        m1.add_return({r});
+    }
+    migraphx::module m2 = m1;
+    run_pass(m1);
+    EXPECT(m1 == m2);
+}
+
+TEST_CASE(contiguous_cancel)
+{
+    migraphx::shape xs{migraphx::shape::float_type, {1, 3, 4, 4}};
+    migraphx::module m1;
+    {
+        auto x    = m1.add_parameter("x", xs);
+        auto t    = m1.add_instruction(to_nhwc(), x);
+        auto c    = m1.add_instruction(migraphx::make_op("contiguous"), t);
+        auto r    = m1.add_instruction(to_nchw(), c);
+        auto relu = m1.add_instruction(migraphx::make_op("relu"), r);
+        m1.add_return({relu});
+    }
+    run_pass(m1);
+
+    migraphx::module m2;
+    {
+        auto x    = m2.add_parameter("x", xs);
+        auto relu = m2.add_instruction(migraphx::make_op("relu"), x);
+        m2.add_return({relu});
+    }
+    EXPECT(m1.sort() == m2.sort());
+}
+
+TEST_CASE(shared_transpose)
+{
+    migraphx::shape xs{migraphx::shape::float_type, {1, 3, 4, 4}};
+    migraphx::module m1;
+    {
+        auto x    = m1.add_parameter("x", xs);
+        auto t    = m1.add_instruction(to_nhwc(), x);
+        auto relu = m1.add_instruction(migraphx::make_op("relu"), t);
+        auto tanh = m1.add_instruction(migraphx::make_op("tanh"), t);
+        m1.add_return({relu, tanh});
+    }
+    migraphx::module m2 = m1;
+    run_pass(m1);
+    EXPECT(m1 == m2);
+}
+
+TEST_CASE(nhwc_eval)
+{
+    migraphx::shape xs{migraphx::shape::float_type, {2, 3, 4, 5}};
+    migraphx::program p1;
+    {
+        auto* mm  = p1.get_main_module();
+        auto x    = mm->add_parameter("x", xs);
+        auto b    = mm->add_literal(migraphx::generate_literal({migraphx::shape::float_type, {3}}));
+        auto t    = mm->add_instruction(to_nhwc(), x);
+        auto relu = mm->add_instruction(migraphx::make_op("relu"), t);
+        auto bb   = mm->add_instruction(
+            migraphx::make_op("multibroadcast", {{"output_lens", {2, 4, 5, 3}}}), b);
+        auto mul   = mm->add_instruction(migraphx::make_op("mul"), relu, bb);
+        auto slice = mm->add_instruction(
+            migraphx::make_op("slice", {{"axes", {1}}, {"starts", {1}}, {"ends", {3}}}), mul);
+        auto reduce = mm->add_instruction(migraphx::make_op("reduce_sum", {{"axes", {3}}}), slice);
+        auto r      = mm->add_instruction(to_nchw(), reduce);
+        mm->add_return({r});
+    }
+    auto p2 = p1;
+    run_pass(*p2.get_main_module());
+    EXPECT(p1 != p2);
+    auto* mm2 = p2.get_main_module();
+    EXPECT(std::none_of(mm2->begin(), mm2->end(), [](const auto& ins) {
+        return ins.name() == "transpose" and not ins.can_eval();
+    }));
+
+    migraphx::parameter_map params;
+    params["x"] = migraphx::generate_argument(xs);
+    p1.compile(migraphx::ref::target{});
+    p2.compile(migraphx::ref::target{});
+    auto result1 = p1.eval(params).back();
+    auto result2 = p2.eval(params).back();
+    std::vector<float> results_vector1;
+    std::vector<float> results_vector2;
+    result1.visit([&](auto output) { results_vector1.assign(output.begin(), output.end()); });
+    result2.visit([&](auto output) { results_vector2.assign(output.begin(), output.end()); });
+    EXPECT(migraphx::verify_range(results_vector1, results_vector2));
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
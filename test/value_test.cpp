@@ -167,6 +167,57 @@ TEST_CASE(value_copy_assign_keyless)
     EXPECT(v1.without_key() == v2.without_key());
 }
 
+TEST_CASE(value_move_construct)
+{
+    migraphx::value v1 = {{"a", 1}, {"b", 2}};
+    migraphx::value v2("key", std::move(v1));
+    EXPECT(v2.get_key() == "key");
+    EXPECT(v2.is_object());
+    EXPECT(v2.at("b") == migraphx::value("b", 2));
+    migraphx::value v3 = std::move(v2).without_key();
+    EXPECT(v3.get_key().empty());
+    EXPECT(v3.at("a") == migraphx::value("a", 1));
+}
+
+TEST_CASE(value_large_object)
+{
+    migraphx::value v = migraphx::value::object{};
+    for(int i = 0; i < 20; i++)
+        v["k" + std::to_string(i)] = i;
+    EXPECT(v.size() == 20);
+    for(int i = 0; i < 20; i++)
+        EXPECT(v.at("k" + std::to_string(i)).to<int>() == i);
+    EXPECT(not v.contains("k20"));
+    EXPECT(not v.insert({"k3", 100}).second);
+    EXPECT(v.at("k3").to<int>() == 3);
+
+    migraphx::value v2 = v;
+    v2["k21"]          = 21;
+    EXPECT(v2.at("k21").to<int>() == 21);
+    EXPECT(not v.contains("k21"));
+
+    v.clear();
+    EXPECT(v.empty());
+    EXPECT(not v.contains("k3"));
+}
+
+TEST_CASE(value_object_duplicate_keys)
+{
+    migraphx::value v = {{"a", 1}, {"a", 2}};
+    EXPECT(v.at("a").to<int>() == 2);
+}
+
+TEST_CASE(value_insert_key_empty_array)
+{
+    migraphx::value v = migraphx::value::array{};
+    v["a"]            = 1;
+    EXPECT(v.is_object());
+    EXPECT(v.at("a").to<int>() == 1);
+
+    migraphx::value v2 = {1, 2};
+    EXPECT(test::throws([&] { v2["a"] = 1; }));
+}
+
 TEST_CASE(value_construct_array)
 {
     migraphx::value v = {1, 2, 3};
@@ -1,6 +1,10 @@
 #include "run_verify.hpp"
 #include <migraphx/ranges.hpp>
+#include <migraphx/load_save.hpp>
+#include <migraphx/verify_args.hpp>
 #include <test.hpp>
+#include <algorithm>
+#include <sstream>
 
 #ifdef HAVE_GPU
 #include <migraphx/gpu/analyze_streams.hpp>
@@ -40,15 +44,37 @@ void validate_gpu(const migraphx::program& p, const migraphx::parameter_map& m)
     EXPECT(is_shared(ctx, p.get_context()));
 }
 
+// Ensure the compiled program keeps its weights when it is saved and loaded again
+void validate_cpu(const migraphx::program& p, const migraphx::parameter_map& m)
+{
+    std::stringstream ss;
+    migraphx::save(p, ss);
+    auto loaded = migraphx::load(ss);
+    EXPECT(p == loaded);
+    std::vector<migraphx::argument> expected;
+    for(const auto& r : p.eval(m))
+        expected.push_back(r.copy());
+    auto results = loaded.eval(m);
+    EXPECT(results.size() == expected.size());
+    for(std::size_t i = 0; i < std::min(results.size(), expected.size()); i++)
+        EXPECT(migraphx::verify_args("cpu save/load", expected[i], results[i]));
+}
+
 int main(int argc, const char* argv[])
 {
     run_verify rv;
+    rv.add_validation_for("cpu", &validate_cpu);
     rv.add_validation_for("gpu", &validate_gpu);
     rv.disable_test_for("cpu", {"test_if_lp", "test_if_param", "test_if_literal"});
     rv.disable_test_for("gpu",
                         {"batch_quant_dot_2",
                          "batch_quant_dot_3",
                          "batch_quant_dot_5",
+                         "test_im2col_3d",
+                         "test_im2col_batch",
+                         "test_loop",
+                         "test_nms",
+                         "test_nonzero",
                          "quant_dot_3args_1",
                          "quant_dot_3args_2",
                          "quant_dot_3args_3",
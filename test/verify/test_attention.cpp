@@ -0,0 +1,77 @@
+#include "verify_program.hpp"
+#include <migraphx/program.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/make_op.hpp>
+
+migraphx::instruction_ref add_scale(migraphx::module& m,
+                                    const std::string& op,
+                                    migraphx::instruction_ref x,
+                                    float scale)
+{
+    auto s        = m.add_literal(scale);
+    auto s_mbcast = m.add_instruction(
+        migraphx::make_op("multibroadcast", {{"output_lens", x->get_shape().lens()}}), s);
+    return m.add_instruction(migraphx::make_op(op), x, s_mbcast);
+}
+
+struct test_attention : verify_program<test_attention>
+{
+    migraphx::program create_program() const
+    {
+        migraphx::program p;
+        auto* mm = p.get_main_module();
+        migraphx::shape qs{migraphx::shape::float_type, {2, 3, 8, 16}};
+        migraphx::shape kts{migraphx::shape::float_type, {2, 3, 16, 8}};
+        migraphx::shape ms{migraphx::shape::float_type, {2, 3, 8, 8}};
+        auto q       = mm->add_parameter("q", qs);
+        auto kt      = mm->add_parameter("kt", kts);
+        auto v       = mm->add_parameter("v", qs);
+        auto mask    = mm->add_parameter("mask", ms);
+        auto scores  = mm->add_instruction(migraphx::make_op("dot"), q, kt);
+        auto scaled  = add_scale(*mm, "mul", scores, 0.25f);
+        auto masked  = mm->add_instruction(migraphx::make_op("add"), scaled, mask);
+        auto softmax = mm->add_instruction(migraphx::make_op("softmax", {{"axis", 3}}), masked);
+        mm->add_instruction(migraphx::make_op("dot"), softmax, v);
+        return p;
+    }
+};
+
+struct test_attention_transposed : verify_program<test_attention_transposed>
+{
+    migraphx::program create_program() const
+    {
+        migraphx::program p;
+        auto* mm = p.get_main_module();
+        migraphx::shape s{migraphx::shape::float_type, {2, 8, 4, 16}};
+        auto q  = mm->add_parameter("q", s);
+        auto k  = mm->add_parameter("k", s);
+        auto v  = mm->add_parameter("v", s);
+        auto qt = mm->add_instruction(migraphx::make_op("transpose", {{"dims", {0, 2, 1, 3}}}), q);
+        auto kt = mm->add_instruction(migraphx::make_op("transpose", {{"dims", {0, 2, 3, 1}}}), k);
+        auto vt = mm->add_instruction(migraphx::make_op("transpose", {{"dims", {0, 2, 1, 3}}}), v);
+        auto scores  = mm->add_instruction(migraphx::make_op("dot"), qt, kt);
+        auto scaled  = add_scale(*mm, "div", scores, 4.0f);
+        auto softmax = mm->add_instruction(migraphx::make_op("softmax", {{"axis", 3}}), scaled);
+        mm->add_instruction(migraphx::make_op("dot"), softmax, vt);
+        return p;
+    }
+};
+
+struct test_attention_long : verify_program<test_attention_long>
+{
+    migraphx::program create_program() const
+    {
+        migraphx::program p;
+        auto* mm = p.get_main_module();
+        migraphx::shape qs{migraphx::shape::float_type, {1, 20, 8}};
+        migraphx::shape kts{migraphx::shape::float_type, {1, 8, 150}};
+        migraphx::shape vs{migraphx::shape::float_type, {1, 150, 12}};
+        auto q       = mm->add_parameter("q", qs);
+        auto kt      = mm->add_parameter("kt", kts);
+        auto v       = mm->add_parameter("v", vs);
+        auto scores  = mm->add_instruction(migraphx::make_op("dot"), q, kt);
+        auto softmax = mm->add_instruction(migraphx::make_op("softmax", {{"axis", -1}}), scores);
+        mm->add_instruction(migraphx::make_op("dot"), softmax, v);
+        return p;
+    }
+};
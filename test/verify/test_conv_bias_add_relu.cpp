@@ -0,0 +1,31 @@
+#include "verify_program.hpp"
+#include <migraphx/program.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/make_op.hpp>
+
+#include <migraphx/instruction.hpp>
+
+struct test_conv_bias_add_relu : verify_program<test_conv_bias_add_relu>
+{
+    migraphx::program create_program() const
+    {
+        migraphx::program p;
+        auto* mm = p.get_main_module();
+        auto input =
+            mm->add_parameter("x", migraphx::shape{migraphx::shape::float_type, {4, 3, 3, 3}});
+        auto weights =
+            mm->add_parameter("w", migraphx::shape{migraphx::shape::float_type, {4, 3, 3, 3}});
+        auto residual =
+            mm->add_parameter("r", migraphx::shape{migraphx::shape::float_type, {4, 4, 1, 1}});
+        auto bias = mm->add_literal(migraphx::generate_literal(
+            migraphx::shape{migraphx::shape::float_type, {4}}, 1));
+        auto conv       = mm->add_instruction(migraphx::make_op("convolution"), input, weights);
+        auto bcast_bias = mm->add_instruction(
+            migraphx::make_op("broadcast", {{"axis", 1}, {"dims", conv->get_shape().lens()}}),
+            bias);
+        auto bias_add = mm->add_instruction(migraphx::make_op("add"), conv, bcast_bias);
+        auto add      = mm->add_instruction(migraphx::make_op("add"), residual, bias_add);
+        mm->add_instruction(migraphx::make_op("relu"), add);
+        return p;
+    }
+};
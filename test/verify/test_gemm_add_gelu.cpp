@@ -0,0 +1,40 @@
+#include "verify_program.hpp"
+#include <migraphx/program.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/make_op.hpp>
+
+struct test_gemm_add_gelu : verify_program<test_gemm_add_gelu>
+{
+    migraphx::program create_program() const
+    {
+        migraphx::program p;
+        auto* mm = p.get_main_module();
+        std::vector<size_t> lens{2, 8, 16};
+        auto x = mm->add_parameter("x", migraphx::shape{migraphx::shape::float_type, {2, 8, 4}});
+        auto w = mm->add_literal(
+            migraphx::generate_literal(migraphx::shape{migraphx::shape::float_type, {4, 16}}, 1));
+        auto bias = mm->add_literal(
+            migraphx::generate_literal(migraphx::shape{migraphx::shape::float_type, {16}}, 2));
+        auto wb = mm->add_instruction(
+            migraphx::make_op("multibroadcast", {{"output_lens", {2, 4, 16}}}), w);
+        auto dot         = mm->add_instruction(migraphx::make_op("dot"), x, wb);
+        auto bias_mbcast = mm->add_instruction(
+            migraphx::make_op("multibroadcast", {{"output_lens", lens}}), bias);
+        auto add         = mm->add_instruction(migraphx::make_op("add"), dot, bias_mbcast);
+        auto half        = mm->add_literal(0.5f);
+        auto one         = mm->add_literal(1.0f);
+        auto sqrt2       = mm->add_literal(static_cast<float>(M_SQRT2));
+        auto half_mbcast = mm->add_instruction(
+            migraphx::make_op("multibroadcast", {{"output_lens", lens}}), half);
+        auto mul_half     = mm->add_instruction(migraphx::make_op("mul"), add, half_mbcast);
+        auto sqrt2_mbcast = mm->add_instruction(
+            migraphx::make_op("multibroadcast", {{"output_lens", lens}}), sqrt2);
+        auto div        = mm->add_instruction(migraphx::make_op("div"), add, sqrt2_mbcast);
+        auto erf        = mm->add_instruction(migraphx::make_op("erf"), div);
+        auto one_mbcast = mm->add_instruction(
+            migraphx::make_op("multibroadcast", {{"output_lens", lens}}), one);
+        auto add_one = mm->add_instruction(migraphx::make_op("add"), erf, one_mbcast);
+        mm->add_instruction(migraphx::make_op("mul"), mul_half, add_one);
+        return p;
+    }
+};
@@ -0,0 +1,22 @@
+#include "verify_program.hpp"
+#include <migraphx/program.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/make_op.hpp>
+
+struct test_gemm_horiz_gated : verify_program<test_gemm_horiz_gated>
+{
+    migraphx::program create_program() const
+    {
+        migraphx::program p;
+        auto* mm = p.get_main_module();
+        migraphx::shape ws{migraphx::shape::float_type, {2, 16, 32}};
+        auto x = mm->add_parameter("x", migraphx::shape{migraphx::shape::float_type, {2, 8, 16}});
+        auto gate_w = mm->add_literal(migraphx::generate_literal(ws, 1));
+        auto up_w   = mm->add_literal(migraphx::generate_literal(ws, 2));
+        auto gate   = mm->add_instruction(migraphx::make_op("dot"), x, gate_w);
+        auto up     = mm->add_instruction(migraphx::make_op("dot"), x, up_w);
+        auto act    = mm->add_instruction(migraphx::make_op("tanh"), gate);
+        mm->add_instruction(migraphx::make_op("mul"), act, up);
+        return p;
+    }
+};
@@ -0,0 +1,24 @@
+#include "verify_program.hpp"
+#include <migraphx/program.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/make_op.hpp>
+
+struct test_im2col_3d : verify_program<test_im2col_3d>
+{
+    migraphx::program create_program() const
+    {
+        migraphx::program p;
+        auto* mm = p.get_main_module();
+        auto input =
+            mm->add_parameter("x", migraphx::shape{migraphx::shape::float_type, {2, 2, 5, 6, 4}});
+        auto weights = mm->add_literal(
+            migraphx::generate_literal({migraphx::shape::float_type, {3, 2, 3, 2, 3}}));
+        mm->add_instruction(migraphx::make_op("im2col",
+                                              {{"padding", {1, 0, 1}},
+                                               {"stride", {1, 2, 1}},
+                                               {"dilation", {1, 1, 2}}}),
+                            input,
+                            weights);
+        return p;
+    }
+};
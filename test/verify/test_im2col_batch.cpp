@@ -0,0 +1,20 @@
+#include "verify_program.hpp"
+#include <migraphx/program.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/make_op.hpp>
+
+struct test_im2col_batch : verify_program<test_im2col_batch>
+{
+    migraphx::program create_program() const
+    {
+        migraphx::program p;
+        auto* mm = p.get_main_module();
+        auto input =
+            mm->add_parameter("x", migraphx::shape{migraphx::shape::float_type, {2, 3, 7, 9}});
+        auto weights = mm->add_literal(
+            migraphx::generate_literal({migraphx::shape::float_type, {4, 3, 3, 3}}));
+        mm->add_instruction(
+            migraphx::make_op("im2col", {{"padding", {1, 2}}, {"stride", {2, 1}}}), input, weights);
+        return p;
+    }
+};
@@ -0,0 +1,39 @@
+
+#include "verify_program.hpp"
+#include <migraphx/program.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/make_op.hpp>
+
+struct test_loop : verify_program<test_loop>
+{
+    migraphx::program create_program() const
+    {
+        migraphx::program p;
+        auto* mm = p.get_main_module();
+        migraphx::shape ts{migraphx::shape::int64_type};
+        migraphx::shape cs{migraphx::shape::bool_type};
+        migraphx::shape s{migraphx::shape::float_type, {2, 3}};
+        auto trip = mm->add_literal(migraphx::literal{ts, {4}});
+        auto cond = mm->add_literal(migraphx::literal{cs, {1}});
+        auto a    = mm->add_parameter("a", s);
+
+        // Runs until iter reaches 2, with a weight that doesn't change between iterations
+        auto* body = p.create_module("Loop_0_loop");
+        auto iter  = body->add_parameter("#loop_iter", ts);
+        body->add_parameter("#loop_cond", cs);
+        auto ba   = body->add_parameter("#loop_dep0", s);
+        auto two  = body->add_literal(migraphx::literal{ts, {2}});
+        auto w    = body->add_literal(migraphx::generate_literal(s));
+        auto ww   = body->add_instruction(migraphx::make_op("mul"), w, w);
+        auto next = body->add_instruction(migraphx::make_op("less"), iter, two);
+        auto sum  = body->add_instruction(migraphx::make_op("add"), ba, ww);
+        body->add_return({next, sum, sum});
+
+        auto loop = mm->add_instruction(
+            migraphx::make_op("loop", {{"max_iterations", 5}}), {trip, cond, a}, {body});
+        auto r0 = mm->add_instruction(migraphx::make_op("get_tuple_elem", {{"index", 0}}), loop);
+        auto r1 = mm->add_instruction(migraphx::make_op("get_tuple_elem", {{"index", 1}}), loop);
+        mm->add_return({r0, r1});
+        return p;
+    }
+};
@@ -0,0 +1,29 @@
+#include "verify_program.hpp"
+#include <migraphx/program.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/make_op.hpp>
+
+struct test_nms : verify_program<test_nms>
+{
+    migraphx::program create_program() const
+    {
+        migraphx::program p;
+        auto* mm = p.get_main_module();
+        migraphx::shape boxes_s{migraphx::shape::float_type, {2, 8, 4}};
+        migraphx::shape scores_s{migraphx::shape::float_type, {2, 3, 8}};
+        auto boxes  = mm->add_parameter("boxes", boxes_s);
+        auto scores = mm->add_parameter("scores", scores_s);
+        migraphx::shape max_out_s{migraphx::shape::int64_type};
+        migraphx::shape threshold_s{migraphx::shape::float_type};
+        auto max_out         = mm->add_literal(migraphx::literal{max_out_s, {3}});
+        auto iou_threshold   = mm->add_literal(migraphx::literal{threshold_s, {0.5f}});
+        auto score_threshold = mm->add_literal(migraphx::literal{threshold_s, {0.0f}});
+        mm->add_instruction(migraphx::make_op("nonmaxsuppression"),
+                            boxes,
+                            scores,
+                            max_out,
+                            iou_threshold,
+                            score_threshold);
+        return p;
+    }
+};
@@ -0,0 +1,25 @@
+#include "verify_program.hpp"
+#include <migraphx/program.hpp>
+#include <migraphx/generate.hpp>
+#include <migraphx/make_op.hpp>
+#include <vector>
+
+struct test_nonzero : verify_program<test_nonzero>
+{
+    migraphx::program create_program() const
+    {
+        migraphx::program p;
+        auto* mm = p.get_main_module();
+        migraphx::shape s{migraphx::shape::float_type, {2, 3, 4}};
+        auto x = mm->add_parameter("x", s);
+
+        // Zero out every third element so that the output is padded
+        std::vector<float> mask_data(s.elements());
+        for(std::size_t i = 0; i < mask_data.size(); ++i)
+            mask_data[i] = (i % 3 == 0) ? 0.0f : 1.0f;
+        auto mask = mm->add_literal(migraphx::literal{s, mask_data});
+        auto y    = mm->add_instruction(migraphx::make_op("mul"), x, mask);
+        mm->add_instruction(migraphx::make_op("nonzero"), y);
+        return p;
+    }
+};
@@ -22,6 +22,15 @@ struct context
 {
     /// Wait for any tasks in the context to complete
     void finish() const;
+    /// Whether the compilation can finalize the operators on several threads, and run a pass on
+    /// the modules that don't depend on each other at the same time. Defaults to false.
+    bool parallel_compile() const;
+    /// Called on the thread that evaluates a program before any instruction runs. Defaults to
+    /// doing nothing.
+    void begin_eval() const;
+    /// Called on the same thread after the evaluation ends, even when it throws. Defaults to
+    /// doing nothing.
+    void end_eval() const;
 };
 
 #else
@@ -35,10 +44,29 @@ value to_value_context(const T&)
 template <class T>
 void from_value_context(T&, const value&){}
 
+template <class T>
+bool parallel_compile_context(const T&)
+{
+    return false;
+}
+
+template <class T>
+void begin_eval_context(const T&)
+{
+}
+
+template <class T>
+void end_eval_context(const T&)
+{
+}
+
 <%
  interface('context',
            virtual('to_value', returns = 'value', const = True, default = 'to_value_context'),
            virtual('from_value', v = 'const value&', default = 'from_value_context'),
+           virtual('parallel_compile', returns = 'bool', const = True, default = 'parallel_compile_context'),
+           virtual('begin_eval', returns = 'void', const = True, default = 'begin_eval_context'),
+           virtual('end_eval', returns = 'void', const = True, default = 'end_eval_context'),
            virtual('finish', returns = 'void', const = True)) %>
 
     inline void migraphx_to_value(value& v, const context& ctx)
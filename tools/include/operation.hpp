@@ -12,6 +12,7 @@
 #include <migraphx/streamutils.hpp>
 #include <migraphx/normalize_attributes.hpp>
 #include <migraphx/argument.hpp>
+#include <migraphx/literal.hpp>
 #include <migraphx/module_ref.hpp>
 #include <migraphx/serialize.hpp>
 #include <migraphx/auto_any_cast.hpp>
@@ -441,6 +442,133 @@ lifetime get_lifetime_op(const T&)
     return lifetime::local;
 }
 
+template <class T>
+auto has_field_op(rank<1>, const T& x, const std::string& field) -> decltype(x.to_value(), bool{})
+{
+    return x.to_value().contains(field);
+}
+
+template <class T>
+bool has_field_op(rank<0>, const T& x, const std::string& field)
+{
+    bool result = false;
+    reflect_each(x, [&](auto&&, const auto& name) { result = result or field == name; });
+    return result;
+}
+
+template <class T>
+bool has_field_op(const T& x, const std::string& field)
+{
+    return has_field_op(rank<1>{}, x, field);
+}
+
+template <class T>
+auto get_field_op(rank<1>, const T& x, const std::string& field) -> decltype(x.to_value(), value{})
+{
+    return x.to_value().at(field).without_key();
+}
+
+// Only the requested field is serialized
+template <class T>
+value get_field_op(rank<0>, const T& x, const std::string& field)
+{
+    value result;
+    bool found = false;
+    reflect_each(x, [&](const auto& y, const auto& name) {
+        if(found or field != name)
+            return;
+        result = migraphx::to_value(y);
+        found  = true;
+    });
+    if(not found)
+        MIGRAPHX_THROW("Unknown field " + field + " for operator " + x.name());
+    return result;
+}
+
+template <class T>
+value get_field_op(const T& x, const std::string& field)
+{
+    return get_field_op(rank<1>{}, x, field);
+}
+
+// A literal field is added to the table, and only its index is kept in the value
+template <class T>
+value field_to_value(const T& x, std::vector<literal>&)
+{
+    return migraphx::to_value(x);
+}
+
+inline value field_to_value(const literal& x, std::vector<literal>& literals)
+{
+    literals.push_back(x);
+    return {{"@literal", literals.size() - 1}};
+}
+
+template <class T>
+void field_from_value(const value& v, T& x, const std::vector<literal>&)
+{
+    x = migraphx::from_value<T>(v);
+}
+
+inline void field_from_value(const value& v, literal& x, const std::vector<literal>& literals)
+{
+    if(not v.contains("@literal") or v.at("@literal").is_object())
+    {
+        x = migraphx::from_value<literal>(v);
+        return;
+    }
+    auto i = v.at("@literal").to<std::size_t>();
+    if(i >= literals.size())
+        MIGRAPHX_THROW("Literal " + std::to_string(i) + " is not in the literal table");
+    x = literals[i];
+}
+
+template <class T>
+auto to_value_op(rank<1>, const T& x, std::vector<literal>&) -> decltype(x.to_value(), value{})
+{
+    return x.to_value();
+}
+
+template <class T>
+value to_value_op(rank<0>, const T& x, std::vector<literal>& literals)
+{
+    value result = value::object{};
+    reflect_each(x, [&](const auto& y, const std::string& name) {
+        result.emplace(name, field_to_value(y, literals));
+    });
+    return result;
+}
+
+template <class T>
+value to_value_op(const T& x, std::vector<literal>& literals)
+{
+    return to_value_op(rank<1>{}, x, literals);
+}
+
+template <class T>
+auto from_value_op(rank<1>, T& x, const value& v, const std::vector<literal>&)
+    -> decltype(x.from_value(v))
+{
+    x.from_value(v);
+}
+
+template <class T>
+void from_value_op(rank<0>, T& x, const value& v, const std::vector<literal>& literals)
+{
+    if(not(v.is_object() or (v.empty() and v.is_array())))
+        MIGRAPHX_THROW("Value is not an object");
+    reflect_each(x, [&](auto& y, const std::string& name) {
+        if(v.contains(name))
+            field_from_value(v.at(name).without_key(), y, literals);
+    });
+}
+
+template <class T>
+void from_value_op(T& x, const value& v, const std::vector<literal>& literals)
+{
+    from_value_op(rank<1>{}, x, v, literals);
+}
+
 } // namespace detail
 
 <%
@@ -519,7 +647,26 @@ lifetime get_lifetime_op(const T&)
          default = 'detail::compute_op'),
      virtual('to_value', returns = 'value', const = True, default = 'detail::to_value_op'),
      virtual('from_value', v = 'const value&', default = 'detail::from_value_op'),
+     virtual('to_value',
+             returns  = 'value',
+             literals = 'std::vector<literal>&',
+             const    = True,
+             default  = 'detail::to_value_op'),
+     virtual('from_value',
+             v        = 'const value&',
+             literals = 'const std::vector<literal>&',
+             default  = 'detail::from_value_op'),
      virtual('attributes', returns = 'value', const = True, default = 'detail::attributes_op'),
+     virtual('has_field',
+             returns = 'bool',
+             field   = 'const std::string&',
+             const   = True,
+             default = 'detail::has_field_op'),
+     virtual('get_field',
+             returns = 'value',
+             field   = 'const std::string&',
+             const   = True,
+             default = 'detail::get_field_op'),
      friend('operator<<',
             returns = 'std::ostream &',
             os      = 'std::ostream &',